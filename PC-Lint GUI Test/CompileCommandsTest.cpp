@@ -0,0 +1,95 @@
+#include "CompileCommandsTest.h"
+#include "../PC-Lint GUI/CompileCommands.h"
+#include <QTemporaryDir>
+#include <QFile>
+#include <QTextStream>
+#include <QDir>
+
+namespace Test
+{
+
+void CompileCommandsTest::splitCommandLineTest() noexcept
+{
+    TEST_COMPARE(Lint::splitCommandLine("  gcc -c  main.c "), QStringList() << "gcc" << "-c" << "main.c");
+    TEST_COMPARE(Lint::splitCommandLine(R"(gcc "-Imy dir" '-DNAME=a b' -DSTR=\"x\" main.c)"),
+                 QStringList() << "gcc" << "-Imy dir" << "-DNAME=a b" << R"(-DSTR="x")" << "main.c");
+    TEST_COMPARE(Lint::splitCommandLine(R"(cl.exe /IC:\src\include "" C:\src\main.c)"),
+                 QStringList() << "cl.exe" << R"(/IC:\src\include)" << "" << R"(C:\src\main.c)");
+}
+
+void CompileCommandsTest::parseCompileArgumentsTest() noexcept
+{
+    auto const gcc = Lint::parseCompileArguments("/build", "../src/main.c",
+        QStringList() << "gcc" << "-Iinclude" << "-I" << "/usr/include/foo" << "-isystem" << "sys" << "-DDEBUG"
+                      << "-D" << "LEVEL=2" << "-UNDEBUG" << "-o" << "/Dir/main.o" << "-c" << "../src/main.c");
+    TEST_COMPARE(gcc.file, QString("/src/main.c"));
+    TEST_COMPARE(gcc.includes, QStringList() << "/build/include" << "/usr/include/foo" << "/build/sys");
+    TEST_COMPARE(gcc.defines, QStringList() << "DEBUG" << "LEVEL=2");
+    TEST_COMPARE(gcc.undefines, QStringList() << "NDEBUG");
+
+    // cl style options are only understood for cl
+    auto const cl = Lint::parseCompileArguments("/build", "main.c", QStringList() << "clang-cl" << "/Iinc" << "/DWIN32" << "main.c");
+    TEST_COMPARE(cl.includes, QStringList() << "/build/inc");
+    TEST_COMPARE(cl.defines, QStringList() << "WIN32");
+}
+
+void CompileCommandsTest::importCompileCommandsTest() noexcept
+{
+    QTemporaryDir directory;
+    TEST_COMPARE(directory.isValid(), true);
+
+    QFile json(directory.filePath("compile_commands.json"));
+    TEST_COMPARE(json.open(QIODevice::WriteOnly | QIODevice::Text), true);
+    QTextStream stream(&json);
+    stream << R"([
+        {"directory": "/build", "command": "gcc -Iinc -DA=1 -c one.c", "file": "one.c", "output": {"ignored": [1, true, null]}},
+        {"directory": "/build", "arguments": ["gcc", "-Iinc", "-DA=1", "-c", "two.c"], "file": "two.c"},
+        {"directory": "/build", "command": "gcc -Iinc -DA=1 -O2 -c one.c", "file": "one.c"},
+        {"directory": "/build", "command": "gcc -DB=\"b \u00e9\" -c three.c", "file": "three.c"}
+    ])";
+    stream.flush();
+    json.close();
+
+    int commands = 0;
+    QString error;
+    TEST_COMPARE(Lint::readCompileCommands(json.fileName(), [&commands](const Lint::CompileCommand&) { commands++; }, error), true);
+    TEST_COMPARE(commands, 4);
+
+    // Duplicate files are dropped and the rest grouped by their options
+    auto const lintFile = directory.filePath("project.lnt");
+    auto const single = Lint::importCompileCommands(json.fileName(), lintFile, 1, "");
+    TEST_COMPARE(single.error, QString());
+    TEST_COMPARE(single.translationUnits, 3);
+    TEST_COMPARE(single.optionSets, 2);
+    TEST_COMPARE(single.lintFiles, QStringList() << lintFile);
+
+    QFile output(lintFile);
+    TEST_COMPARE(output.open(QIODevice::ReadOnly | QIODevice::Text), true);
+    auto const contents = QString::fromUtf8(output.readAll());
+    TEST_COMPARE(contents.count("-env_push"), 2);
+    TEST_COMPARE(contents.contains("-dA=1\n"), true);
+    TEST_COMPARE(contents.contains(QString("-d\"B=b \u00e9\"\n")), true);
+    TEST_COMPARE(contents.contains('"' + QDir::toNativeSeparators("/build/inc") + '"'), true);
+
+    auto const sharded = Lint::importCompileCommands(json.fileName(), lintFile, 4, "base.lnt");
+    TEST_COMPARE(sharded.lintFiles, QStringList() << directory.filePath("project_1.lnt") << directory.filePath("project_2.lnt"));
+
+    // Going back to one lint file removes the old shards but nothing written by hand
+    QFile handWritten(directory.filePath("project_9.lnt"));
+    TEST_COMPARE(handWritten.open(QIODevice::WriteOnly | QIODevice::Text), true);
+    handWritten.write("-w2\n");
+    handWritten.close();
+    TEST_COMPARE(Lint::importCompileCommands(json.fileName(), lintFile, 1, "").error, QString());
+    TEST_COMPARE(QFile::exists(directory.filePath("project_1.lnt")), false);
+    TEST_COMPARE(QFile::exists(directory.filePath("project_2.lnt")), false);
+    TEST_COMPARE(QFile::exists(handWritten.fileName()), true);
+
+    // Broken databases report where they went wrong
+    TEST_COMPARE(json.open(QIODevice::WriteOnly | QIODevice::Truncate), true);
+    json.write(R"([{"file": "one.c", "directory": ])");
+    json.close();
+    TEST_COMPARE(Lint::readCompileCommands(json.fileName(), [](const Lint::CompileCommand&) {}, error), false);
+    TEST_COMPARE(error.isEmpty(), false);
+}
+
+};
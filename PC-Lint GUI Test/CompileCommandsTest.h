@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Tester.h"
+#include <map>
+#include <QString>
+
+namespace Test
+{
+
+class CompileCommandsTest : public TestFunction
+{
+public:
+    CompileCommandsTest() = default;
+
+    using CompileCommandsFunctionMap = const std::map<QString, void (CompileCommandsTest::*)(void)>;
+
+    CompileCommandsFunctionMap m_tests =
+    {
+        {"splitCommandLineTest", &CompileCommandsTest::splitCommandLineTest},
+        {"parseCompileArgumentsTest", &CompileCommandsTest::parseCompileArgumentsTest},
+        {"importCompileCommandsTest", &CompileCommandsTest::importCompileCommandsTest}
+    };
+
+private:
+
+    void splitCommandLineTest() noexcept;
+    void parseCompileArgumentsTest() noexcept;
+    void importCompileCommandsTest() noexcept;
+};
+
+};
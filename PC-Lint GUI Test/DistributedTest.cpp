@@ -0,0 +1,306 @@
+#include "DistributedTest.h"
+#include "../PC-Lint GUI/Distributed.h"
+#include "../PC-Lint GUI/PCLintPlus.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QTcpServer>
+#include <QTimer>
+#include <cstdio>
+
+namespace Test
+{
+
+namespace
+{
+    const QString TOKEN = "secret";
+    // Long enough for the worker to start this executable as lint a few times
+    constexpr int RUN_TIMEOUT_MS = 30000;
+
+    Lint::ShardJob shardJob(qint32 id, const QStringList& modules) noexcept
+    {
+        return {id, QDir::tempPath(), modules.join('\n').toUtf8() + '\n', modules, 1};
+    }
+
+    // Fake lint crashes when it gets to this module
+    const QByteArray CRASH_MODULE = "crash.c";
+
+    // Run the jobs on the workers and return everything they sent back
+    QByteArray runShards(const QStringList& workers, const QString& token, std::vector<Lint::ShardJob> jobs, QString& error, QList<qint32>* failedShards = nullptr) noexcept
+    {
+        Lint::DistributedLint lint;
+        QByteArray output;
+        QEventLoop loop;
+        bool finished = false;
+        QObject::connect(&lint, &Lint::DistributedLint::signalOutput, [&output](const QByteArray& modules)
+        {
+            output.append(modules);
+        });
+        QObject::connect(&lint, &Lint::DistributedLint::signalShardFailed, [failedShards](qint32 id)
+        {
+            if (failedShards)
+            {
+                failedShards->append(id);
+            }
+        });
+        QObject::connect(&lint, &Lint::DistributedLint::signalFinished, [&](const QString& errorMessage)
+        {
+            finished = true;
+            error = errorMessage;
+            loop.quit();
+        });
+        QTimer::singleShot(RUN_TIMEOUT_MS, &loop, &QEventLoop::quit);
+
+        lint.start(workers, token, std::move(jobs));
+        if (!finished)
+        {
+            loop.exec();
+        }
+        if (!finished)
+        {
+            error = "Timed out";
+        }
+        return output;
+    }
+};
+
+bool DistributedTest::isFakeLint(int argc, char* argv[]) noexcept
+{
+    // Workers always put -max_threads first
+    return (argc > 1) && QByteArray(argv[1]).startsWith("-max_threads=");
+}
+
+int DistributedTest::fakeLint(const QStringList& arguments) noexcept
+{
+    // One module with one message for every file in the lint file
+    QFile lintFile(arguments.last());
+    if (!lintFile.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return 2;
+    }
+
+    QFile standardOutput;
+    standardOutput.open(stdout, QIODevice::WriteOnly);
+    standardOutput.write("PC-lint Plus (fake)\n<doc>\n");
+    for (auto const& line : lintFile.readAll().split('\n'))
+    {
+        auto const module = line.trimmed();
+        if (!module.isEmpty())
+        {
+            standardOutput.write(Lint::DATA_MODULE_STRING + module + Lint::DATA_C_STRING + "\n");
+            if (module == CRASH_MODULE)
+            {
+                // Output stops part way through the module like a real crash
+                standardOutput.flush();
+                *static_cast<volatile int*>(nullptr) = 0;
+            }
+            standardOutput.write("<m><f>" + module + "</f><l>1</l><t>info</t><n>1</n><d>linted</d></m>\n");
+        }
+    }
+    standardOutput.write("</doc>\n");
+    return 0;
+}
+
+void DistributedTest::crashTest() noexcept
+{
+    Lint::LintWorker worker(QCoreApplication::applicationFilePath(), TOKEN);
+    QString error;
+    TEST_COMPARE(worker.listen(QHostAddress::LocalHost, 0, error), true);
+
+    // Lint crashes on the middle shard every time it's tried
+    std::vector<Lint::ShardJob> jobs = {shardJob(0, {"a.c"}), shardJob(1, {"b.c", CRASH_MODULE}), shardJob(2, {"c.c"})};
+    QList<qint32> failed;
+    QByteArray const output = runShards({"127.0.0.1:" + QString::number(worker.port())}, TOKEN, jobs, error, &failed);
+
+    // The only worker kept going after the crashes and the shard was given up on once
+    TEST_COMPARE(error, QString());
+    TEST_COMPARE(failed, QList<qint32>({1}));
+    TEST_COMPARE(output.count("--- Module:   a.c (C)"), 1);
+    TEST_COMPARE(output.count("--- Module:   c.c (C)"), 1);
+    TEST_COMPARE(output.count("--- Module:   b.c (C)"), Lint::WORKER_SHARD_ATTEMPTS);
+    TEST_COMPARE(output.contains(CRASH_MODULE), false);
+}
+
+void DistributedTest::frameReaderTest() noexcept
+{
+    QByteArray const stream = Lint::encodeFrame(Lint::FRAME_HELLO, Lint::encodeHello("secret")) +
+                              Lint::encodeFrame(Lint::FRAME_OUTPUT, "<m>") +
+                              Lint::encodeFrame(Lint::FRAME_PROGRESS, QByteArray());
+
+    // Frames come out whole however the stream is split up
+    Lint::FrameReader reader;
+    Lint::Frame frame;
+    reader.append(stream.left(3));
+    TEST_COMPARE(reader.next(frame), false);
+    reader.append(stream.mid(3, stream.size() - 4));
+    TEST_COMPARE(reader.next(frame), true);
+    TEST_COMPARE(frame.type, Lint::FRAME_HELLO);
+    QString token;
+    TEST_COMPARE(Lint::decodeHello(frame.payload, token), true);
+    TEST_COMPARE(token, QString("secret"));
+    TEST_COMPARE(reader.next(frame), true);
+    TEST_COMPARE(frame.type, Lint::FRAME_OUTPUT);
+    TEST_COMPARE(frame.payload, QByteArray("<m>"));
+    TEST_COMPARE(reader.next(frame), false);
+    reader.append(stream.right(1));
+    TEST_COMPARE(reader.next(frame), true);
+    TEST_COMPARE(frame.type, Lint::FRAME_PROGRESS);
+    TEST_COMPARE(frame.payload.isEmpty(), true);
+    TEST_COMPARE(reader.hasError(), false);
+
+    // Something that isn't a worker
+    Lint::FrameReader broken;
+    broken.append("GET / HTTP/1.1\r\n");
+    TEST_COMPARE(broken.next(frame), false);
+    TEST_COMPARE(broken.hasError(), true);
+    TEST_COMPARE(Lint::decodeHello("PCLW", token), false);
+}
+
+void DistributedTest::jobTest() noexcept
+{
+    const Lint::ShardJob job{7, "/home/lint/project", "-i\"include\"\nsrc/a.c\n", {"/home/lint/project/src/a.c"}, 4};
+
+    Lint::ShardJob read;
+    TEST_COMPARE(Lint::decodeJob(Lint::encodeJob(job), read), true);
+    TEST_COMPARE(read.id, 7);
+    TEST_COMPARE(read.workingDirectory, job.workingDirectory);
+    TEST_COMPARE(read.lintFile, job.lintFile);
+    TEST_COMPARE(read.files, job.files);
+    TEST_COMPARE(read.threads, 4);
+    TEST_COMPARE(Lint::decodeJob(Lint::encodeJob(job).left(10), read), false);
+
+    Lint::ShardResult result;
+    TEST_COMPARE(Lint::decodeResult(Lint::encodeResult({7, 0, {}}), result), true);
+    TEST_COMPARE(result.id, 7);
+    TEST_COMPARE(result.exitCode, 0);
+    TEST_COMPARE(result.error.isEmpty(), true);
+}
+
+void DistributedTest::loopbackTest() noexcept
+{
+    // This executable is the lint, see fakeLint
+    Lint::LintWorker worker(QCoreApplication::applicationFilePath(), TOKEN);
+    QString error;
+    TEST_COMPARE(worker.listen(QHostAddress::LocalHost, 0, error), true);
+    QString const address = "127.0.0.1:" + QString::number(worker.port());
+
+    // Every shard comes back as whole modules, each once
+    std::vector<Lint::ShardJob> jobs = {shardJob(0, {"a.c", "b.c"}), shardJob(1, {"c.c"})};
+    QByteArray const output = runShards({address}, TOKEN, jobs, error);
+    TEST_COMPARE(error, QString());
+    TEST_COMPARE(output.count("--- Module:   a.c (C)"), 1);
+    TEST_COMPARE(output.count("--- Module:   b.c (C)"), 1);
+    TEST_COMPARE(output.count("--- Module:   c.c (C)"), 1);
+    TEST_COMPARE(output.count("<d>linted</d>"), 3);
+    TEST_COMPARE(output.contains("</doc>"), false);
+
+    // Without the token the worker doesn't take anything
+    QByteArray const refused = runShards({address}, "guess", jobs, error);
+    TEST_COMPARE(error.isEmpty(), false);
+    TEST_COMPARE(refused.isEmpty(), true);
+}
+
+void DistributedTest::requeueTest() noexcept
+{
+    Lint::LintWorker worker(QCoreApplication::applicationFilePath(), TOKEN);
+    QString error;
+    TEST_COMPARE(worker.listen(QHostAddress::LocalHost, 0, error), true);
+
+    // A worker that goes away half way through the first shard it is given
+    QTcpServer dropping;
+    TEST_COMPARE(dropping.listen(QHostAddress::LocalHost, 0), true);
+    Lint::FrameReader reader;
+    int dropped = -1;
+    QObject::connect(&dropping, &QTcpServer::newConnection, [&]()
+    {
+        QTcpSocket* const socket = dropping.nextPendingConnection();
+        QObject::connect(socket, &QTcpSocket::readyRead, [&, socket]()
+        {
+            reader.append(socket->readAll());
+            Lint::Frame frame;
+            while (reader.next(frame))
+            {
+                if (frame.type == Lint::FRAME_HELLO)
+                {
+                    socket->write(Lint::encodeFrame(Lint::FRAME_HELLO, Lint::encodeHello({})));
+                }
+                else if (frame.type == Lint::FRAME_JOB)
+                {
+                    Lint::ShardJob job;
+                    Lint::decodeJob(frame.payload, job);
+                    dropped = job.id;
+                    socket->write(Lint::encodeFrame(Lint::FRAME_OUTPUT, "<doc>\n--- Module:   " + job.files.first().toUtf8() + " (C)\n<m><f>partial"));
+                    socket->flush();
+                    socket->abort();
+                    return;
+                }
+            }
+        });
+    });
+
+    std::vector<Lint::ShardJob> jobs = {shardJob(0, {"a.c"}), shardJob(1, {"b.c"})};
+    QStringList const workers = {"127.0.0.1:" + QString::number(dropping.serverPort()), "127.0.0.1:" + QString::number(worker.port())};
+    QByteArray const output = runShards(workers, TOKEN, jobs, error);
+
+    // The dropped shard was linted again by the other worker and nothing of the partial module got through
+    TEST_COMPARE(dropped >= 0, true);
+    TEST_COMPARE(error, QString());
+    TEST_COMPARE(output.count("--- Module:   a.c (C)"), 1);
+    TEST_COMPARE(output.count("--- Module:   b.c (C)"), 1);
+    TEST_COMPARE(output.contains("partial"), false);
+}
+
+void DistributedTest::splitShardsTest() noexcept
+{
+    const QStringList modules = {"a.c", "b.c", "c.c", "d.c", "e.c"};
+
+    // Neighbours stay together and the first shards take the extra modules
+    auto const shards = Lint::splitShards(modules, 3);
+    TEST_COMPARE(shards.size(), size_t(3));
+    TEST_COMPARE(shards[0], QStringList({"a.c", "b.c"}));
+    TEST_COMPARE(shards[1], QStringList({"c.c", "d.c"}));
+    TEST_COMPARE(shards[2], QStringList({"e.c"}));
+
+    // No empty shards
+    TEST_COMPARE(Lint::splitShards(modules, 8).size(), size_t(5));
+    TEST_COMPARE(Lint::splitShards(modules, 0).size(), size_t(1));
+}
+
+void DistributedTest::takeModulesTest() noexcept
+{
+    QByteArray buffer = "PC-lint Plus 1.4\n<doc>\n--- Module:   a.c (C)\n<m>A</m>\n--- Module:   b.c (C)\n<m>B";
+
+    // b.c isn't complete until the next module starts or the shard is done
+    TEST_COMPARE(Lint::takeModules(buffer, false), QByteArray("--- Module:   a.c (C)\n<m>A</m>\n"));
+    TEST_COMPARE(buffer, QByteArray("--- Module:   b.c (C)\n<m>B"));
+    TEST_COMPARE(Lint::takeModules(buffer, false).isEmpty(), true);
+
+    buffer.append("</m>\n</doc>\n");
+    TEST_COMPARE(Lint::takeModules(buffer, true), QByteArray("--- Module:   b.c (C)\n<m>B</m>\n"));
+    TEST_COMPARE(buffer.isEmpty(), true);
+}
+
+void DistributedTest::wholeProgramTest() noexcept
+{
+    const QByteArray data =
+        "<doc>\n"
+        " <m><f>file1</f><l>1</l><t>warning</t><n>1</n><d>local message</d></m>\n"
+        " <m><f>file1</f><l>2</l><t>info</t><n>766</n><d>header not used</d></m>\n"
+        " <m><f>file1</f><l>3</l><t>supplemental</t><n>766</n><d>header not used</d></m>\n"
+        " <m><f>file1</f><l>4</l><t>info</t><n>714</n><d>symbol not referenced</d></m>\n"
+        "</doc>\n";
+
+    // Kept when lint sees every module
+    Lint::PCLintPlus local;
+    TEST_COMPARE(local.parseLintMessages(data).size(), size_t(4));
+
+    // Dropped along with their supplementals when linting on workers
+    Lint::PCLintPlus distributed;
+    distributed.setWorkers({"localhost:1"}, TOKEN);
+    auto const messages = distributed.parseLintMessages(data);
+    TEST_COMPARE(messages.size(), size_t(1));
+    TEST_COMPARE(messages.front().number, 1);
+}
+
+};
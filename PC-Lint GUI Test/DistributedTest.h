@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Tester.h"
+#include <map>
+#include <QString>
+#include <QStringList>
+
+namespace Test
+{
+
+class DistributedTest : public TestFunction
+{
+public:
+    DistributedTest() = default;
+
+    // Stands in for lint when the test runs itself as a worker's lint executable
+    static bool isFakeLint(int argc, char* argv[]) noexcept;
+    static int fakeLint(const QStringList& arguments) noexcept;
+
+    using DistributedFunctionMap = const std::map<QString, void (DistributedTest::*)(void)>;
+
+    DistributedFunctionMap m_tests =
+    {
+        {"crashTest", &DistributedTest::crashTest},
+        {"frameReaderTest", &DistributedTest::frameReaderTest},
+        {"jobTest", &DistributedTest::jobTest},
+        {"loopbackTest", &DistributedTest::loopbackTest},
+        {"requeueTest", &DistributedTest::requeueTest},
+        {"splitShardsTest", &DistributedTest::splitShardsTest},
+        {"takeModulesTest", &DistributedTest::takeModulesTest},
+        {"wholeProgramTest", &DistributedTest::wholeProgramTest}
+    };
+
+private:
+
+    void crashTest() noexcept;
+    void frameReaderTest() noexcept;
+    void jobTest() noexcept;
+    void loopbackTest() noexcept;
+    void requeueTest() noexcept;
+    void splitShardsTest() noexcept;
+    void takeModulesTest() noexcept;
+    void wholeProgramTest() noexcept;
+};
+
+};
@@ -0,0 +1,112 @@
+#include "ExportTest.h"
+#include "../PC-Lint GUI/Export.h"
+#include <QBuffer>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
+
+namespace Test
+{
+
+namespace
+{
+    const Lint::LintMessages MESSAGES =
+    {
+        {R"(C:\project\a.c)", 10, Lint::Type::TYPE_WARNING, 534, "Ignoring return value of function 'f'"},
+        {R"(C:\project\a.h)", 3, Lint::Type::TYPE_SUPPLEMENTAL, 891, "declared here"},
+        {R"(C:\project\b.c)", 0, Lint::Type::TYPE_ERROR, 10, "Expecting \"a, b\"\nsecond line"},
+        {"", 0, Lint::Type::TYPE_INFORMATION, 766, "Header file not used"},
+    };
+
+    QByteArray exportAll(Lint::ExportFormat format, qint64& results) noexcept
+    {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        Lint::ResultExporter exporter(buffer, format);
+        for (auto const& message : MESSAGES)
+        {
+            exporter.write(message);
+        }
+        exporter.finish();
+        results = exporter.resultCount();
+        return buffer.data();
+    }
+};
+
+void ExportTest::exportCsvTest() noexcept
+{
+    Lint::ExportFormat format;
+    TEST_COMPARE(Lint::exportFormatForFile("results.CSV", format), true);
+    TEST_COMPARE(format, Lint::EXPORT_CSV);
+    TEST_COMPARE(Lint::exportFormatForFile("results.txt", format), false);
+
+    qint64 results;
+    auto const lines = exportAll(Lint::EXPORT_CSV, results).split('\n');
+    TEST_COMPARE(results, 3);
+    TEST_COMPARE(lines[0], QByteArray("File,Line,Type,Number,Description\r"));
+    TEST_COMPARE(lines[1], QByteArray(R"(C:\project\a.c,10,warning,534,Ignoring return value of function 'f')" "\r"));
+    TEST_COMPARE(lines[2], QByteArray(R"(C:\project\a.h,3,supplemental,891,declared here)" "\r"));
+    // Quotes are doubled and the field keeps its line break
+    TEST_COMPARE(lines[3], QByteArray(R"(C:\project\b.c,0,error,10,"Expecting ""a, b"")"));
+    TEST_COMPARE(lines[4], QByteArray("second line\"\r"));
+}
+
+void ExportTest::exportJsonLinesTest() noexcept
+{
+    Lint::ExportFormat format;
+    TEST_COMPARE(Lint::exportFormatForFile("results.jsonl", format), true);
+    TEST_COMPARE(format, Lint::EXPORT_JSON_LINES);
+
+    qint64 results;
+    auto lines = exportAll(Lint::EXPORT_JSON_LINES, results).split('\n');
+    TEST_COMPARE(results, 3);
+    TEST_COMPARE(lines.size(), 4);
+    TEST_COMPARE(lines[3].isEmpty(), true);
+
+    auto const first = QJsonDocument::fromJson(lines[0]).object();
+    TEST_COMPARE(first["file"].toString(), QString(R"(C:\project\a.c)"));
+    TEST_COMPARE(first["line"].toInt(), 10);
+    TEST_COMPARE(first["type"].toString(), QString(Lint::Type::TYPE_WARNING));
+    TEST_COMPARE(first["number"].toInt(), 534);
+    auto const supplemental = first["supplemental"].toArray();
+    TEST_COMPARE(supplemental.size(), 1);
+    TEST_COMPARE(supplemental[0].toObject()["number"].toInt(), 891);
+
+    auto const second = QJsonDocument::fromJson(lines[1]).object();
+    TEST_COMPARE(second["description"].toString(), QString("Expecting \"a, b\"\nsecond line"));
+    TEST_COMPARE(second.contains("supplemental"), false);
+}
+
+void ExportTest::exportSarifTest() noexcept
+{
+    Lint::ExportFormat format;
+    TEST_COMPARE(Lint::exportFormatForFile("results.sarif", format), true);
+    TEST_COMPARE(format, Lint::EXPORT_SARIF);
+
+    qint64 results;
+    QJsonParseError error;
+    auto const sarif = QJsonDocument::fromJson(exportAll(Lint::EXPORT_SARIF, results), &error).object();
+    TEST_COMPARE(error.error, QJsonParseError::NoError);
+    TEST_COMPARE(sarif["version"].toString(), QString("2.1.0"));
+
+    auto const run = sarif["runs"].toArray()[0].toObject();
+    TEST_COMPARE(run["tool"].toObject()["driver"].toObject()["name"].toString(), QString("PC-Lint Plus"));
+
+    auto const sarifResults = run["results"].toArray();
+    TEST_COMPARE(sarifResults.size(), 3);
+
+    auto const warning = sarifResults[0].toObject();
+    TEST_COMPARE(warning["ruleId"].toString(), QString("534"));
+    TEST_COMPARE(warning["level"].toString(), QString("warning"));
+    auto const location = warning["locations"].toArray()[0].toObject()["physicalLocation"].toObject();
+    TEST_COMPARE(location["region"].toObject()["startLine"].toInt(), 10);
+    TEST_COMPARE(warning["relatedLocations"].toArray().size(), 1);
+
+    // No line means no region, information is only a note
+    auto const error10 = sarifResults[1].toObject();
+    TEST_COMPARE(error10["level"].toString(), QString("error"));
+    TEST_COMPARE(error10["locations"].toArray()[0].toObject()["physicalLocation"].toObject().contains("region"), false);
+    TEST_COMPARE(sarifResults[2].toObject()["level"].toString(), QString("note"));
+}
+
+};
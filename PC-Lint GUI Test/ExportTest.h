@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Tester.h"
+#include <map>
+#include <QString>
+
+namespace Test
+{
+
+class ExportTest : public TestFunction
+{
+public:
+    ExportTest() = default;
+
+    using ExportFunctionMap = const std::map<QString, void (ExportTest::*)(void)>;
+
+    ExportFunctionMap m_tests =
+    {
+        {"exportCsvTest", &ExportTest::exportCsvTest},
+        {"exportJsonLinesTest", &ExportTest::exportJsonLinesTest},
+        {"exportSarifTest", &ExportTest::exportSarifTest}
+    };
+
+private:
+
+    void exportCsvTest() noexcept;
+    void exportJsonLinesTest() noexcept;
+    void exportSarifTest() noexcept;
+};
+
+};
@@ -0,0 +1,75 @@
+#include "IncludeGraphTest.h"
+#include "../PC-Lint GUI/IncludeGraph.h"
+#include <QTemporaryDir>
+#include <QFileInfo>
+
+namespace Test
+{
+
+void IncludeGraphTest::scanIncludesTest() noexcept
+{
+    auto const directives = Lint::scanIncludes(QStringLiteral(
+        "#include <stdio.h>\n"
+        "  #  include \"a.h\" // comment\n"
+        "/* #include \"comment.h\" */ #include_next <b.h>\n"
+        "// #include \"line.h\"\n"
+        "char* s = \"#include \\\"string.h\\\"\";\n"
+        "char* r = R\"x(\n"
+        "#include \"raw.h\"\n"
+        ")x\";\n"
+        "#define X \\\n"
+        "  #include \"continued.h\"\n"
+        "#if 0\n"
+        "#import \"c.h\"\n"
+        "#endif\n"
+        "#include CONFIG_HEADER\n"));
+
+    TEST_COMPARE(directives.size(), size_t(4));
+    TEST_COMPARE(directives[0].name, QString("stdio.h"));
+    TEST_COMPARE(directives[0].angled, true);
+    TEST_COMPARE(directives[1].name, QString("a.h"));
+    TEST_COMPARE(directives[1].angled, false);
+    TEST_COMPARE(directives[1].line, 2);
+    TEST_COMPARE(directives[2].name, QString("b.h"));
+    TEST_COMPARE(directives[2].line, 3);
+    // Conditionals aren't evaluated
+    TEST_COMPARE(directives[3].name, QString("c.h"));
+    TEST_COMPARE(directives[3].line, 12);
+}
+
+void IncludeGraphTest::dependentsTest() noexcept
+{
+    auto const lintFile = QFileInfo(R"(..\PC-Lint GUI Test\data\include-graph\project.lnt)").absoluteFilePath();
+    auto const directory = QFileInfo(lintFile).absolutePath();
+    auto const path = [&directory](const QString& file)
+    {
+        return QFileInfo(directory + '/' + file).canonicalFilePath();
+    };
+
+    Lint::IncludeGraph graph;
+    graph.build(Lint::parseLintFile(lintFile), directory);
+
+    // stdio.h isn't found and b.c can't see alt/
+    TEST_COMPARE(graph.files().size(), 6);
+    TEST_COMPARE(graph.includes(path("src/a.c")), QStringList() << path("alt/alt_only.h") << path("include/common.h") << path("include/config.h"));
+    TEST_COMPARE(graph.includes(path("src/b.c")), QStringList() << path("include/common.h"));
+
+    TEST_COMPARE(graph.dependents({path("include/detail.h")}).size(), 2);
+    TEST_COMPARE(graph.dependents({path("include/config.h")}), QStringList() << path("src/a.c"));
+    TEST_COMPARE(graph.dependents({path("alt/alt_only.h")}), QStringList() << path("src/a.c"));
+    TEST_COMPARE(graph.dependents({path("src/b.c")}), QStringList() << path("src/b.c"));
+    TEST_COMPARE(graph.dependents({path("project.lnt")}).isEmpty(), true);
+
+    // Unchanged files are rescanned from the cache with the same result
+    QTemporaryDir cacheDirectory;
+    auto const cacheFile = cacheDirectory.filePath("graph.cache");
+    TEST_COMPARE(graph.save(cacheFile), true);
+
+    Lint::IncludeGraph cached;
+    TEST_COMPARE(cached.load(cacheFile), true);
+    cached.build(Lint::parseLintFile(lintFile), directory);
+    TEST_COMPARE(cached.files().size(), 6);
+    TEST_COMPARE(cached.update({path("include/common.h")}).size(), 2);
+}
+
+};
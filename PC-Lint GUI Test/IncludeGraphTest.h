@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Tester.h"
+#include <map>
+#include <QString>
+
+namespace Test
+{
+
+class IncludeGraphTest : public TestFunction
+{
+public:
+    IncludeGraphTest() = default;
+
+    using IncludeGraphFunctionMap = const std::map<QString, void (IncludeGraphTest::*)(void)>;
+
+    IncludeGraphFunctionMap m_tests =
+    {
+        {"scanIncludesTest", &IncludeGraphTest::scanIncludesTest},
+        {"dependentsTest", &IncludeGraphTest::dependentsTest}
+    };
+
+private:
+
+    void scanIncludesTest() noexcept;
+    void dependentsTest() noexcept;
+};
+
+};
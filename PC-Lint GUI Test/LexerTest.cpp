@@ -0,0 +1,76 @@
+#include "LexerTest.h"
+#include "../PC-Lint GUI/Lexer.h"
+
+namespace Test
+{
+
+void LexerTest::keywordTest() noexcept
+{
+    TEST_COMPARE(Lint::isKeyword(QStringLiteral("while"), Lint::DIALECT_C), true);
+    TEST_COMPARE(Lint::isKeyword(QStringLiteral("while"), Lint::DIALECT_CPP), true);
+    TEST_COMPARE(Lint::isKeyword(QStringLiteral("reinterpret_cast"), Lint::DIALECT_CPP), true);
+    TEST_COMPARE(Lint::isKeyword(QStringLiteral("_Bool"), Lint::DIALECT_C), true);
+
+    // Keywords of only one dialect
+    TEST_COMPARE(Lint::isKeyword(QStringLiteral("class"), Lint::DIALECT_C), false);
+    TEST_COMPARE(Lint::isKeyword(QStringLiteral("restrict"), Lint::DIALECT_CPP), false);
+
+    // Words that share a slot with a keyword or are close to one
+    TEST_COMPARE(Lint::isKeyword(QStringLiteral("whilst"), Lint::DIALECT_CPP), false);
+    TEST_COMPARE(Lint::isKeyword(QStringLiteral("in"), Lint::DIALECT_CPP), false);
+    TEST_COMPARE(Lint::isKeyword(QStringLiteral("reinterpret_casts"), Lint::DIALECT_CPP), false);
+}
+
+void LexerTest::lexLineTest() noexcept
+{
+    std::vector<Lint::Token> tokens;
+
+    auto const state = Lint::lexLine(QStringLiteral("#include <vector> // x"), Lint::LEXER_STATE_NORMAL, Lint::DIALECT_CPP, tokens);
+    TEST_COMPARE(state, Lint::LEXER_STATE_NORMAL);
+    TEST_COMPARE(tokens.size(), size_t(3));
+    TEST_COMPARE(tokens[0].type, Lint::TOKEN_PREPROCESSOR);
+    TEST_COMPARE(tokens[0].length, 8);
+    TEST_COMPARE(tokens[1].type, Lint::TOKEN_STRING);
+    TEST_COMPARE(tokens[1].start, 9);
+    TEST_COMPARE(tokens[2].type, Lint::TOKEN_COMMENT);
+
+    // return f(1.5e+10f, 'a', u8"s");
+    tokens.clear();
+    Lint::lexLine(QStringLiteral("return f(1.5e+10f, 'a', u8\"s\");"), Lint::LEXER_STATE_NORMAL, Lint::DIALECT_CPP, tokens);
+    TEST_COMPARE(tokens.size(), size_t(9));
+    TEST_COMPARE(tokens[0].type, Lint::TOKEN_KEYWORD);
+    TEST_COMPARE(tokens[1].type, Lint::TOKEN_FUNCTION);
+    TEST_COMPARE(tokens[2].type, Lint::TOKEN_OPERATOR);
+    TEST_COMPARE(tokens[3].type, Lint::TOKEN_NUMBER);
+    TEST_COMPARE(tokens[3].length, 8);
+    TEST_COMPARE(tokens[5].type, Lint::TOKEN_CHARACTER);
+    TEST_COMPARE(tokens[7].type, Lint::TOKEN_STRING);
+    TEST_COMPARE(tokens[7].length, 5);
+}
+
+void LexerTest::multiLineTest() noexcept
+{
+    std::vector<Lint::Token> tokens;
+
+    // Block comments carry on to the next line
+    auto state = Lint::lexLine(QStringLiteral("int x; /* start"), Lint::LEXER_STATE_NORMAL, Lint::DIALECT_C, tokens);
+    TEST_COMPARE(state, Lint::LEXER_STATE_COMMENT);
+    tokens.clear();
+    state = Lint::lexLine(QStringLiteral("end */ int y;"), state, Lint::DIALECT_C, tokens);
+    TEST_COMPARE(state, Lint::LEXER_STATE_NORMAL);
+    TEST_COMPARE(tokens[0].type, Lint::TOKEN_COMMENT);
+    TEST_COMPARE(tokens[0].length, 6);
+    TEST_COMPARE(tokens[1].type, Lint::TOKEN_KEYWORD);
+
+    // Raw strings only end at their own delimiter
+    tokens.clear();
+    state = Lint::lexLine(QStringLiteral("auto s = R\"xy(text"), Lint::LEXER_STATE_NORMAL, Lint::DIALECT_CPP, tokens);
+    TEST_COMPARE(state & Lint::LEXER_STATE_MASK, Lint::LEXER_STATE_RAW_STRING);
+    tokens.clear();
+    state = Lint::lexLine(QStringLiteral(")\" )x\" )xy\";"), state, Lint::DIALECT_CPP, tokens);
+    TEST_COMPARE(state, Lint::LEXER_STATE_NORMAL);
+    TEST_COMPARE(tokens[0].type, Lint::TOKEN_STRING);
+    TEST_COMPARE(tokens[0].length, 11);
+}
+
+};
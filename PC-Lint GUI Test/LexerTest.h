@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Tester.h"
+#include <map>
+#include <QString>
+
+namespace Test
+{
+
+class LexerTest : public TestFunction
+{
+public:
+    LexerTest() = default;
+
+    using LexerFunctionMap = const std::map<QString, void (LexerTest::*)(void)>;
+
+    LexerFunctionMap m_tests =
+    {
+        {"keywordTest", &LexerTest::keywordTest},
+        {"lexLineTest", &LexerTest::lexLineTest},
+        {"multiLineTest", &LexerTest::multiLineTest}
+    };
+
+private:
+
+    void keywordTest() noexcept;
+    void lexLineTest() noexcept;
+    void multiLineTest() noexcept;
+};
+
+};
@@ -0,0 +1,107 @@
+#include "LintFileTest.h"
+#include "../PC-Lint GUI/LintFile.h"
+#include "../PC-Lint GUI/SourceDiscovery.h"
+#include <QFileInfo>
+
+namespace Test
+{
+
+void LintFileTest::tokenizeLintFileTest() noexcept
+{
+    auto const tokens = Lint::tokenizeLintFile(QStringLiteral(
+        "-e534 -i\"C:\\Program Files (x86)\\include\" // comment \"x.c\"\n"
+        "/* a.c\n"
+        "   b.c */ c.c/* d.c */e.c\n"
+        "-esym(534, a b)\t\"f g.c\"\n"
+        "\"unterminated h.c\n"
+        "i.c"));
+
+    TEST_COMPARE(tokens.size(), size_t(8));
+    TEST_COMPARE(tokens[0].text, QString("-e534"));
+    TEST_COMPARE(tokens[1].text, QString(R"(-i"C:\Program Files (x86)\include")"));
+    TEST_COMPARE(tokens[1].line, 1);
+    TEST_COMPARE(tokens[2].text, QString("c.c"));
+    TEST_COMPARE(tokens[2].line, 3);
+    TEST_COMPARE(tokens[3].text, QString("e.c"));
+    TEST_COMPARE(tokens[4].text, QString("-esym(534, a b)"));
+    TEST_COMPARE(tokens[5].text, QString("\"f g.c\""));
+    TEST_COMPARE(tokens[6].text, QString("\"unterminated h.c"));
+    TEST_COMPARE(tokens[7].text, QString("i.c"));
+    TEST_COMPARE(tokens[7].line, 6);
+}
+
+void LintFileTest::parseNestedLintFileTest() noexcept
+{
+    auto const parsed = Lint::parseLintFile(R"(..\PC-Lint GUI Test\data\lint-file\project.lnt)");
+
+    // The nested lint files, one found through -i and one through -indirect
+    TEST_COMPARE(parsed.lintFiles.size(), 3);
+    TEST_COMPARE(parsed.modules.size(), 3);
+    TEST_COMPARE(QFileInfo(parsed.modules.value(0)).fileName(), QString("one.c"));
+    TEST_COMPARE(QFileInfo(parsed.modules.value(1)).fileName(), QString("two file.c"));
+    TEST_COMPARE(QFileInfo(parsed.modules.value(2)).fileName(), QString("three.c"));
+
+    // project.lnt including itself and missing.c
+    TEST_COMPARE(parsed.errors.size(), 2);
+
+    // Options in lint order with the nested ones inlined
+    QStringList options;
+    for (auto const& option : parsed.options)
+    {
+        if (option.kind == Lint::LINT_TOKEN_OPTION)
+        {
+            options << option.text;
+        }
+        else if (option.path.endsWith("one.c"))
+        {
+            TEST_COMPARE(option.envDepth, 1);
+        }
+    }
+    TEST_COMPARE(options, QStringList() << "-esym(534, a b)" << "-e715" << "-i\"options\"" << "-e537" << "-env_push" << "-env_pop");
+
+    // Parsing again comes from the cache and gives the same result
+    TEST_COMPARE(Lint::parseLintFile(R"(..\PC-Lint GUI Test\data\lint-file\project.lnt)").modules, parsed.modules);
+}
+
+void LintFileTest::discoverSourcesTest() noexcept
+{
+    auto const source = QFileInfo(R"(..\PC-Lint GUI Test\data\lint-file\src)").absoluteFilePath();
+    auto const fileNames = [](const QStringList& files)
+    {
+        QStringList names;
+        for (auto const& file : files)
+        {
+            names << QFileInfo(file).fileName();
+        }
+        return names;
+    };
+
+    const Lint::SourceDiscoveryOptions flat{false, Lint::SOURCE_DEFAULT_EXTENSIONS};
+    const Lint::SourceDiscoveryOptions recursive{true, Lint::SOURCE_DEFAULT_EXTENSIONS};
+
+    TEST_COMPARE(Lint::isModulePattern("src/*.c"), true);
+    TEST_COMPARE(Lint::isModulePattern("src/one.c"), false);
+
+    // Wildcards stay in their directory unless -subdir is on or there's a ** in them
+    TEST_COMPARE(fileNames(Lint::discoverSources(source + "/*.c", flat)), QStringList() << "one.c" << "three.c" << "two file.c");
+    TEST_COMPARE(fileNames(Lint::discoverSources(source + "/*.cpp", flat)), QStringList());
+    TEST_COMPARE(fileNames(Lint::discoverSources(source + "/*.cpp", recursive)), QStringList() << "four.cpp");
+    TEST_COMPARE(fileNames(Lint::discoverSources(source + "/**/*.cpp", flat)), QStringList() << "four.cpp");
+    TEST_COMPARE(fileNames(Lint::discoverSources(source + "/s?b/*", flat)), QStringList() << "four.cpp");
+    TEST_COMPARE(fileNames(Lint::discoverSources(source + "/t*.c", flat)), QStringList() << "three.c" << "two file.c");
+
+    // Modules are given as canonical paths like the ones from the lint file
+    for (auto const& file : Lint::discoverSources(source + "/*.c", flat))
+    {
+        TEST_COMPARE(file, QFileInfo(file).canonicalFilePath());
+    }
+
+    // Directories stand for their source files
+    TEST_COMPARE(Lint::discoverSources(source, flat).size(), 3);
+    TEST_COMPARE(Lint::discoverSources(source, recursive).size(), 4);
+
+    // Nothing to walk
+    TEST_COMPARE(Lint::discoverSources(source + "/missing/*.c", flat).isEmpty(), true);
+}
+
+};
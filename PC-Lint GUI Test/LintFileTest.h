@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Tester.h"
+#include <map>
+#include <QString>
+
+namespace Test
+{
+
+class LintFileTest : public TestFunction
+{
+public:
+    LintFileTest() = default;
+
+    using LintFileFunctionMap = const std::map<QString, void (LintFileTest::*)(void)>;
+
+    LintFileFunctionMap m_tests =
+    {
+        {"tokenizeLintFileTest", &LintFileTest::tokenizeLintFileTest},
+        {"parseNestedLintFileTest", &LintFileTest::parseNestedLintFileTest},
+        {"discoverSourcesTest", &LintFileTest::discoverSourcesTest}
+    };
+
+private:
+
+    void tokenizeLintFileTest() noexcept;
+    void parseNestedLintFileTest() noexcept;
+    void discoverSourcesTest() noexcept;
+};
+
+};
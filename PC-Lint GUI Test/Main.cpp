@@ -1,14 +1,79 @@
 #include <QCoreApplication>
 
 #include "PCLintPlusTest.h"
+#include "SnapshotTest.h"
+#include "LexerTest.h"
+#include "MessageHelpTest.h"
+#include "SuppressionsTest.h"
+#include "LintFileTest.h"
+#include "CompileCommandsTest.h"
+#include "IncludeGraphTest.h"
+#include "TraceTest.h"
+#include "ExportTest.h"
+#include "ResultsFileTest.h"
+#include "WorkspaceTest.h"
+#include "SystemInfoTest.h"
+#include "DistributedTest.h"
+#include "TreeModelTest.h"
 
-int main(int , char *[])
+int main(int argc, char *argv[])
 {
+    // The distributed tests need an event loop
+    QCoreApplication application(argc, argv);
+
+    // Workers started by the distributed tests run this executable as their lint
+    if (Test::DistributedTest::isFakeLint(argc, argv))
+    {
+        return Test::DistributedTest::fakeLint(QCoreApplication::arguments());
+    }
+
     // Add new tests here
     Test::PCLintPlusTest linterTest;
 
     Test::TestFunction testMain;
     testMain.runTests(&linterTest, linterTest.m_tests);
 
+    Test::SnapshotTest snapshotTest;
+    testMain.runTests(&snapshotTest, snapshotTest.m_tests);
+
+    Test::LexerTest lexerTest;
+    testMain.runTests(&lexerTest, lexerTest.m_tests);
+
+    Test::MessageHelpTest messageHelpTest;
+    testMain.runTests(&messageHelpTest, messageHelpTest.m_tests);
+
+    Test::SuppressionsTest suppressionsTest;
+    testMain.runTests(&suppressionsTest, suppressionsTest.m_tests);
+
+    Test::LintFileTest lintFileTest;
+    testMain.runTests(&lintFileTest, lintFileTest.m_tests);
+
+    Test::CompileCommandsTest compileCommandsTest;
+    testMain.runTests(&compileCommandsTest, compileCommandsTest.m_tests);
+
+    Test::IncludeGraphTest includeGraphTest;
+    testMain.runTests(&includeGraphTest, includeGraphTest.m_tests);
+
+    Test::TraceTest traceTest;
+    testMain.runTests(&traceTest, traceTest.m_tests);
+
+    Test::ExportTest exportTest;
+    testMain.runTests(&exportTest, exportTest.m_tests);
+
+    Test::ResultsFileTest resultsFileTest;
+    testMain.runTests(&resultsFileTest, resultsFileTest.m_tests);
+
+    Test::WorkspaceTest workspaceTest;
+    testMain.runTests(&workspaceTest, workspaceTest.m_tests);
+
+    Test::SystemInfoTest systemInfoTest;
+    testMain.runTests(&systemInfoTest, systemInfoTest.m_tests);
+
+    Test::DistributedTest distributedTest;
+    testMain.runTests(&distributedTest, distributedTest.m_tests);
+
+    Test::TreeModelTest treeModelTest;
+    testMain.runTests(&treeModelTest, treeModelTest.m_tests);
+
     return 0;
 }
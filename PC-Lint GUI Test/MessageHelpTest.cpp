@@ -0,0 +1,53 @@
+#include "MessageHelpTest.h"
+#include "../PC-Lint GUI/MessageHelp.h"
+#include <algorithm>
+
+namespace Test
+{
+
+void MessageHelpTest::lookupTest() noexcept
+{
+    TEST_COMPARE(Lint::messageHelpCount(), 1115);
+
+    TEST_COMPARE(Lint::hasMessageHelp(1), true);
+    TEST_COMPARE(Lint::messageHelp(1), QString("End of file was reached with an open comment still unclosed."));
+
+    // Entities are decoded
+    TEST_COMPARE(Lint::messageHelp(12).contains("<filename> or \"filename\""), true);
+
+    // Gaps in the numbering and out of range numbers
+    TEST_COMPARE(Lint::hasMessageHelp(4), false);
+    TEST_COMPARE(Lint::messageHelp(4).isEmpty(), true);
+    TEST_COMPARE(Lint::hasMessageHelp(-1), false);
+    TEST_COMPARE(Lint::hasMessageHelp(100000), false);
+}
+
+void MessageHelpTest::searchTest() noexcept
+{
+    auto const contains = [](const std::vector<int>& numbers, int number)
+    {
+        return std::find(numbers.cbegin(), numbers.cend(), number) != numbers.cend();
+    };
+
+    // Every word must match, in any order and case
+    auto const unclosed = Lint::searchMessageHelp(QStringLiteral("Unclosed COMMENT"));
+    TEST_COMPARE(contains(unclosed, 1), true);
+    TEST_COMPARE(contains(unclosed, 2), false);
+    TEST_COMPARE(std::is_sorted(unclosed.cbegin(), unclosed.cend()), true);
+
+    // Words are matched by prefix
+    auto const trigraph = Lint::searchMessageHelp(QStringLiteral("trigra"));
+    TEST_COMPARE(contains(trigraph, 585), true);
+    for (auto const number : trigraph)
+    {
+        TEST_COMPARE(Lint::messageHelp(number).contains("trigra", Qt::CaseInsensitive), true);
+    }
+
+    // Message numbers find their own message
+    TEST_COMPARE(contains(Lint::searchMessageHelp(QStringLiteral("585")), 585), true);
+
+    TEST_COMPARE(Lint::searchMessageHelp(QStringLiteral("qqqzzzxxx")).empty(), true);
+    TEST_COMPARE(Lint::searchMessageHelp(QStringLiteral("  ")).empty(), true);
+}
+
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Tester.h"
+#include <map>
+#include <QString>
+
+namespace Test
+{
+
+class MessageHelpTest : public TestFunction
+{
+public:
+    MessageHelpTest() = default;
+
+    using MessageHelpFunctionMap = const std::map<QString, void (MessageHelpTest::*)(void)>;
+
+    MessageHelpFunctionMap m_tests =
+    {
+        {"lookupTest", &MessageHelpTest::lookupTest},
+        {"searchTest", &MessageHelpTest::searchTest}
+    };
+
+private:
+
+    void lookupTest() noexcept;
+    void searchTest() noexcept;
+};
+
+};
@@ -7,7 +7,9 @@ QMAKE_CXXFLAGS += -Wundef -Wpointer-arith -Wlogical-op
 CONFIG += c++17
 CONFIG -= app_bundle
 
-QT += xml widgets concurrent testlib
+QT += xml widgets concurrent network testlib
+
+win32: LIBS += -lpsapi
 
 # The following define makes your compiler emit warnings if you use
 # any Qt feature that has been marked deprecated (the exact warnings
@@ -20,10 +22,42 @@ DEFINES += QT_DEPRECATED_WARNINGS
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+include('../PC-Lint GUI/Messages/Messages.pri')
+
 SOURCES += \
+    '../PC-Lint GUI/CompileCommands.cpp' \
+    '../PC-Lint GUI/Distributed.cpp' \
+    '../PC-Lint GUI/Export.cpp' \
+    '../PC-Lint GUI/IncludeGraph.cpp' \
+    '../PC-Lint GUI/Lexer.cpp' \
+    '../PC-Lint GUI/LintFile.cpp' \
+    '../PC-Lint GUI/MessageHelp.cpp' \
     '../PC-Lint GUI/PCLintPlus.cpp' \
+    '../PC-Lint GUI/ResultsFile.cpp' \
+    '../PC-Lint GUI/Snapshot.cpp' \
+    '../PC-Lint GUI/SourceDiscovery.cpp' \
+    '../PC-Lint GUI/StringPool.cpp' \
+    '../PC-Lint GUI/Suppressions.cpp' \
+    '../PC-Lint GUI/SystemInfo.cpp' \
+    '../PC-Lint GUI/Trace.cpp' \
+    '../PC-Lint GUI/TreeModel.cpp' \
+    '../PC-Lint GUI/Workspace.cpp' \
+    CompileCommandsTest.cpp \
+    DistributedTest.cpp \
+    ExportTest.cpp \
+    IncludeGraphTest.cpp \
+    LexerTest.cpp \
+    LintFileTest.cpp \
     Main.cpp \
-    PCLintPlusTest.cpp
+    MessageHelpTest.cpp \
+    PCLintPlusTest.cpp \
+    ResultsFileTest.cpp \
+    SnapshotTest.cpp \
+    SuppressionsTest.cpp \
+    SystemInfoTest.cpp \
+    TraceTest.cpp \
+    TreeModelTest.cpp \
+    WorkspaceTest.cpp
 
 # Default rules for deployment.
 qnx: target.path = /tmp/$${TARGET}/bin
@@ -31,6 +65,36 @@ else: unix:!android: target.path = /opt/$${TARGET}/bin
 !isEmpty(target.path): INSTALLS += target
 
 HEADERS += \
+    '../PC-Lint GUI/CompileCommands.h' \
+    '../PC-Lint GUI/Distributed.h' \
+    '../PC-Lint GUI/Export.h' \
+    '../PC-Lint GUI/IncludeGraph.h' \
+    '../PC-Lint GUI/Lexer.h' \
+    '../PC-Lint GUI/LintFile.h' \
+    '../PC-Lint GUI/MessageHelp.h' \
     '../PC-Lint GUI/PCLintPlus.h' \
+    '../PC-Lint GUI/ResultsFile.h' \
+    '../PC-Lint GUI/Snapshot.h' \
+    '../PC-Lint GUI/SourceDiscovery.h' \
+    '../PC-Lint GUI/StringPool.h' \
+    '../PC-Lint GUI/Suppressions.h' \
+    '../PC-Lint GUI/SystemInfo.h' \
+    '../PC-Lint GUI/Trace.h' \
+    '../PC-Lint GUI/TreeModel.h' \
+    '../PC-Lint GUI/Workspace.h' \
+    CompileCommandsTest.h \
+    DistributedTest.h \
+    ExportTest.h \
+    IncludeGraphTest.h \
+    LexerTest.h \
+    LintFileTest.h \
+    MessageHelpTest.h \
     PCLintPlusTest.h \
+    ResultsFileTest.h \
+    SnapshotTest.h \
+    SuppressionsTest.h \
+    SystemInfoTest.h \
+    TraceTest.h \
+    TreeModelTest.h \
+    WorkspaceTest.h \
     Tester.h
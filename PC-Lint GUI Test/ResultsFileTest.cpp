@@ -0,0 +1,79 @@
+#include "ResultsFileTest.h"
+#include "../PC-Lint GUI/ResultsFile.h"
+#include "../PC-Lint GUI/Snapshot.h"
+#include <QFileInfo>
+
+namespace Test
+{
+
+void ResultsFileTest::splitResultsTest() noexcept
+{
+    const std::string_view modules = "\n--- Module:   a.c (C)\n<m><n>1</n></m>\n--- Module:   b.c (C)\n<m><n>2</n></m><m><n>3</n></m>";
+
+    // Pieces cover everything and start on a module, or on a message once there are no more modules
+    auto const pieces = Lint::splitResults(modules, 20);
+    TEST_COMPARE(pieces.size(), size_t(3));
+    TEST_COMPARE(pieces.front().begin, 0);
+    TEST_COMPARE(pieces.back().end, qint64(modules.size()));
+    for (size_t piece = 1; piece < pieces.size(); piece++)
+    {
+        TEST_COMPARE(pieces[piece].begin, pieces[piece - 1].end);
+    }
+    auto const start = [&modules](const Lint::ResultsPiece& piece)
+    {
+        return QByteArray(modules.data() + piece.begin, 3);
+    };
+    TEST_COMPARE(start(pieces[1]), QByteArray("---"));
+    TEST_COMPARE(start(pieces[2]), QByteArray("<m>"));
+
+    // Everything fits in one piece
+    TEST_COMPARE(Lint::splitResults(modules, 1 << 20).size(), size_t(1));
+    TEST_COMPARE(Lint::splitResults(std::string_view(), 4).size(), size_t(0));
+}
+
+void ResultsFileTest::readResultsFileTest() noexcept
+{
+    auto const file = QFileInfo(R"(..\PC-Lint GUI Test\data\results\results.xml)").absoluteFilePath();
+
+    auto const results = Lint::readResultsFile(file, nullptr);
+    TEST_COMPARE(results.error, QString());
+    TEST_COMPARE(results.pieces, 1);
+    TEST_COMPARE(results.parsedMessages, 8);
+
+    // The header message reported again by the second module is dropped
+    auto const& messages = results.messages;
+    TEST_COMPARE(messages.size(), size_t(7));
+    TEST_COMPARE(messages[0].type, Lint::Type::TYPE_WARNING);
+    TEST_COMPARE(messages[0].description, QString("Ignoring return value of function 'f'"));
+    TEST_COMPARE(messages[0].file, QFileInfo(R"(..\PC-Lint GUI Test\data\results\a.c)").canonicalFilePath());
+    TEST_COMPARE(messages[1].type, Lint::Type::TYPE_SUPPLEMENTAL);
+    TEST_COMPARE(messages[2].description, QString("Header file <stdio.h> not used"));
+    TEST_COMPARE(messages[3].number, 10);
+    TEST_COMPARE(messages[5].line, 10);
+    TEST_COMPARE(messages[6].type, Lint::Type::TYPE_NOTE);
+
+    // Tiny pieces parse in parallel to the same result
+    auto const split = Lint::readResultsFile(file, nullptr, 1);
+    TEST_COMPARE(split.pieces > 1, true);
+    TEST_COMPARE(split.messages.size(), messages.size());
+    for (size_t message = 0; message < messages.size(); message++)
+    {
+        TEST_COMPARE(split.messages[message] == messages[message], true);
+    }
+
+    // Mapped a few messages at a time, pieces cut off at the end of a window are read with the next one
+    auto const windowed = Lint::readResultsFile(file, nullptr, 1, 300);
+    TEST_COMPARE(windowed.error, QString());
+    TEST_COMPARE(windowed.parsedMessages, 8);
+    TEST_COMPARE(windowed.messages.size(), messages.size());
+    for (size_t message = 0; message < messages.size(); message++)
+    {
+        TEST_COMPARE(windowed.messages[message] == messages[message], true);
+    }
+
+    // Baseline messages go with their supplementals
+    auto const baseline = std::make_shared<const Lint::Baseline>(Lint::LintMessages{messages[3]}, QFileInfo(file).absolutePath());
+    TEST_COMPARE(Lint::readResultsFile(file, baseline).messages.size(), size_t(4));
+}
+
+};
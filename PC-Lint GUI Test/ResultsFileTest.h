@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Tester.h"
+#include <map>
+#include <QString>
+
+namespace Test
+{
+
+class ResultsFileTest : public TestFunction
+{
+public:
+    ResultsFileTest() = default;
+
+    using ResultsFileFunctionMap = const std::map<QString, void (ResultsFileTest::*)(void)>;
+
+    ResultsFileFunctionMap m_tests =
+    {
+        {"splitResultsTest", &ResultsFileTest::splitResultsTest},
+        {"readResultsFileTest", &ResultsFileTest::readResultsFileTest}
+    };
+
+private:
+
+    void splitResultsTest() noexcept;
+    void readResultsFileTest() noexcept;
+};
+
+};
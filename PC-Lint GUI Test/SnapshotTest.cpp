@@ -0,0 +1,89 @@
+#include "SnapshotTest.h"
+#include "../PC-Lint GUI/Snapshot.h"
+
+namespace Test
+{
+
+void SnapshotTest::fingerprintTest() noexcept
+{
+    const QString root = R"(C:\app)";
+    Lint::LintMessage message1{R"(C:\app\source1.c)", 10, Lint::Type::TYPE_WARNING, 534, "Ignoring return value of function 'f'"};
+    Lint::LintMessage message2 = message1;
+
+    // Moving a message to another line must not change its fingerprint
+    message2.line = 42;
+    TEST_COMPARE(Lint::fingerprint(message1, root), Lint::fingerprint(message2, root));
+
+    message2.number = 533;
+    TEST_COMPARE(Lint::fingerprint(message1, root) != Lint::fingerprint(message2, root), true);
+
+    message2 = message1;
+    message2.file = R"(C:\app\source2.c)";
+    TEST_COMPARE(Lint::fingerprint(message1, root) != Lint::fingerprint(message2, root), true);
+
+    // Raw relative paths from lint match the resolved paths from a snapshot
+    message2 = message1;
+    message2.file = R"(lib\..\source1.c)";
+    TEST_COMPARE(Lint::fingerprint(message1, root), Lint::fingerprint(message2, root));
+
+    // So does the same checkout somewhere else
+    message2.file = R"(D:/build/app/source1.c)";
+    TEST_COMPARE(Lint::fingerprint(message1, root), Lint::fingerprint(message2, "D:/build/app"));
+
+    // Files with the same name in different directories
+    message1.file = R"(C:\app\src\a\util.c)";
+    message2.file = R"(C:\app\src\b\util.c)";
+    TEST_COMPARE(Lint::fingerprint(message1, root) != Lint::fingerprint(message2, root), true);
+}
+
+void SnapshotTest::diffRunsTest() noexcept
+{
+    const Lint::LintMessages previous =
+    {
+        {R"(C:\app\source1.c)", 10, Lint::Type::TYPE_WARNING, 534, "Ignoring return value"},
+        {R"(C:\app\source1.c)", 12, Lint::Type::TYPE_SUPPLEMENTAL, 891, "Declaration"},
+        {R"(C:\app\source1.c)", 20, Lint::Type::TYPE_WARNING, 534, "Ignoring return value"},
+        {R"(C:\app\source2.c)", 5, Lint::Type::TYPE_ERROR, 10, "Expecting ';'"},
+    };
+
+    const Lint::LintMessages current =
+    {
+        {R"(C:\app\source1.c)", 11, Lint::Type::TYPE_WARNING, 534, "Ignoring return value"},
+        {R"(C:\app\source1.c)", 30, Lint::Type::TYPE_INFORMATION, 715, "Symbol 'x' not referenced"},
+    };
+
+    auto const diff = Lint::diffRuns(previous, current, R"(C:\app)");
+
+    // One of the two duplicate warnings is still there, the other one and the error were fixed
+    TEST_COMPARE(diff.buckets[Lint::DIFF_UNCHANGED].size(), size_t(1));
+    TEST_COMPARE(diff.buckets[Lint::DIFF_UNCHANGED][0], 0);
+    TEST_COMPARE(diff.buckets[Lint::DIFF_NEW].size(), size_t(1));
+    TEST_COMPARE(diff.buckets[Lint::DIFF_NEW][0], 1);
+    TEST_COMPARE(diff.buckets[Lint::DIFF_FIXED].size(), size_t(2));
+    TEST_COMPARE(diff.buckets[Lint::DIFF_FIXED][0], 2);
+    TEST_COMPARE(diff.buckets[Lint::DIFF_FIXED][1], 3);
+}
+
+void SnapshotTest::baselineTest() noexcept
+{
+    const Lint::LintMessages messages =
+    {
+        {R"(C:\app\source1.c)", 10, Lint::Type::TYPE_WARNING, 534, "Ignoring return value"},
+        {R"(C:\app\source1.c)", 12, Lint::Type::TYPE_SUPPLEMENTAL, 891, "Declaration"},
+        {R"(C:\app\source1.c)", 20, Lint::Type::TYPE_WARNING, 534, "Ignoring return value"},
+    };
+
+    const Lint::Baseline baseline(messages, R"(C:\app)");
+
+    // Duplicates are stored once and supplementals are never stored
+    TEST_COMPARE(baseline.size(), 1);
+    TEST_COMPARE(baseline.contains(messages[0]), true);
+    TEST_COMPARE(baseline.contains(messages[1]), false);
+
+    // Only the file with the same path is known
+    Lint::LintMessage other = messages[0];
+    other.file = R"(C:\app\lib\source1.c)";
+    TEST_COMPARE(baseline.contains(other), false);
+}
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Tester.h"
+#include <map>
+#include <QString>
+
+namespace Test
+{
+
+class SnapshotTest : public TestFunction
+{
+public:
+    SnapshotTest() = default;
+
+    using SnapshotFunctionMap = const std::map<QString, void (SnapshotTest::*)(void)>;
+
+    SnapshotFunctionMap m_tests =
+    {
+        {"fingerprintTest", &SnapshotTest::fingerprintTest},
+        {"diffRunsTest", &SnapshotTest::diffRunsTest},
+        {"baselineTest", &SnapshotTest::baselineTest}
+    };
+
+private:
+
+    void fingerprintTest() noexcept;
+    void diffRunsTest() noexcept;
+    void baselineTest() noexcept;
+};
+
+};
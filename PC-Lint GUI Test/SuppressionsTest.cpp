@@ -0,0 +1,102 @@
+#include "SuppressionsTest.h"
+#include "../PC-Lint GUI/Suppressions.h"
+#include <QTemporaryDir>
+#include <QFile>
+#include <QTextStream>
+
+namespace Test
+{
+
+void SuppressionsTest::parseSuppressionTest() noexcept
+{
+    Lint::Suppression suppression;
+
+    TEST_COMPARE(Lint::parseSuppression("-e534", suppression), true);
+    TEST_COMPARE(suppression.kind, Lint::SUPPRESS_MESSAGE);
+    TEST_COMPARE(suppression.numbers, QString("534"));
+    TEST_COMPARE(Lint::suppressionOption(suppression), QString("-e534"));
+
+    TEST_COMPARE(Lint::parseSuppression(" -esym( 7?? , foo, bar::*) ", suppression), true);
+    TEST_COMPARE(suppression.kind, Lint::SUPPRESS_SYMBOL);
+    TEST_COMPARE(suppression.numbers, QString("7??"));
+    TEST_COMPARE(suppression.names, QStringList() << "foo" << "bar::*");
+    TEST_COMPARE(Lint::suppressionOption(suppression), QString("-esym(7??, foo, bar::*)"));
+
+    TEST_COMPARE(Lint::parseSuppression(R"(-efile(766, "my file.h"))", suppression), true);
+    TEST_COMPARE(suppression.kind, Lint::SUPPRESS_FILE);
+    TEST_COMPARE(suppression.names, QStringList() << "my file.h");
+    TEST_COMPARE(Lint::suppressionOption(suppression), QString(R"(-efile(766, "my file.h"))"));
+
+    // Not suppressions, or forms that aren't supported
+    TEST_COMPARE(Lint::parseSuppression("+e534", suppression), false);
+    TEST_COMPARE(Lint::parseSuppression("-e", suppression), false);
+    TEST_COMPARE(Lint::parseSuppression("-e534 -e537", suppression), false);
+    TEST_COMPARE(Lint::parseSuppression("-esym(534)", suppression), false);
+    TEST_COMPARE(Lint::parseSuppression("-esym(534, )", suppression), false);
+    TEST_COMPARE(Lint::parseSuppression("-i\"include\"", suppression), false);
+}
+
+void SuppressionsTest::filterTest() noexcept
+{
+    std::vector<Lint::Suppression> suppressions(4);
+    Lint::parseSuppression("-e9??", suppressions[0]);
+    Lint::parseSuppression("-esym(715, unused*)", suppressions[1]);
+    Lint::parseSuppression("-efile(766, *.h)", suppressions[2]);
+    Lint::parseSuppression(R"(-efile(534, C:\app\legacy\*))", suppressions[3]);
+
+    const Lint::SuppressionFilter filter(suppressions);
+    TEST_COMPARE(filter.isEmpty(), false);
+    TEST_COMPARE(Lint::SuppressionFilter({}).isEmpty(), true);
+
+    // Wildcard message numbers
+    TEST_COMPARE(filter.suppresses(904, "a.c", ""), true);
+    TEST_COMPARE(filter.suppresses(9041, "a.c", ""), false);
+    TEST_COMPARE(filter.suppresses(94, "a.c", ""), false);
+
+    // Symbols are quoted in the description
+    TEST_COMPARE(filter.suppresses(715, "a.c", "Symbol 'unusedArgument' not referenced"), true);
+    TEST_COMPARE(filter.suppresses(715, "a.c", "Symbol 'used' (line 3) not 'unused'"), false);
+    TEST_COMPARE(filter.suppresses(716, "a.c", "Symbol 'unusedArgument' not referenced"), false);
+
+    // File names, or full paths when the pattern has a directory
+    TEST_COMPARE(filter.suppresses(766, R"(C:\app\include\A.H)", ""), true);
+    TEST_COMPARE(filter.suppresses(766, R"(C:\app\a.c)", ""), false);
+    TEST_COMPARE(filter.suppresses(534, R"(C:\app\legacy\old.c)", ""), true);
+    TEST_COMPARE(filter.suppresses(534, R"(C:\app\new.c)", ""), false);
+}
+
+void SuppressionsTest::suppressionFileTest() noexcept
+{
+    QTemporaryDir directory;
+    auto const lintFile = directory.filePath("project.lnt");
+    {
+        QFile file(lintFile);
+        file.open(QIODevice::WriteOnly | QIODevice::Text);
+        QTextStream stream(&file);
+        stream << "-i\"include\"\n";
+        stream << "-e534 // return values\n";
+        stream << "-e537 -e538\n";
+        stream << "-esym(715, x)\n";
+        stream << "source.c\n";
+    }
+
+    Lint::SuppressionFile suppressionFile;
+    TEST_COMPARE(suppressionFile.load(lintFile), true);
+    TEST_COMPARE(suppressionFile.entries().size(), size_t(2));
+    TEST_COMPARE(suppressionFile.entries()[0].option, QString("-e534"));
+    TEST_COMPARE(suppressionFile.entries()[0].line, 1);
+    TEST_COMPARE(suppressionFile.entries()[1].line, 3);
+
+    // Keep -e534, drop -esym and add a new one
+    TEST_COMPARE(suppressionFile.save({{"-e534", 1}, {"-e9??", -1}}), true);
+
+    QFile file(lintFile);
+    file.open(QIODevice::ReadOnly | QIODevice::Text);
+    auto const lines = QString(file.readAll()).split('\n', Qt::SkipEmptyParts);
+    TEST_COMPARE(lines, QStringList() << "-i\"include\"" << "-e534 // return values" << "-e537 -e538" << "source.c"
+                                      << "// Suppressions added by PC-Lint GUI" << "-e9??");
+    TEST_COMPARE(suppressionFile.entries().size(), size_t(2));
+    TEST_COMPARE(suppressionFile.entries()[1].line, 5);
+}
+
+};
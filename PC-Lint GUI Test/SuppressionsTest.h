@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Tester.h"
+#include <map>
+#include <QString>
+
+namespace Test
+{
+
+class SuppressionsTest : public TestFunction
+{
+public:
+    SuppressionsTest() = default;
+
+    using SuppressionsFunctionMap = const std::map<QString, void (SuppressionsTest::*)(void)>;
+
+    SuppressionsFunctionMap m_tests =
+    {
+        {"parseSuppressionTest", &SuppressionsTest::parseSuppressionTest},
+        {"filterTest", &SuppressionsTest::filterTest},
+        {"suppressionFileTest", &SuppressionsTest::suppressionFileTest}
+    };
+
+private:
+
+    void parseSuppressionTest() noexcept;
+    void filterTest() noexcept;
+    void suppressionFileTest() noexcept;
+};
+
+};
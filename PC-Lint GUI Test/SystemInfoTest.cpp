@@ -0,0 +1,37 @@
+#include "SystemInfoTest.h"
+#include "../PC-Lint GUI/SystemInfo.h"
+
+namespace Test
+{
+
+void SystemInfoTest::parseProcTest() noexcept
+{
+    // user nice system idle iowait irq softirq steal guest guest_nice
+    Lint::CpuTimes cpu{};
+    TEST_COMPARE(Lint::parseProcStat("cpu  100 10 40 800 30 5 5 10 50 0\ncpu0 50 5 20 400 15 2 3 5 25 0\n", cpu), true);
+    TEST_COMPARE(cpu.total, quint64(1000));
+    TEST_COMPARE(cpu.ioWait, quint64(30));
+    TEST_COMPARE(cpu.busy, quint64(170));
+    TEST_COMPARE(Lint::parseProcStat("intr 1 2 3\n", cpu), false);
+
+    Lint::MemoryInfo memory{};
+    TEST_COMPARE(Lint::parseMemInfo("MemTotal:       16000000 kB\nMemFree:         1000000 kB\nMemAvailable:    4000000 kB\n", memory), true);
+    TEST_COMPARE(memory.total, qint64(16000000) * 1024);
+    TEST_COMPARE(memory.available, qint64(4000000) * 1024);
+    TEST_COMPARE(Lint::parseMemInfo("MemTotal:       16000000 kB\n", memory), false);
+
+    // Names that only start the same don't count
+    TEST_COMPARE(Lint::parseSwappedPages("pswpin_other 7\npswpin 12\npswpout 30\n"), qint64(42));
+    TEST_COMPARE(Lint::parseSwappedPages("pgfault 12\n"), qint64(-1));
+}
+
+void SystemInfoTest::loadMonitorTest() noexcept
+{
+    Lint::LoadMonitor monitor;
+    auto const load = monitor.sample();
+    TEST_COMPARE((load.cpuBusy >= 0.0) && (load.cpuBusy <= 1.0), true);
+    TEST_COMPARE((load.memoryAvailable > 0.0) && (load.memoryAvailable <= 1.0), true);
+    TEST_COMPARE(load.swappedPages >= 0, true);
+}
+
+};
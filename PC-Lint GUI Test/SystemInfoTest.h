@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Tester.h"
+#include <map>
+#include <QString>
+
+namespace Test
+{
+
+class SystemInfoTest : public TestFunction
+{
+public:
+    SystemInfoTest() = default;
+
+    using SystemInfoFunctionMap = const std::map<QString, void (SystemInfoTest::*)(void)>;
+
+    SystemInfoFunctionMap m_tests =
+    {
+        {"parseProcTest", &SystemInfoTest::parseProcTest},
+        {"loadMonitorTest", &SystemInfoTest::loadMonitorTest}
+    };
+
+private:
+
+    void parseProcTest() noexcept;
+    void loadMonitorTest() noexcept;
+};
+
+};
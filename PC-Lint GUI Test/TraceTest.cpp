@@ -0,0 +1,69 @@
+#include "TraceTest.h"
+#include "../PC-Lint GUI/Trace.h"
+#include <QTemporaryDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <thread>
+
+namespace Test
+{
+
+void TraceTest::exportChromeTraceTest() noexcept
+{
+    Lint::Trace::clear();
+
+    // Nothing is recorded while tracing is off
+    Lint::Trace::setEnabled(false);
+    {
+        Lint::TraceScope trace("off");
+    }
+    TEST_COMPARE(Lint::Trace::spanCount(), 0);
+
+    Lint::Trace::setEnabled(true);
+    {
+        Lint::TraceScope outer("outer");
+        Lint::TraceScope inner("inner");
+    }
+    std::thread([]()
+    {
+        Lint::TraceScope trace("worker");
+    }).join();
+    Lint::Trace::setEnabled(false);
+    TEST_COMPARE(Lint::Trace::spanCount(), 3);
+
+    QTemporaryDir directory;
+    auto const file = directory.filePath("trace.json");
+    TEST_COMPARE(Lint::Trace::exportChromeTrace(file), true);
+
+    QFile trace(file);
+    TEST_COMPARE(trace.open(QIODevice::ReadOnly), true);
+    QJsonParseError error;
+    auto const events = QJsonDocument::fromJson(trace.readAll(), &error).object().value("traceEvents").toArray();
+    TEST_COMPARE(error.error, QJsonParseError::NoError);
+
+    // A name for each thread then the spans, inner finishes first
+    QStringList spans;
+    int threads = 0;
+    for (auto const& event : events)
+    {
+        auto const object = event.toObject();
+        if (object.value("ph").toString() == "M")
+        {
+            threads++;
+        }
+        else
+        {
+            spans << object.value("name").toString();
+            TEST_COMPARE(object.value("dur").toDouble() >= 0.0, true);
+        }
+    }
+    TEST_COMPARE(threads, 2);
+    TEST_COMPARE(spans, QStringList() << "inner" << "outer" << "worker");
+
+    Lint::Trace::clear();
+    TEST_COMPARE(Lint::Trace::spanCount(), 0);
+}
+
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Tester.h"
+#include <map>
+#include <QString>
+
+namespace Test
+{
+
+class TraceTest : public TestFunction
+{
+public:
+    TraceTest() = default;
+
+    using TraceFunctionMap = const std::map<QString, void (TraceTest::*)(void)>;
+
+    TraceFunctionMap m_tests =
+    {
+        {"exportChromeTraceTest", &TraceTest::exportChromeTraceTest}
+    };
+
+private:
+
+    void exportChromeTraceTest() noexcept;
+};
+
+};
@@ -0,0 +1,83 @@
+#include "TreeModelTest.h"
+#include "../PC-Lint GUI/TreeModel.h"
+
+namespace Test
+{
+
+namespace
+{
+    const QString FILE = "C:/app/a.c";
+
+    Lint::LintMessage warning(int line, int number) noexcept
+    {
+        return {FILE, line, Lint::Type::TYPE_WARNING, number, "message " + QString::number(number)};
+    }
+
+    // Column of every message under the only file in display order
+    QStringList column(const Lint::TreeModel& model, int column) noexcept
+    {
+        QStringList values;
+        auto const file = model.index(0, 0);
+        for (int row = 0; row < model.rowCount(file); row++)
+        {
+            values << model.index(row, column, file).data().toString();
+        }
+        return values;
+    }
+};
+
+void TreeModelTest::lineSortTest() noexcept
+{
+    Lint::TreeModel model;
+    model.addParent(warning(100, 1));
+    model.addParent(warning(20, 2));
+    model.addParent(warning(3, 3));
+
+    // Lines sort as numbers, not text
+    model.sort(Lint::LINT_TABLE_LINE_COLUMN, Qt::AscendingOrder);
+    TEST_COMPARE(column(model, Lint::LINT_TABLE_LINE_COLUMN), QStringList({"3", "20", "100"}));
+
+    model.sort(Lint::LINT_TABLE_LINE_COLUMN, Qt::DescendingOrder);
+    TEST_COMPARE(column(model, Lint::LINT_TABLE_LINE_COLUMN), QStringList({"100", "20", "3"}));
+}
+
+void TreeModelTest::numberSortTest() noexcept
+{
+    Lint::TreeModel model;
+    model.addParent(warning(1, 100));
+    model.addParent(warning(2, 9));
+    model.addParent(warning(3, 10));
+
+    // Numbers sort as numbers, not text
+    model.sort(Lint::LINT_TABLE_NUMBER_COLUMN, Qt::AscendingOrder);
+    TEST_COMPARE(column(model, Lint::LINT_TABLE_NUMBER_COLUMN), QStringList({"9", "10", "100"}));
+
+    model.sort(Lint::LINT_TABLE_NUMBER_COLUMN, Qt::DescendingOrder);
+    TEST_COMPARE(column(model, Lint::LINT_TABLE_NUMBER_COLUMN), QStringList({"100", "10", "9"}));
+}
+
+void TreeModelTest::supplementalSortTest() noexcept
+{
+    Lint::TreeModel model;
+    model.addParent(warning(100, 1));
+    model.addChild({FILE, 101, Lint::Type::TYPE_SUPPLEMENTAL, 831, "child of 100"});
+    model.addParent(warning(20, 2));
+    model.addChild({FILE, 21, Lint::Type::TYPE_SUPPLEMENTAL, 831, "first child of 20"});
+    model.addChild({FILE, 22, Lint::Type::TYPE_SUPPLEMENTAL, 831, "second child of 20"});
+
+    // Supplementals move with their message and stay in lint order
+    model.sort(Lint::LINT_TABLE_LINE_COLUMN, Qt::AscendingOrder);
+    auto const file = model.index(0, 0);
+    auto const first = model.index(0, 0, file);
+    auto const second = model.index(1, 0, file);
+    TEST_COMPARE(model.index(0, Lint::LINT_TABLE_LINE_COLUMN, file).data().toString(), QString("20"));
+    TEST_COMPARE(model.rowCount(first), 2);
+    TEST_COMPARE(model.index(0, Lint::LINT_TABLE_DESCRIPTION_COLUMN, first).data().toString(), QString("first child of 20"));
+    TEST_COMPARE(model.index(1, Lint::LINT_TABLE_DESCRIPTION_COLUMN, first).data().toString(), QString("second child of 20"));
+    TEST_COMPARE(model.parent(model.index(1, 0, first)), first);
+    TEST_COMPARE(model.rowCount(second), 1);
+    TEST_COMPARE(model.index(0, Lint::LINT_TABLE_DESCRIPTION_COLUMN, second).data().toString(), QString("child of 100"));
+    TEST_COMPARE(model.parent(model.index(0, 0, second)), second);
+}
+
+};
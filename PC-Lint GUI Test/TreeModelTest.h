@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Tester.h"
+#include <map>
+#include <QString>
+
+namespace Test
+{
+
+class TreeModelTest : public TestFunction
+{
+public:
+    TreeModelTest() = default;
+
+    using TreeModelFunctionMap = const std::map<QString, void (TreeModelTest::*)(void)>;
+
+    TreeModelFunctionMap m_tests =
+    {
+        {"lineSortTest", &TreeModelTest::lineSortTest},
+        {"numberSortTest", &TreeModelTest::numberSortTest},
+        {"supplementalSortTest", &TreeModelTest::supplementalSortTest}
+    };
+
+private:
+
+    void lineSortTest() noexcept;
+    void numberSortTest() noexcept;
+    void supplementalSortTest() noexcept;
+};
+
+};
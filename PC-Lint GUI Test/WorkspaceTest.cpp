@@ -0,0 +1,93 @@
+#include "WorkspaceTest.h"
+#include "../PC-Lint GUI/Workspace.h"
+#include <QTemporaryDir>
+
+namespace Test
+{
+
+void WorkspaceTest::stringPoolTest() noexcept
+{
+    Lint::StringPool pool;
+
+    // Equal strings built separately come back as the same copy
+    QString first = "Ignoring return value";
+    QString second = QString("Ignoring return ") + "value";
+    TEST_COMPARE(first.constData() == second.constData(), false);
+    TEST_COMPARE(pool.intern(first).constData() == pool.intern(second).constData(), true);
+    TEST_COMPARE(pool.size(), 1);
+
+    Lint::LintMessage message{"C:\\app\\a.c", 1, Lint::Type::TYPE_WARNING, 534, second};
+    pool.intern(message);
+    TEST_COMPARE(message.description.constData() == pool.intern(first).constData(), true);
+    TEST_COMPARE(pool.size(), 3);
+    TEST_COMPARE(pool.bytes(), qint64((first.size() + message.file.size() + message.type.size()) * 2));
+
+    // Copies handed out outlive the pool's
+    auto const pooled = pool.intern(first);
+    pool.clear();
+    TEST_COMPARE(pool.size(), 0);
+    TEST_COMPARE(pool.bytes(), qint64(0));
+    TEST_COMPARE(pooled, first);
+}
+
+void WorkspaceTest::workspaceFileTest() noexcept
+{
+    QTemporaryDir directory;
+    auto const file = directory.filePath("products.lintws");
+
+    const Lint::WorkspaceProjects projects =
+    {
+        {"Product A", QString(), directory.filePath("a/project.lnt")},
+        {"Product B", "C:/lint/pclp64.exe", directory.filePath("b/project.lnt")}
+    };
+
+    QString error;
+    TEST_COMPARE(Lint::writeWorkspace(file, projects, error), true);
+
+    Lint::WorkspaceProjects read;
+    TEST_COMPARE(Lint::readWorkspace(file, read, error), true);
+    TEST_COMPARE(read.size(), size_t(2));
+    TEST_COMPARE(read[0].name, QString("Product A"));
+    TEST_COMPARE(read[0].lintExecutable, QString());
+    TEST_COMPARE(read[0].lintFile, projects[0].lintFile);
+    TEST_COMPARE(read[1].lintExecutable, QString("C:/lint/pclp64.exe"));
+    TEST_COMPARE(read[1].lintFile, projects[1].lintFile);
+
+    // A workspace without projects is no use
+    TEST_COMPARE(Lint::writeWorkspace(file, {}, error), true);
+    TEST_COMPARE(Lint::readWorkspace(file, read, error), false);
+}
+
+void WorkspaceTest::threadShareTest() noexcept
+{
+    // 16 threads over 3 projects
+    TEST_COMPARE(Lint::workspaceThreadShare(16, 3), 5);
+    TEST_COMPARE(Lint::workspaceThreadShare(11, 2), 5);
+    TEST_COMPARE(Lint::workspaceThreadShare(6, 1), 6);
+
+    // Fewer threads than projects still gives each one a thread
+    TEST_COMPARE(Lint::workspaceThreadShare(2, 4), 1);
+    TEST_COMPARE(Lint::workspaceThreadShare(0, 1), 1);
+}
+
+void WorkspaceTest::adaptConcurrencyTest() noexcept
+{
+    // Idle CPUs with memory to spare add a process up to the maximum
+    const Lint::SystemLoad idle{0.30, 0.0, 0.60, 0};
+    TEST_COMPARE(Lint::adaptConcurrency(1, 4, idle), 2);
+    TEST_COMPARE(Lint::adaptConcurrency(4, 4, idle), 4);
+
+    // Busy CPUs or a busy disk hold
+    TEST_COMPARE(Lint::adaptConcurrency(2, 4, Lint::SystemLoad{0.95, 0.0, 0.60, 0}), 2);
+    TEST_COMPARE(Lint::adaptConcurrency(2, 4, Lint::SystemLoad{0.30, 0.40, 0.60, 0}), 2);
+
+    // Swapping or low memory backs off but never below one
+    TEST_COMPARE(Lint::adaptConcurrency(3, 4, Lint::SystemLoad{0.30, 0.0, 0.60, 12}), 2);
+    TEST_COMPARE(Lint::adaptConcurrency(1, 4, Lint::SystemLoad{0.30, 0.0, 0.05, 0}), 1);
+
+    // A new lint gets the CPUs that were idle
+    TEST_COMPARE(Lint::adaptiveLintThreads(8, idle), 6);
+    TEST_COMPARE(Lint::adaptiveLintThreads(8, Lint::SystemLoad{1.0, 0.0, 0.60, 0}), 1);
+}
+
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Tester.h"
+#include <map>
+#include <QString>
+
+namespace Test
+{
+
+class WorkspaceTest : public TestFunction
+{
+public:
+    WorkspaceTest() = default;
+
+    using WorkspaceFunctionMap = const std::map<QString, void (WorkspaceTest::*)(void)>;
+
+    WorkspaceFunctionMap m_tests =
+    {
+        {"stringPoolTest", &WorkspaceTest::stringPoolTest},
+        {"workspaceFileTest", &WorkspaceTest::workspaceFileTest},
+        {"threadShareTest", &WorkspaceTest::threadShareTest},
+        {"adaptConcurrencyTest", &WorkspaceTest::adaptConcurrencyTest}
+    };
+
+private:
+
+    void stringPoolTest() noexcept;
+    void workspaceFileTest() noexcept;
+    void threadShareTest() noexcept;
+    void adaptConcurrencyTest() noexcept;
+};
+
+};
@@ -0,0 +1,2 @@
+#pragma once
+#define ALT_ONLY 1
@@ -0,0 +1,9 @@
+#include <config.h>
+#include "common.h"
+#include "alt_only.h"
+#include <stdio.h>
+
+int a(void)
+{
+    return CONFIG + ALT_ONLY;
+}
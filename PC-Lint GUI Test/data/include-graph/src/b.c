@@ -0,0 +1,11 @@
+#include "common.h"
+// alt/ isn't an include directory outside the -env_push scope of a.c
+#include "alt_only.h"
+// #include "config.h"
+/* #include "config.h" */
+static const char* text = "#include \"config.h\"";
+
+int b(void)
+{
+    return DETAIL;
+}
@@ -16,6 +16,12 @@
 
 #include "CodeEditor.h"
 #include "Log.h"
+#include "Highlighter.h"
+#include <QtConcurrent>
+#include <QElapsedTimer>
+#include <QTextLayout>
+#include <QToolTip>
+#include <cstring>
 
 CodeEditor::CodeEditor(QWidget *parent) :
     QPlainTextEdit(parent),
@@ -23,17 +29,38 @@ CodeEditor::CodeEditor(QWidget *parent) :
     m_lineNumberAreaColour(LINE_NUMBER_AREA_COLOUR),
     m_lineNumberBackgroundColour(LINE_CURRENT_BACKGROUND_COLOUR),
     m_zoomLabel(nullptr),
-    m_highlightError(false)
+    m_highlightError(false),
+    m_plainDocument(Lint::DocumentCache::createDocument()),
+    m_largeFile(false),
+    m_windowFirstLine(0),
+    m_pendingLine(0),
+    m_loadingWindow(false),
+    m_iconError(":/images/error.png"),
+    m_iconWarning(":/images/warning.png"),
+    m_iconInformation(":/images/info.png")
 {
     // Line number area
     this->setFont(QFont("Consolas",14));
 
+    setDocument(m_plainDocument.get());
+
     QObject::connect(this, &CodeEditor::blockCountChanged, this, &CodeEditor::updateLineNumberAreaWidth);
     QObject::connect(this, &CodeEditor::updateRequest, this, &CodeEditor::updateLineNumberArea);
     QObject::connect(this, &CodeEditor::cursorPositionChanged, this, &CodeEditor::highlightCurrentLine);
+    QObject::connect(verticalScrollBar(), &QScrollBar::valueChanged, this, &CodeEditor::slotScrolled);
+    QObject::connect(&m_lineIndexWatcher, &QFutureWatcher<std::vector<qint64>>::finished, this, &CodeEditor::slotLineIndexReady);
 
     setReadOnly(true);
 
+    // Batches marker repaints while messages are arriving
+    m_markerTimer.setSingleShot(true);
+    m_markerTimer.setInterval(MARKER_REFRESH_INTERVAL);
+    QObject::connect(&m_markerTimer, &QTimer::timeout, this, [this]()
+    {
+        viewport()->update();
+        m_lineNumberArea->update();
+    });
+
     updateLineNumberAreaWidth(0);
     highlightCurrentLine();
 }
@@ -53,22 +80,93 @@ QString CodeEditor::loadedFile() const noexcept
     return m_currentFile;
 }
 
+CodeEditor::~CodeEditor()
+{
+    // The shown document is about to be destroyed with the cache so give the editor one it owns
+    auto document = Lint::DocumentCache::createDocument().release();
+    document->setParent(this);
+    setDocument(document);
+}
+
+bool CodeEditor::isLargeFile() const noexcept
+{
+    return m_largeFile;
+}
+
+void CodeEditor::prefetchFile(const QString& file) noexcept
+{
+    m_documentCache.prefetch(file);
+}
+
+void CodeEditor::closeFile(const QString& file) noexcept
+{
+    // Stop showing the document before it's destroyed
+    if (file == m_currentFile)
+    {
+        closeLargeFile();
+        setDocument(m_plainDocument.get());
+        m_plainDocument->clear();
+        m_currentFile.clear();
+        setReadOnly(true);
+        highlightCurrentLine();
+    }
+
+    m_documentCache.remove(file);
+    m_viewStates.remove(file);
+}
+
+void CodeEditor::markSaved() noexcept
+{
+    m_documentCache.markSaved(m_currentFile);
+}
+
+bool CodeEditor::isFileModified(const QString& file) noexcept
+{
+    return m_documentCache.isModified(file);
+}
+
+void CodeEditor::saveViewState() noexcept
+{
+    if (!m_currentFile.isEmpty() && !m_largeFile)
+    {
+        m_viewStates[m_currentFile] = qMakePair(textCursor().position(), verticalScrollBar()->value());
+    }
+}
+
 // Loads a file into the editor
 bool CodeEditor::loadFile(const QString& filename) noexcept
 {
-    QFile file(filename);
-    if (!file.open(QIODevice::ReadOnly | QFile::Text))
+    if (QFileInfo(filename).size() > LARGE_FILE_THRESHOLD)
+    {
+        return loadLargeFile(filename);
+    }
+
+    // Cached documents are already loaded and highlighted
+    auto const document = m_documentCache.document(filename);
+    if (!document)
     {
-        //Log::log("[Error] Cannot open file '" + filename + "' because of " + file.errorString());
+        //Log::log("[Error] Cannot open file '" + filename + "'");
         return false;
     }
     else
     {
+        saveViewState();
+        closeLargeFile();
+
         m_currentFile = filename;
-        QTextStream in(&file);
-        QString text = in.readAll();
-        this->setPlainText(text);
-        file.close();
+        setDocument(document);
+        updateLineNumberAreaWidth(0);
+        updateVisibleBlocks();
+
+        // Go back to where we were in this file
+        auto const viewState = m_viewStates.find(filename);
+        if (viewState != m_viewStates.end())
+        {
+            QTextCursor cursor(document);
+            cursor.setPosition(qMin(viewState->first, document->characterCount() - 1));
+            setTextCursor(cursor);
+            verticalScrollBar()->setValue(viewState->second);
+        }
 
         // Set the code editor read-only attribute to false
         setReadOnly(false);
@@ -78,17 +176,237 @@ bool CodeEditor::loadFile(const QString& filename) noexcept
     }
 }
 
+bool CodeEditor::reloadFile() noexcept
+{
+    if (m_currentFile.isEmpty())
+    {
+        return false;
+    }
+
+    // Never throw away the user's edits
+    if (document()->isModified())
+    {
+        qInfo() << "Not reloading" << m_currentFile << "as it has unsaved changes";
+        return false;
+    }
+
+    auto const file = m_currentFile;
+    if (m_largeFile)
+    {
+        auto const topLine = m_windowFirstLine + firstVisibleBlock().blockNumber() + 1;
+        if (!loadLargeFile(file))
+        {
+            return false;
+        }
+        selectLine(static_cast<uint32_t>(topLine));
+        return true;
+    }
+
+    QString text;
+    QDateTime lastModified;
+    if (!Lint::DocumentCache::readFile(file, text, lastModified))
+    {
+        return false;
+    }
+
+    // Only replace what changed so the highlighter and the layout redo as little as possible
+    auto const oldText = document()->toPlainText();
+    int prefix = 0;
+    auto const common = qMin(oldText.size(), text.size());
+    while ((prefix < common) && (oldText[prefix] == text[prefix]))
+    {
+        prefix++;
+    }
+    int suffix = 0;
+    while ((suffix < (common - prefix)) && (oldText[oldText.size() - suffix - 1] == text[text.size() - suffix - 1]))
+    {
+        suffix++;
+    }
+
+    if ((prefix != oldText.size()) || (prefix != text.size()))
+    {
+        auto const vertical = verticalScrollBar()->value();
+        auto const horizontal = horizontalScrollBar()->value();
+
+        QTextCursor cursor(document());
+        cursor.beginEditBlock();
+        cursor.setPosition(prefix);
+        cursor.setPosition(oldText.size() - suffix, QTextCursor::KeepAnchor);
+        cursor.insertText(text.mid(prefix, text.size() - prefix - suffix));
+        cursor.endEditBlock();
+
+        verticalScrollBar()->setValue(vertical);
+        horizontalScrollBar()->setValue(horizontal);
+        qInfo() << "Reloaded" << file << "replacing" << (oldText.size() - prefix - suffix) << "characters";
+    }
+
+    document()->setModified(false);
+    m_documentCache.markSaved(file);
+    return true;
+}
+
+bool CodeEditor::loadLargeFile(const QString& filename) noexcept
+{
+    auto mappedFile = std::make_shared<MappedFile>();
+    mappedFile->file.setFileName(filename);
+    if (!mappedFile->file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    mappedFile->size = mappedFile->file.size();
+    mappedFile->data = reinterpret_cast<const char*>(mappedFile->file.map(0, mappedFile->size));
+    if (!mappedFile->data)
+    {
+        qCritical() << "Unable to map" << filename << mappedFile->file.errorString();
+        return false;
+    }
+
+    qInfo() << "Opening" << filename << "as a large file of" << mappedFile->size << "bytes";
+
+    saveViewState();
+    closeLargeFile();
+    m_largeFile = true;
+    m_mappedFile = mappedFile;
+    m_currentFile = filename;
+
+    // Highlighting, wrapping and the current line highlight all scale with the document so switch them off
+    // Saving a window of the file would truncate it so it's read-only
+    setDocument(m_plainDocument.get());
+    setLineWrapMode(QPlainTextEdit::NoWrap);
+    setReadOnly(true);
+    m_highlightError = false;
+
+    // Show the start of the file straight away while the line index is built
+    auto previewSize = qMin(mappedFile->size, LARGE_FILE_PREVIEW_BYTES);
+    while ((previewSize < mappedFile->size) && (previewSize > 0) && (mappedFile->data[previewSize - 1] != '\n'))
+    {
+        previewSize--;
+    }
+    m_loadingWindow = true;
+    setPlainText(QString::fromUtf8(mappedFile->data, static_cast<int>(previewSize)).remove('\r'));
+    m_loadingWindow = false;
+
+    m_lineIndexWatcher.setFuture(QtConcurrent::run(&CodeEditor::buildLineIndex, std::shared_ptr<const MappedFile>(mappedFile)));
+    return true;
+}
+
+void CodeEditor::closeLargeFile() noexcept
+{
+    if (!m_largeFile)
+    {
+        return;
+    }
+
+    // The index thread keeps its own reference to the mapping if it's still running
+    m_largeFile = false;
+    m_mappedFile.reset();
+    m_lineOffsets.clear();
+    m_lineOffsets.shrink_to_fit();
+    m_windowFirstLine = 0;
+    m_pendingLine = 0;
+    m_plainDocument->clear();
+    setLineWrapMode(QPlainTextEdit::WidgetWidth);
+}
+
+std::vector<qint64> CodeEditor::buildLineIndex(std::shared_ptr<const MappedFile> mappedFile) noexcept
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    std::vector<qint64> lineOffsets;
+    // Rough guess of the average line length to avoid most of the reallocations
+    lineOffsets.reserve(static_cast<size_t>(mappedFile->size / 32) + 1);
+    lineOffsets.emplace_back(0);
+
+    auto const begin = mappedFile->data;
+    auto const end = begin + mappedFile->size;
+    auto position = begin;
+    while ((position = static_cast<const char*>(std::memchr(position, '\n', static_cast<size_t>(end - position)))) != nullptr)
+    {
+        position++;
+        lineOffsets.emplace_back(position - begin);
+    }
+
+    qInfo() << "Indexed" << lineOffsets.size() << "lines in" << timer.elapsed() << "ms";
+    return lineOffsets;
+}
+
+void CodeEditor::slotLineIndexReady() noexcept
+{
+    if (!m_largeFile)
+    {
+        return;
+    }
+
+    m_lineOffsets = m_lineIndexWatcher.result();
+    updateLineNumberAreaWidth(0);
+
+    if (m_pendingLine > 0)
+    {
+        auto const line = m_pendingLine;
+        m_pendingLine = 0;
+        selectLine(line);
+    }
+}
+
+void CodeEditor::loadWindow(int firstLine) noexcept
+{
+    auto const lines = static_cast<int>(m_lineOffsets.size());
+    firstLine = qBound(0, firstLine, qMax(0, lines - LARGE_FILE_WINDOW_LINES));
+    auto const lastLine = qMin(lines, firstLine + LARGE_FILE_WINDOW_LINES);
+
+    auto const begin = m_lineOffsets[firstLine];
+    auto const end = (lastLine < lines) ? m_lineOffsets[lastLine] : m_mappedFile->size;
+
+    QString text = QString::fromUtf8(m_mappedFile->data + begin, static_cast<int>(end - begin));
+    text.remove('\r');
+    // The last newline belongs to the line after the window
+    if ((lastLine < lines) && text.endsWith('\n'))
+    {
+        text.chop(1);
+    }
+
+    m_loadingWindow = true;
+    m_windowFirstLine = firstLine;
+    setPlainText(text);
+    m_loadingWindow = false;
+    m_lineNumberArea->update();
+}
+
+void CodeEditor::slotScrolled(int value) noexcept
+{
+    if (!m_largeFile || m_loadingWindow || m_lineOffsets.empty())
+    {
+        return;
+    }
+
+    // Move the window when the viewport gets close to either end of it
+    auto const lines = static_cast<int>(m_lineOffsets.size());
+    bool const nearTop = (value < LARGE_FILE_SCROLL_MARGIN) && (m_windowFirstLine > 0);
+    bool const nearBottom = (value > verticalScrollBar()->maximum() - LARGE_FILE_SCROLL_MARGIN) &&
+                            (m_windowFirstLine + blockCount() < lines);
+
+    if (nearTop || nearBottom)
+    {
+        auto const firstVisibleLine = m_windowFirstLine + value;
+        loadWindow(firstVisibleLine - LARGE_FILE_WINDOW_LINES / 2);
+        verticalScrollBar()->setValue(firstVisibleLine - m_windowFirstLine);
+    }
+}
+
 int CodeEditor::lineNumberAreaWidth() noexcept
 {
     int digits = 1;
-    int max = qMax(1, blockCount());
+    int max = qMax(1, m_largeFile ? qMax(blockCount(), static_cast<int>(m_lineOffsets.size())) : blockCount());
     while (max >= 10)
     {
         max /= 10;
         ++digits;
     }
 
-    int space = 16 + fontMetrics().horizontalAdvance(QLatin1Char('9')) * digits;
+    // Room for the line number and a message marker
+    int space = 16 + fontMetrics().horizontalAdvance(QLatin1Char('9')) * digits + markerSize() + 4;
 
     return space;
 }
@@ -114,6 +432,19 @@ void CodeEditor::updateLineNumberArea(const QRect &rect, int dy) noexcept
     {
         updateLineNumberAreaWidth(0);
     }
+
+    updateVisibleBlocks();
+}
+
+void CodeEditor::updateVisibleBlocks() noexcept
+{
+    // Let the highlighter format what's on screen before the rest of the document
+    if (auto const highlighter = document()->findChild<Lint::Highlighter*>())
+    {
+        auto const first = firstVisibleBlock().blockNumber();
+        auto const lines = viewport()->height() / qMax(1, fontMetrics().height()) + 1;
+        highlighter->setVisibleBlocks(first, first + lines);
+    }
 }
 
 
@@ -127,6 +458,31 @@ void CodeEditor::resizeEvent(QResizeEvent *e) noexcept
 
 void CodeEditor::selectLine(uint32_t line) noexcept
 {
+    if (m_largeFile)
+    {
+        // Jump once the line index is ready
+        if (m_lineOffsets.empty())
+        {
+            m_pendingLine = line;
+            return;
+        }
+
+        // Only decode the lines around the target
+        auto const target = qBound(0, static_cast<int>(line) - 1, static_cast<int>(m_lineOffsets.size()) - 1);
+        if ((target < m_windowFirstLine) || (target >= m_windowFirstLine + blockCount()))
+        {
+            loadWindow(target - LARGE_FILE_WINDOW_LINES / 2);
+        }
+
+        QTextCursor cursor(document()->findBlockByNumber(target - m_windowFirstLine));
+        cursor.select(QTextCursor::LineUnderCursor);
+        m_loadingWindow = true;
+        setTextCursor(cursor);
+        centerCursor();
+        m_loadingWindow = false;
+        return;
+    }
+
     // line-1 because line number starts from 0
     QTextCursor cursor(this->document()->findBlockByLineNumber(line-1));
     this->setTextCursor(cursor);
@@ -155,7 +511,7 @@ void CodeEditor::highlightCurrentLine() noexcept
     QList<QTextEdit::ExtraSelection> extraSelections;
 
     // Only highlight if a file is loaded
-    if (!isReadOnly() && m_currentFile.length())
+    if (!isReadOnly() && !m_largeFile && m_currentFile.length())
     {
         QTextEdit::ExtraSelection selection;
 
@@ -185,14 +541,44 @@ void CodeEditor::lineNumberAreaPaintEvent(QPaintEvent *event) noexcept
     int top = qRound(blockBoundingGeometry(block).translated(contentOffset()).top());
     int bottom = top + qRound(blockBoundingRect(block).height());
 
+    // Only the messages on the lines in view are looked at
+    auto const file = markerFile();
+    auto const size = markerSize();
+    Lint::TreeModel::LineMessages messages;
+    if (file >= 0)
+    {
+        auto const visibleLines = viewport()->height() / qMax(1, fontMetrics().height()) + 1;
+        messages = m_messageModel->lineMessages(file, blockLine(block), blockLine(block) + visibleLines);
+    }
+
     // Only draw the line number if we have a loaded file
     while (block.isValid() && top <= event->rect().bottom() && m_currentFile.length())
     {
         if (block.isVisible() && bottom >= event->rect().top())
         {
-            QString number = QString::number(blockNumber + 1);
+            QString number = QString::number(m_windowFirstLine + blockNumber + 1);
             painter.setPen(Qt::black);
             painter.drawText(0, top, m_lineNumberArea->width(), fontMetrics().height()+4,Qt::AlignLeft, number);
+
+            // Marker for the most severe message on the line
+            if (file >= 0)
+            {
+                const QRect markerRect(m_lineNumberArea->width() - size - 2, top + 1, size, size);
+                switch (lineSeverity(messages, blockLine(block)))
+                {
+                case Lint::MESSAGE_ERROR:
+                    m_iconError.paint(&painter, markerRect);
+                    break;
+                case Lint::MESSAGE_WARNING:
+                    m_iconWarning.paint(&painter, markerRect);
+                    break;
+                case Lint::MESSAGE_INFORMATION:
+                    m_iconInformation.paint(&painter, markerRect);
+                    break;
+                default:
+                    break;
+                }
+            }
         }
 
         block = block.next();
@@ -202,6 +588,163 @@ void CodeEditor::lineNumberAreaPaintEvent(QPaintEvent *event) noexcept
     }
 }
 
+void CodeEditor::setMessageModel(const Lint::TreeModel* model) noexcept
+{
+    m_messageModel = model;
+
+    auto const markersChanged = [this]()
+    {
+        if (!m_markerTimer.isActive())
+        {
+            m_markerTimer.start();
+        }
+    };
+    QObject::connect(model, &QAbstractItemModel::rowsInserted, this, markersChanged);
+    // A re-lint removes the rows of the files it replaces
+    QObject::connect(model, &QAbstractItemModel::rowsRemoved, this, markersChanged);
+    QObject::connect(model, &QAbstractItemModel::modelReset, this, [this]()
+    {
+        viewport()->update();
+        m_lineNumberArea->update();
+    });
+}
+
+int CodeEditor::markerFile() const noexcept
+{
+    return (m_messageModel && !m_currentFile.isEmpty()) ? m_messageModel->findFile(m_currentFile) : -1;
+}
+
+int CodeEditor::markerSize() const noexcept
+{
+    return qMax(8, fontMetrics().height() - 2);
+}
+
+int CodeEditor::blockLine(const QTextBlock& block) const noexcept
+{
+    return m_windowFirstLine + block.blockNumber() + 1;
+}
+
+Lint::Message CodeEditor::lineSeverity(Lint::TreeModel::LineMessages& messages, int line) const noexcept
+{
+    // Moves the range past the line so the visible lines are walked once in order
+    auto severity = Lint::MESSAGE_UNKNOWN;
+    while ((messages.first != messages.second) && (m_messageModel->message(*messages.first).line <= line))
+    {
+        auto const& message = m_messageModel->message(*messages.first);
+        if ((message.line == line) && (message.type <= Lint::MESSAGE_INFORMATION) && (message.type < severity))
+        {
+            severity = message.type;
+        }
+        ++messages.first;
+    }
+    return severity;
+}
+
+void CodeEditor::paintEvent(QPaintEvent *event)
+{
+    QPlainTextEdit::paintEvent(event);
+    paintUnderlines(event->rect());
+}
+
+void CodeEditor::paintUnderlines(const QRect& rect) noexcept
+{
+    auto const file = markerFile();
+    if (file < 0)
+    {
+        return;
+    }
+
+    auto block = firstVisibleBlock();
+    auto const visibleLines = viewport()->height() / qMax(1, fontMetrics().height()) + 1;
+    auto messages = m_messageModel->lineMessages(file, blockLine(block), blockLine(block) + visibleLines);
+    if (messages.first == messages.second)
+    {
+        return;
+    }
+
+    QPainter painter(viewport());
+    auto const offset = contentOffset();
+
+    while (block.isValid() && (messages.first != messages.second))
+    {
+        auto const geometry = blockBoundingGeometry(block).translated(offset);
+        if (geometry.top() > rect.bottom())
+        {
+            break;
+        }
+
+        auto const severity = lineSeverity(messages, blockLine(block));
+        auto const layout = block.layout();
+        if ((severity != Lint::MESSAGE_UNKNOWN) && block.isVisible() && (geometry.bottom() >= rect.top()) && layout && (layout->lineCount() > 0))
+        {
+            // Wavy line under the first line of the block from its first non-whitespace character
+            auto const line = layout->lineAt(0);
+            auto const text = block.text();
+            int start = 0;
+            while ((start < text.size()) && text[start].isSpace())
+            {
+                start++;
+            }
+
+            auto const x = geometry.left() + layout->position().x();
+            auto const left = x + line.cursorToX(start);
+            auto right = x + line.x() + line.naturalTextWidth();
+            if (right <= left)
+            {
+                right = left + fontMetrics().horizontalAdvance(QLatin1Char('9')) * 4;
+            }
+            auto const y = geometry.top() + layout->position().y() + line.y() + line.height() - 2;
+
+            QPolygonF wave;
+            for (int i = 0; left + i * 2 <= right; i++)
+            {
+                wave << QPointF(left + i * 2, y + ((i % 2) ? -1.5 : 0.5));
+            }
+
+            painter.setPen((severity == Lint::MESSAGE_ERROR) ? MARKER_ERROR_COLOUR :
+                           (severity == Lint::MESSAGE_WARNING) ? MARKER_WARNING_COLOUR : MARKER_INFORMATION_COLOUR);
+            painter.drawPolyline(wave);
+        }
+
+        block = block.next();
+    }
+}
+
+bool CodeEditor::viewportEvent(QEvent *event)
+{
+    if ((event->type() == QEvent::ToolTip) && showMessageToolTip(static_cast<QHelpEvent*>(event), viewport()))
+    {
+        return true;
+    }
+    return QPlainTextEdit::viewportEvent(event);
+}
+
+bool CodeEditor::showMessageToolTip(QHelpEvent* event, QWidget* widget) noexcept
+{
+    auto const file = markerFile();
+    if (file < 0)
+    {
+        return false;
+    }
+
+    auto const line = blockLine(cursorForPosition(QPoint(0, event->pos().y())).block());
+    auto messages = m_messageModel->lineMessages(file, line, line);
+    if (messages.first == messages.second)
+    {
+        QToolTip::hideText();
+        return false;
+    }
+
+    QStringList text;
+    for (auto message = messages.first; message != messages.second; ++message)
+    {
+        auto const& lintMessage = m_messageModel->message(*message);
+        text << Lint::messageTypeName(lintMessage.type) + " " + QString::number(lintMessage.number) + ": " + lintMessage.description;
+    }
+    QToolTip::showText(event->globalPos(), text.join('\n'), widget);
+    return true;
+}
+
 bool CodeEditor::eventFilter(QObject *object, QEvent *event) noexcept
 {
     if (event->type() == QEvent::Wheel)
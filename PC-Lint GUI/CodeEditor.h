@@ -25,11 +25,38 @@
 #include <QScrollBar>
 #include <QColor>
 #include <QLabel>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QPair>
+#include <QPointer>
+#include <QTimer>
+#include <QIcon>
+#include <QHelpEvent>
 #include <memory>
+#include <vector>
+#include "DocumentCache.h"
+#include "TreeModel.h"
 
 
 #define LINE_NUMBER_AREA_COLOUR QColor(240,240,240)
 #define LINE_CURRENT_BACKGROUND_COLOUR QColor(252,249,241)
+#define MARKER_ERROR_COLOUR QColor(255,0,0)
+#define MARKER_WARNING_COLOUR QColor(255,165,0)
+#define MARKER_INFORMATION_COLOUR QColor(0,0,255)
+
+// Markers are repainted at most this often while messages are arriving
+constexpr int MARKER_REFRESH_INTERVAL = 500;
+
+// Files bigger than this are memory mapped and shown a window of lines at a time
+constexpr qint64 LARGE_FILE_THRESHOLD = 8 * 1024 * 1024;
+// Lines held in the document at once for large files
+constexpr int LARGE_FILE_WINDOW_LINES = 4000;
+// Scrolling this close to the edge of the window moves the window
+constexpr int LARGE_FILE_SCROLL_MARGIN = 200;
+// Shown while the line index of a large file is being built
+constexpr qint64 LARGE_FILE_PREVIEW_BYTES = 256 * 1024;
 
 QT_BEGIN_NAMESPACE
 class QPaintEvent;
@@ -46,31 +73,93 @@ class CodeEditor : public QPlainTextEdit
 
 public:
     CodeEditor(QWidget *parent = nullptr);
-    ~CodeEditor() = default;
+    ~CodeEditor();
     void lineNumberAreaPaintEvent(QPaintEvent *event) noexcept;
     int lineNumberAreaWidth() noexcept;
     bool loadFile(const QString& file) noexcept;
+    // Pick up changes made to the shown file on disk keeping the view where it is
+    bool reloadFile() noexcept;
     void selectLine(uint32_t line) noexcept;
     void setLineNumberAreaColour(const QColor& colour) noexcept;
     void setLineNumberBackgroundColour(const QColor& colour) noexcept;
     QString loadedFile() const noexcept;
     void setLabel(QLabel* label) noexcept;
+    // Read a file in the background so opening it later is instant
+    void prefetchFile(const QString& file) noexcept;
+    // Forget a file (unsaved changes included), clearing the editor if it's shown
+    void closeFile(const QString& file) noexcept;
+    // The loaded file has been written out
+    void markSaved() noexcept;
+    bool isFileModified(const QString& file) noexcept;
+    // Large files are shown a window at a time and are read-only
+    bool isLargeFile() const noexcept;
+    // Lint results to show as markers in the gutter and underlines in the text
+    void setMessageModel(const Lint::TreeModel* model) noexcept;
+    // Messages on the line under the cursor
+    bool showMessageToolTip(QHelpEvent* event, QWidget* widget) noexcept;
 protected:
     void resizeEvent(QResizeEvent *event) noexcept override;
+    void paintEvent(QPaintEvent *event) override;
+    bool viewportEvent(QEvent *event) override;
     bool eventFilter(QObject *object, QEvent *event) noexcept override;
 
 private slots:
     void updateLineNumberAreaWidth(int newBlockCount) noexcept;
     void highlightCurrentLine() noexcept;
     void updateLineNumberArea(const QRect &rect, int dy) noexcept;
+    void slotLineIndexReady() noexcept;
+    void slotScrolled(int value) noexcept;
 
 private:
+    // Memory mapped file shared with the thread building its line index
+    struct MappedFile
+    {
+        QFile file;
+        const char* data;
+        qint64 size;
+    };
+
+    bool loadLargeFile(const QString& filename) noexcept;
+    void closeLargeFile() noexcept;
+    void loadWindow(int firstLine) noexcept;
+    void saveViewState() noexcept;
+    void updateVisibleBlocks() noexcept;
+    static std::vector<qint64> buildLineIndex(std::shared_ptr<const MappedFile> mappedFile) noexcept;
+    int markerFile() const noexcept;
+    int markerSize() const noexcept;
+    int blockLine(const QTextBlock& block) const noexcept;
+    Lint::Message lineSeverity(Lint::TreeModel::LineMessages& messages, int line) const noexcept;
+    void paintUnderlines(const QRect& rect) noexcept;
+
     std::unique_ptr<LineNumberArea> m_lineNumberArea;
     QColor m_lineNumberAreaColour;
     QColor m_lineNumberBackgroundColour;
     QString m_currentFile;
     QLabel* m_zoomLabel;
     bool m_highlightError;
+
+    // Loaded and highlighted files, the editor shows one of their documents
+    Lint::DocumentCache m_documentCache;
+    // Document for large files and for when nothing is loaded
+    std::unique_ptr<QTextDocument> m_plainDocument;
+    // File -> cursor position and scroll bar value when it was last shown
+    QHash<QString, QPair<int, int>> m_viewStates;
+
+    // Large file mode
+    bool m_largeFile;
+    std::shared_ptr<MappedFile> m_mappedFile;
+    std::vector<qint64> m_lineOffsets;          // Line -> offset of its first character
+    QFutureWatcher<std::vector<qint64>> m_lineIndexWatcher;
+    int m_windowFirstLine;                      // Line shown by the first block of the document
+    uint32_t m_pendingLine;                     // Line to select once the index is ready
+    bool m_loadingWindow;
+
+    // Lint message markers
+    QPointer<const Lint::TreeModel> m_messageModel;
+    QTimer m_markerTimer;
+    QIcon m_iconError;
+    QIcon m_iconWarning;
+    QIcon m_iconInformation;
 };
 
 class LineNumberArea : public QWidget
@@ -93,6 +182,15 @@ protected:
         m_m_codeEditor->lineNumberAreaPaintEvent(event);
     }
 
+    bool event(QEvent *event) noexcept override
+    {
+        if ((event->type() == QEvent::ToolTip) && m_m_codeEditor->showMessageToolTip(static_cast<QHelpEvent*>(event), this))
+        {
+            return true;
+        }
+        return QWidget::event(event);
+    }
+
 private:
     CodeEditor* m_m_codeEditor;
 };
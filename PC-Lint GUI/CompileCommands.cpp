@@ -0,0 +1,624 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "CompileCommands.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QHash>
+#include <QSet>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace Lint
+{
+
+namespace
+{
+    // Just enough of a JSON reader to walk a compilation database in place
+    class JsonReader
+    {
+    public:
+        JsonReader(const char* data, qint64 size) :
+            m_data(data),
+            m_size(size),
+            m_position(0)
+        {
+        }
+
+        void skipSpace() noexcept
+        {
+            while ((m_position < m_size) && std::strchr(" \t\r\n", m_data[m_position]) && m_data[m_position])
+            {
+                m_position++;
+            }
+        }
+
+        bool consume(char character) noexcept
+        {
+            skipSpace();
+            if ((m_position < m_size) && (m_data[m_position] == character))
+            {
+                m_position++;
+                return true;
+            }
+            return false;
+        }
+
+        bool expect(char character) noexcept
+        {
+            if (!consume(character))
+            {
+                return fail(QString("expected '%1'").arg(character));
+            }
+            return true;
+        }
+
+        bool readString(QString& string) noexcept
+        {
+            string.clear();
+            if (!expect('"'))
+            {
+                return false;
+            }
+
+            while (m_position < m_size)
+            {
+                // Copy everything up to the next quote or escape in one go
+                auto const start = m_position;
+                while ((m_position < m_size) && (m_data[m_position] != '"') && (m_data[m_position] != '\\'))
+                {
+                    m_position++;
+                }
+                string += QString::fromUtf8(m_data + start, static_cast<int>(m_position - start));
+
+                if (m_position >= m_size)
+                {
+                    break;
+                }
+                if (m_data[m_position++] == '"')
+                {
+                    return true;
+                }
+                if (m_position >= m_size)
+                {
+                    break;
+                }
+
+                auto const escape = m_data[m_position++];
+                switch (escape)
+                {
+                case 'b': string += '\b'; break;
+                case 'f': string += '\f'; break;
+                case 'n': string += '\n'; break;
+                case 'r': string += '\r'; break;
+                case 't': string += '\t'; break;
+                case 'u':
+                {
+                    // Surrogate pairs come as two escapes which QString puts back together
+                    bool ok = false;
+                    auto const code = QByteArray(m_data + m_position, static_cast<int>(std::min<qint64>(4, m_size - m_position))).toUShort(&ok, 16);
+                    if (!ok)
+                    {
+                        return fail("bad \\u escape");
+                    }
+                    string += QChar(code);
+                    m_position += 4;
+                    break;
+                }
+                default:
+                    string += QChar::fromLatin1(escape);
+                    break;
+                }
+            }
+            return fail("unterminated string");
+        }
+
+        bool readStringArray(QStringList& strings) noexcept
+        {
+            strings.clear();
+            if (!expect('['))
+            {
+                return false;
+            }
+            if (consume(']'))
+            {
+                return true;
+            }
+
+            QString string;
+            do
+            {
+                if (!readString(string))
+                {
+                    return false;
+                }
+                strings << string;
+            }
+            while (consume(','));
+            return expect(']');
+        }
+
+        bool skipValue() noexcept
+        {
+            skipSpace();
+            if (m_position >= m_size)
+            {
+                return fail("unexpected end of file");
+            }
+
+            QString string;
+            switch (m_data[m_position])
+            {
+            case '"':
+                return readString(string);
+            case '[':
+            case '{':
+            {
+                auto const close = (m_data[m_position++] == '[') ? ']' : '}';
+                if (consume(close))
+                {
+                    return true;
+                }
+                do
+                {
+                    if ((close == '}') && (!readString(string) || !expect(':')))
+                    {
+                        return false;
+                    }
+                    if (!skipValue())
+                    {
+                        return false;
+                    }
+                }
+                while (consume(','));
+                return expect(close);
+            }
+            default:
+                // Number, true, false or null
+                while ((m_position < m_size) && !std::strchr(",]} \t\r\n", m_data[m_position]))
+                {
+                    m_position++;
+                }
+                return true;
+            }
+        }
+
+        bool fail(const QString& error) noexcept
+        {
+            if (m_error.isEmpty())
+            {
+                m_error = QString("%1 at byte %2").arg(error, QString::number(m_position));
+            }
+            return false;
+        }
+
+        const QString& error() const noexcept
+        {
+            return m_error;
+        }
+
+    private:
+        const char* m_data;
+        qint64 m_size;
+        qint64 m_position;
+        QString m_error;
+    };
+
+    // Options with the same includes and defines
+    struct OptionSet
+    {
+        QStringList includes;
+        QStringList defines;
+        QStringList undefines;
+        QStringList files;
+    };
+
+    QString quoted(const QString& text) noexcept
+    {
+        return '"' + text + '"';
+    }
+
+    // First line of every generated lint file
+    constexpr char GENERATED_PREFIX[] = "// Generated from ";
+    constexpr char GENERATED_SUFFIX[] = " by PC-Lint GUI";
+
+    // Shard name of a lint file, project.lnt -> project_2.lnt
+    QString shardFileName(const QFileInfo& lintFile, int shard) noexcept
+    {
+        return QString("%1_%2.%3").arg(lintFile.completeBaseName(), QString::number(shard), lintFile.suffix());
+    }
+
+    // Delete shards of an earlier import that this one won't overwrite
+    // Only files the importer wrote are touched
+    void removeStaleShards(const QFileInfo& lintFile, int shards) noexcept
+    {
+        auto const prefix = lintFile.completeBaseName() + '_';
+        auto const suffix = '.' + lintFile.suffix();
+        auto const directory = lintFile.dir();
+        for (auto const& name : directory.entryList({prefix + '*' + suffix}, QDir::Files))
+        {
+            bool isShard = false;
+            auto const shard = name.mid(prefix.size(), name.size() - prefix.size() - suffix.size()).toInt(&isShard);
+            if (!isShard || (name != shardFileName(lintFile, shard)) || ((shards > 1) && (shard <= shards)))
+            {
+                continue;
+            }
+
+            QFile file(directory.filePath(name));
+            if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+            {
+                continue;
+            }
+            auto const header = QString::fromUtf8(file.readLine()).trimmed();
+            file.close();
+            if (header.startsWith(GENERATED_PREFIX) && header.endsWith(GENERATED_SUFFIX))
+            {
+                qInfo() << "Removing stale shard" << file.fileName();
+                if (!file.remove())
+                {
+                    qWarning() << "Unable to remove" << file.fileName() << file.errorString();
+                }
+            }
+        }
+    }
+};
+
+QStringList splitCommandLine(const QString& command) noexcept
+{
+    QStringList arguments;
+    QString argument;
+    bool inArgument = false;
+    QChar quote;
+
+    for (int i = 0; i < command.size(); i++)
+    {
+        auto const character = command[i];
+        auto const next = (i + 1 < command.size()) ? command[i + 1] : QChar();
+
+        if ((character == '\\') && ((next == '"') || (next == '\'')) && (quote != '\''))
+        {
+            argument += next;
+            inArgument = true;
+            i++;
+        }
+        else if (!quote.isNull())
+        {
+            if (character == quote)
+            {
+                quote = QChar();
+            }
+            else
+            {
+                argument += character;
+            }
+        }
+        else if ((character == '"') || (character == '\''))
+        {
+            quote = character;
+            inArgument = true;
+        }
+        else if (character.isSpace())
+        {
+            if (inArgument)
+            {
+                arguments << argument;
+                argument.clear();
+                inArgument = false;
+            }
+        }
+        else
+        {
+            argument += character;
+            inArgument = true;
+        }
+    }
+
+    if (inArgument)
+    {
+        arguments << argument;
+    }
+    return arguments;
+}
+
+CompileCommand parseCompileArguments(const QString& directory, const QString& file, const QStringList& arguments) noexcept
+{
+    const QDir workingDirectory(directory);
+    CompileCommand command;
+    command.file = QDir::cleanPath(workingDirectory.absoluteFilePath(QDir::fromNativeSeparators(file)));
+
+    // cl style /I and /D are only options for cl, anywhere else they're paths
+    auto const compiler = arguments.isEmpty() ? QString() : QFileInfo(QDir::fromNativeSeparators(arguments.front())).baseName().toLower();
+    auto const msvc = (compiler == "cl") || (compiler == "clang-cl");
+
+    // Value of an option given either as -Ivalue or -I value
+    auto const value = [&arguments](int& argument, const QString& option) -> QString
+    {
+        auto const& text = arguments[argument];
+        if (text.size() > option.size())
+        {
+            return text.mid(option.size());
+        }
+        return (argument + 1 < arguments.size()) ? arguments[++argument] : QString();
+    };
+
+    static const QStringList includeOptions = {"-isystem", "-iquote", "-idirafter", "-I"};
+    for (int argument = 1; argument < arguments.size(); argument++)
+    {
+        auto const& text = arguments[argument];
+        auto const option = text.left(2);
+
+        auto const includeOption = std::find_if(includeOptions.cbegin(), includeOptions.cend(), [&text](const QString& include)
+        {
+            return text.startsWith(include);
+        });
+        if ((includeOption != includeOptions.cend()) || (msvc && (option == "/I")))
+        {
+            auto const include = value(argument, (includeOption != includeOptions.cend()) ? *includeOption : option);
+            if (!include.isEmpty())
+            {
+                command.includes << QDir::cleanPath(workingDirectory.absoluteFilePath(QDir::fromNativeSeparators(include)));
+            }
+        }
+        else if ((option == "-D") || (msvc && (option == "/D")))
+        {
+            auto const define = value(argument, option);
+            if (!define.isEmpty())
+            {
+                command.defines << define;
+            }
+        }
+        else if ((option == "-U") || (msvc && (option == "/U")))
+        {
+            auto const undefine = value(argument, option);
+            if (!undefine.isEmpty())
+            {
+                command.undefines << undefine;
+            }
+        }
+    }
+
+    command.includes.removeDuplicates();
+    return command;
+}
+
+bool readCompileCommands(const QString& file, const std::function<void(const CompileCommand&)>& callback, QString& error) noexcept
+{
+    QFile input(file);
+    if (!input.open(QIODevice::ReadOnly))
+    {
+        error = input.errorString();
+        return false;
+    }
+
+    // Mapped so the file is never copied, read in if mapping isn't possible
+    QByteArray contents;
+    auto const size = input.size();
+    auto const* data = reinterpret_cast<const char*>(input.map(0, size));
+    if (!data)
+    {
+        contents = input.readAll();
+        data = contents.constData();
+    }
+
+    JsonReader reader(data, size);
+    if (!reader.expect('['))
+    {
+        error = reader.error();
+        return false;
+    }
+
+    QString key;
+    QString directory;
+    QString sourceFile;
+    QString command;
+    QStringList arguments;
+    if (!reader.consume(']'))
+    {
+        do
+        {
+            directory.clear();
+            sourceFile.clear();
+            command.clear();
+            arguments.clear();
+
+            if (!reader.expect('{'))
+            {
+                break;
+            }
+            if (!reader.consume('}'))
+            {
+                bool ok = true;
+                do
+                {
+                    ok = reader.readString(key) && reader.expect(':');
+                    if (ok)
+                    {
+                        if (key == "directory")
+                        {
+                            ok = reader.readString(directory);
+                        }
+                        else if (key == "file")
+                        {
+                            ok = reader.readString(sourceFile);
+                        }
+                        else if (key == "command")
+                        {
+                            ok = reader.readString(command);
+                        }
+                        else if (key == "arguments")
+                        {
+                            ok = reader.readStringArray(arguments);
+                        }
+                        else
+                        {
+                            ok = reader.skipValue();
+                        }
+                    }
+                }
+                while (ok && reader.consume(','));
+                if (!ok || !reader.expect('}'))
+                {
+                    break;
+                }
+            }
+
+            if (!sourceFile.isEmpty())
+            {
+                callback(parseCompileArguments(directory, sourceFile, arguments.isEmpty() ? splitCommandLine(command) : arguments));
+            }
+        }
+        while (reader.consume(','));
+
+        if (reader.error().isEmpty())
+        {
+            reader.expect(']');
+        }
+    }
+
+    error = reader.error();
+    return error.isEmpty();
+}
+
+CompileCommandsImport importCompileCommands(const QString& compileCommands, const QString& lintFile,
+                                            int shards, const QString& baseLintFile) noexcept
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    CompileCommandsImport result{0, 0, {}, {}};
+    std::vector<OptionSet> optionSets;
+    QHash<QString, int> optionSetIds;
+    QSet<QString> files;
+
+    QString error;
+    auto const read = readCompileCommands(compileCommands, [&](const CompileCommand& command)
+    {
+        // A file built more than once is linted with its first options
+        if (files.contains(command.file))
+        {
+            return;
+        }
+        files.insert(command.file);
+
+        auto const key = command.includes.join('\n') + '\0' + command.defines.join('\n') + '\0' + command.undefines.join('\n');
+        auto optionSet = optionSetIds.find(key);
+        if (optionSet == optionSetIds.end())
+        {
+            optionSet = optionSetIds.insert(key, static_cast<int>(optionSets.size()));
+            optionSets.push_back(OptionSet{command.includes, command.defines, command.undefines, {}});
+        }
+        optionSets[static_cast<size_t>(*optionSet)].files << command.file;
+    }, error);
+
+    if (!read)
+    {
+        result.error = "Unable to read " + compileCommands + ": " + error;
+        return result;
+    }
+    if (optionSets.empty())
+    {
+        result.error = "No translation units in " + compileCommands;
+        return result;
+    }
+
+    result.translationUnits = files.size();
+    result.optionSets = static_cast<int>(optionSets.size());
+
+    // Biggest option sets first onto the emptiest shard
+    shards = std::clamp(shards, 1, result.optionSets);
+    std::vector<int> order(optionSets.size());
+    for (size_t optionSet = 0; optionSet < order.size(); optionSet++)
+    {
+        order[optionSet] = static_cast<int>(optionSet);
+    }
+    std::stable_sort(order.begin(), order.end(), [&optionSets](int first, int second)
+    {
+        return optionSets[static_cast<size_t>(first)].files.size() > optionSets[static_cast<size_t>(second)].files.size();
+    });
+
+    std::vector<std::vector<int>> shardSets(static_cast<size_t>(shards));
+    std::vector<int> shardFiles(static_cast<size_t>(shards), 0);
+    for (auto const optionSet : order)
+    {
+        auto const shard = static_cast<size_t>(std::min_element(shardFiles.begin(), shardFiles.end()) - shardFiles.begin());
+        shardSets[shard].push_back(optionSet);
+        shardFiles[shard] += optionSets[static_cast<size_t>(optionSet)].files.size();
+    }
+
+    const QFileInfo lintFileInfo(lintFile);
+    removeStaleShards(lintFileInfo, shards);
+    for (int shard = 0; shard < shards; shard++)
+    {
+        auto const shardFile = (shards == 1) ? lintFile : lintFileInfo.dir().filePath(shardFileName(lintFileInfo, shard + 1));
+
+        QSaveFile output(shardFile);
+        if (!output.open(QIODevice::WriteOnly | QIODevice::Text))
+        {
+            result.error = "Unable to write " + shardFile + ": " + output.errorString();
+            return result;
+        }
+
+        QTextStream stream(&output);
+        stream << GENERATED_PREFIX << QDir::toNativeSeparators(compileCommands) << GENERATED_SUFFIX << '\n';
+        if (!baseLintFile.isEmpty())
+        {
+            stream << quoted(QDir::toNativeSeparators(baseLintFile)) << '\n';
+        }
+
+        for (auto const optionSet : shardSets[static_cast<size_t>(shard)])
+        {
+            auto const& options = optionSets[static_cast<size_t>(optionSet)];
+            stream << "\n-env_push\n";
+            for (auto const& include : options.includes)
+            {
+                stream << "-i" << quoted(QDir::toNativeSeparators(include)) << '\n';
+            }
+            for (auto const& define : options.defines)
+            {
+                stream << "-d" << (define.contains(' ') ? quoted(define) : define) << '\n';
+            }
+            for (auto const& undefine : options.undefines)
+            {
+                stream << "-u" << undefine << '\n';
+            }
+            for (auto const& file : options.files)
+            {
+                stream << quoted(QDir::toNativeSeparators(file)) << '\n';
+            }
+            stream << "-env_pop\n";
+        }
+
+        stream.flush();
+        if (!output.commit())
+        {
+            result.error = "Unable to write " + shardFile + ": " + output.errorString();
+            return result;
+        }
+        result.lintFiles << shardFile;
+    }
+
+    qInfo() << "Imported" << result.translationUnits << "translation units with" << result.optionSets << "option sets into"
+            << result.lintFiles.size() << "lint files in" << timer.elapsed() << "ms";
+    return result;
+}
+
+};
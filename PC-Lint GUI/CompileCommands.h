@@ -0,0 +1,64 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <functional>
+
+namespace Lint
+{
+
+// Translation unit of a compilation database with the options lint cares about
+struct CompileCommand
+{
+    QString file;          // Absolute path of the source file
+    QStringList includes;  // Absolute include directories in search order
+    QStringList defines;   // NAME or NAME=VALUE
+    QStringList undefines; // NAME
+};
+
+// Result of turning a compilation database into lint files
+struct CompileCommandsImport
+{
+    int translationUnits; // Unique source files
+    int optionSets;       // Groups of translation units with the same options
+    QStringList lintFiles;
+    QString error;        // Empty if it worked
+};
+
+// Split a shell command line into arguments
+// Quotes group and a backslash only escapes a quote so Windows paths survive
+QStringList splitCommandLine(const QString& command) noexcept;
+
+// Includes and defines of one compile command
+// Relative files and include directories are taken from the command's directory
+CompileCommand parseCompileArguments(const QString& directory, const QString& file, const QStringList& arguments) noexcept;
+
+// Read a compile_commands.json one entry at a time
+// The file is mapped and scanned once without building a JSON document so large databases
+// never need more memory than the entry being read
+bool readCompileCommands(const QString& file, const std::function<void(const CompileCommand&)>& callback, QString& error) noexcept;
+
+// Write lint files for a compilation database
+// Translation units with the same includes and defines share one -env_push scope so lint sets
+// up each option set once, with shards > 1 the scopes are spread over that many lint files
+// baseLintFile (the compiler and library configuration) is included at the top of each one
+CompileCommandsImport importCompileCommands(const QString& compileCommands, const QString& lintFile,
+                                            int shards, const QString& baseLintFile) noexcept;
+
+};
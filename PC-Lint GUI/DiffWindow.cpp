@@ -0,0 +1,150 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "DiffWindow.h"
+#include <QVBoxLayout>
+#include <QHeaderView>
+#include <QElapsedTimer>
+
+namespace Lint
+{
+
+DiffModel::DiffModel(std::shared_ptr<const LintMessages> messages, std::vector<int> rows, QObject* parent) :
+    QAbstractTableModel(parent),
+    m_messages(std::move(messages)),
+    m_rows(std::move(rows))
+{
+
+}
+
+int DiffModel::rowCount(const QModelIndex& parent) const noexcept
+{
+    return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
+}
+
+int DiffModel::columnCount(const QModelIndex& parent) const noexcept
+{
+    return parent.isValid() ? 0 : LINT_TABLE_LINE_COLUMN + 1;
+}
+
+QVariant DiffModel::data(const QModelIndex& index, int role) const noexcept
+{
+    if (!index.isValid() || role != Qt::DisplayRole)
+    {
+        return QVariant();
+    }
+
+    auto const& lintMessage = message(index.row());
+    switch (index.column())
+    {
+    case LINT_TABLE_FILE_COLUMN:
+        return lintMessage.file;
+    case LINT_TABLE_NUMBER_COLUMN:
+        return lintMessage.number;
+    case LINT_TABLE_DESCRIPTION_COLUMN:
+        return lintMessage.description;
+    case LINT_TABLE_LINE_COLUMN:
+        return lintMessage.line;
+    default:
+        return QVariant();
+    }
+}
+
+QVariant DiffModel::headerData(int section, Qt::Orientation orientation, int role) const noexcept
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+    {
+        return QVariant();
+    }
+
+    switch (section)
+    {
+    case LINT_TABLE_FILE_COLUMN:
+        return QStringLiteral("File");
+    case LINT_TABLE_NUMBER_COLUMN:
+        return QStringLiteral("Number");
+    case LINT_TABLE_DESCRIPTION_COLUMN:
+        return QStringLiteral("Description");
+    case LINT_TABLE_LINE_COLUMN:
+        return QStringLiteral("Line");
+    default:
+        return QVariant();
+    }
+}
+
+const LintMessage& DiffModel::message(int row) const noexcept
+{
+    return (*m_messages)[m_rows[row]];
+}
+
+DiffWindow::DiffWindow(QWidget* parent) :
+    QDialog(parent),
+    m_tabs(std::make_unique<QTabWidget>())
+{
+    setWindowTitle("Compare lint runs");
+    setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint);
+    resize(1000, 600);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addWidget(m_tabs.get());
+
+    for (auto& view : m_views)
+    {
+        view = std::make_unique<QTableView>();
+        view->setSelectionBehavior(QAbstractItemView::SelectRows);
+        view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        view->verticalHeader()->setVisible(false);
+        view->horizontalHeader()->setStretchLastSection(false);
+
+        QObject::connect(view.get(), &QTableView::doubleClicked, this, [this, &view](const QModelIndex& index)
+        {
+            auto const* model = static_cast<DiffModel*>(view->model());
+            auto const& message = model->message(index.row());
+            emit signalOpenMessage(message.file, message.line);
+        });
+    }
+
+    m_tabs->addTab(m_views[DIFF_NEW].get(), "New");
+    m_tabs->addTab(m_views[DIFF_FIXED].get(), "Fixed");
+    m_tabs->addTab(m_views[DIFF_UNCHANGED].get(), "Still present");
+}
+
+void DiffWindow::setRuns(const Snapshot& previous, const Snapshot& current, const QString& root) noexcept
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    auto const previousMessages = std::make_shared<const LintMessages>(previous.messages());
+    auto const currentMessages = std::make_shared<const LintMessages>(current.messages());
+    auto diff = diffRuns(*previousMessages, *currentMessages, root);
+
+    qInfo() << "Compared" << previousMessages->size() << "and" << currentMessages->size() << "messages in" << timer.elapsed() << "ms";
+
+    const char* const names[DIFF_BUCKET_COUNT] = {"New", "Fixed", "Still present"};
+    for (int bucket = 0; bucket < DIFF_BUCKET_COUNT; bucket++)
+    {
+        auto const& messages = (bucket == DIFF_FIXED) ? previousMessages : currentMessages;
+        auto const count = diff.buckets[bucket].size();
+
+        m_models[bucket] = std::make_unique<DiffModel>(messages, std::move(diff.buckets[bucket]));
+        m_views[bucket]->setModel(m_models[bucket].get());
+        m_views[bucket]->setColumnWidth(LINT_TABLE_FILE_COLUMN, 300);
+        m_views[bucket]->setColumnWidth(LINT_TABLE_DESCRIPTION_COLUMN, 500);
+        m_tabs->setTabText(bucket, QString("%1 (%2)").arg(names[bucket], QString::number(count)));
+    }
+}
+
+};
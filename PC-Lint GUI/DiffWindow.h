@@ -0,0 +1,69 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QDialog>
+#include <QAbstractTableModel>
+#include <QTabWidget>
+#include <QTableView>
+#include <memory>
+#include <array>
+#include "Snapshot.h"
+
+namespace Lint
+{
+
+// Flat list of the messages in one diff bucket
+// Rows are indexes into a run so nothing is copied
+class DiffModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    DiffModel(std::shared_ptr<const LintMessages> messages, std::vector<int> rows, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const noexcept override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const noexcept override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const noexcept override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const noexcept override;
+
+    const LintMessage& message(int row) const noexcept;
+
+private:
+    std::shared_ptr<const LintMessages> m_messages;
+    std::vector<int> m_rows;
+};
+
+// Shows what changed between two lint runs
+class DiffWindow : public QDialog
+{
+    Q_OBJECT
+public:
+    DiffWindow(QWidget* parent = nullptr);
+    // root is the lint file's directory, messages are matched by their path relative to it
+    void setRuns(const Snapshot& previous, const Snapshot& current, const QString& root) noexcept;
+
+signals:
+    // Open the file of a message in the editor
+    void signalOpenMessage(const QString& file, int line);
+
+private:
+    std::unique_ptr<QTabWidget> m_tabs;
+    std::array<std::unique_ptr<QTableView>, DIFF_BUCKET_COUNT> m_views;
+    std::array<std::unique_ptr<DiffModel>, DIFF_BUCKET_COUNT> m_models;
+};
+
+};
@@ -0,0 +1,704 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Distributed.h"
+#include "PCLintPlus.h"
+#include <QDataStream>
+#include <QDir>
+#include <QtEndian>
+#include <QThread>
+#include <QTimer>
+#include <QDebug>
+#include <algorithm>
+
+namespace Lint
+{
+
+namespace
+{
+    // Payload size and type
+    constexpr int FRAME_HEADER_SIZE = sizeof(quint32) + sizeof(quint8);
+    constexpr QDataStream::Version WORKER_STREAM_VERSION = QDataStream::Qt_5_14;
+
+    void sendFrame(QTcpSocket& socket, FrameType type, const QByteArray& payload) noexcept
+    {
+        socket.write(encodeFrame(type, payload));
+    }
+
+    // Every character is compared so the token can't be guessed a character at a time
+    bool sameToken(const QString& token1, const QString& token2) noexcept
+    {
+        QByteArray const bytes1 = token1.toUtf8();
+        QByteArray const bytes2 = token2.toUtf8();
+        if (bytes1.size() != bytes2.size())
+        {
+            return false;
+        }
+        int difference = 0;
+        for (int i = 0; i < bytes1.size(); i++)
+        {
+            difference |= bytes1.at(i) ^ bytes2.at(i);
+        }
+        return difference == 0;
+    }
+};
+
+QByteArray encodeFrame(FrameType type, const QByteArray& payload) noexcept
+{
+    QByteArray frame(FRAME_HEADER_SIZE, Qt::Uninitialized);
+    qToBigEndian<quint32>(static_cast<quint32>(payload.size()), frame.data());
+    frame[sizeof(quint32)] = static_cast<char>(type);
+    frame.append(payload);
+    return frame;
+}
+
+QByteArray encodeHello(const QString& token) noexcept
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(WORKER_STREAM_VERSION);
+    stream << WORKER_MAGIC << WORKER_VERSION << token;
+    return payload;
+}
+
+bool decodeHello(const QByteArray& payload, QString& token) noexcept
+{
+    QDataStream stream(payload);
+    stream.setVersion(WORKER_STREAM_VERSION);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if ((stream.status() != QDataStream::Ok) || (magic != WORKER_MAGIC) || (version != WORKER_VERSION))
+    {
+        return false;
+    }
+    stream >> token;
+    return (stream.status() == QDataStream::Ok) && stream.atEnd();
+}
+
+QByteArray encodeJob(const ShardJob& job) noexcept
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(WORKER_STREAM_VERSION);
+    stream << job.id << job.workingDirectory << job.lintFile << job.files << job.threads;
+    return payload;
+}
+
+bool decodeJob(const QByteArray& payload, ShardJob& job) noexcept
+{
+    QDataStream stream(payload);
+    stream.setVersion(WORKER_STREAM_VERSION);
+    stream >> job.id >> job.workingDirectory >> job.lintFile >> job.files >> job.threads;
+    return (stream.status() == QDataStream::Ok) && stream.atEnd();
+}
+
+QByteArray encodeResult(const ShardResult& result) noexcept
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(WORKER_STREAM_VERSION);
+    stream << result.id << result.exitCode << result.error;
+    return payload;
+}
+
+bool decodeResult(const QByteArray& payload, ShardResult& result) noexcept
+{
+    QDataStream stream(payload);
+    stream.setVersion(WORKER_STREAM_VERSION);
+    stream >> result.id >> result.exitCode >> result.error;
+    return (stream.status() == QDataStream::Ok) && stream.atEnd();
+}
+
+void FrameReader::append(const QByteArray& data) noexcept
+{
+    m_buffer.append(data);
+}
+
+bool FrameReader::next(Frame& frame) noexcept
+{
+    if (m_error || (m_buffer.size() < FRAME_HEADER_SIZE))
+    {
+        return false;
+    }
+
+    quint32 const size = qFromBigEndian<quint32>(m_buffer.constData());
+    quint8 const type = static_cast<quint8>(m_buffer.at(sizeof(quint32)));
+    if ((size > WORKER_MAX_FRAME) || (type > FRAME_DONE))
+    {
+        qCritical() << "Broken worker stream, frame type" << type << "size" << size;
+        m_error = true;
+        m_buffer.clear();
+        return false;
+    }
+
+    if (static_cast<quint32>(m_buffer.size() - FRAME_HEADER_SIZE) < size)
+    {
+        return false;
+    }
+
+    frame.type = static_cast<FrameType>(type);
+    frame.payload = m_buffer.mid(FRAME_HEADER_SIZE, static_cast<int>(size));
+    m_buffer.remove(0, FRAME_HEADER_SIZE + static_cast<int>(size));
+    return true;
+}
+
+bool FrameReader::hasError() const noexcept
+{
+    return m_error;
+}
+
+std::vector<QStringList> splitShards(const QStringList& modules, int shards) noexcept
+{
+    shards = std::max(1, std::min(shards, modules.size()));
+    std::vector<QStringList> split(static_cast<size_t>(shards));
+    // The first (size % shards) shards take one extra module
+    int const size = modules.size() / shards;
+    int const extra = modules.size() % shards;
+    int module = 0;
+    for (int shard = 0; shard < shards; shard++)
+    {
+        int const count = size + ((shard < extra) ? 1 : 0);
+        split[static_cast<size_t>(shard)] = modules.mid(module, count);
+        module += count;
+    }
+    return split;
+}
+
+QByteArray takeModules(QByteArray& buffer, bool shardComplete) noexcept
+{
+    // Banner before the first module isn't lint output
+    int const first = buffer.indexOf(DATA_MODULE_STRING);
+    if (first < 0)
+    {
+        if (shardComplete)
+        {
+            buffer.clear();
+        }
+        return {};
+    }
+
+    if (shardComplete)
+    {
+        int end = buffer.indexOf(Xml::XML_TAG_DOC_CLOSED, first);
+        if (end < 0)
+        {
+            end = buffer.size();
+        }
+        QByteArray const modules = buffer.mid(first, end - first);
+        buffer.clear();
+        return modules;
+    }
+
+    int const last = buffer.lastIndexOf(DATA_MODULE_STRING);
+    if (last == first)
+    {
+        return {};
+    }
+    QByteArray const modules = buffer.mid(first, last - first);
+    buffer.remove(0, last);
+    return modules;
+}
+
+bool isWholeProgramMessage(int number) noexcept
+{
+    static constexpr int wholeProgramMessages[] = { 714, 755, 756, 757, 758, 759, 765, 766, 768, 769, 1714 };
+    return std::find(std::begin(wholeProgramMessages), std::end(wholeProgramMessages), number) != std::end(wholeProgramMessages);
+}
+
+DistributedLint::DistributedLint(QObject* parent) :
+    QObject(parent),
+    m_remaining(0),
+    m_running(false)
+{
+}
+
+DistributedLint::~DistributedLint()
+{
+    closeConnections();
+}
+
+void DistributedLint::start(const QStringList& workers, const QString& token, std::vector<ShardJob> jobs) noexcept
+{
+    abort();
+    m_connections.clear();
+    m_token = token;
+    m_jobs = std::move(jobs);
+    m_pending.clear();
+    m_attempts.assign(m_jobs.size(), 0);
+    for (size_t job = 0; job < m_jobs.size(); job++)
+    {
+        m_pending.push_back(static_cast<int>(job));
+    }
+    m_remaining = static_cast<int>(m_jobs.size());
+    m_errors.clear();
+    m_running = true;
+
+    if (m_remaining == 0)
+    {
+        QTimer::singleShot(0, this, [this]
+        {
+            if (m_running)
+            {
+                finish({});
+            }
+        });
+        return;
+    }
+
+    for (const QString& worker : workers)
+    {
+        // host:port, host may be an IPv6 address
+        QString const address = worker.trimmed();
+        int const separator = address.lastIndexOf(':');
+        bool validPort = false;
+        quint16 const port = (separator > 0) ? address.mid(separator + 1).toUShort(&validPort) : 0;
+        if (!validPort)
+        {
+            qCritical() << "Lint worker" << address << "isn't host:port";
+            m_errors << address + ": Expected host:port";
+            continue;
+        }
+
+        auto connection = std::make_unique<Connection>();
+        connection->address = address;
+        connection->socket = std::make_unique<QTcpSocket>();
+        connection->ready = false;
+        connection->job = -1;
+        Connection* const link = connection.get();
+
+        QObject::connect(link->socket.get(), &QTcpSocket::connected, this, [this, link]
+        {
+            sendFrame(*link->socket, FRAME_HELLO, encodeHello(m_token));
+        });
+        QObject::connect(link->socket.get(), &QTcpSocket::readyRead, this, [this, link]
+        {
+            link->reader.append(link->socket->readAll());
+            readFrames(*link);
+        });
+        QObject::connect(link->socket.get(), QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error), this, [this, link]
+        {
+            connectionLost(*link, link->socket->errorString());
+        });
+        QObject::connect(link->socket.get(), &QTcpSocket::disconnected, this, [this, link]
+        {
+            connectionLost(*link, "Disconnected");
+        });
+        m_connections.emplace_back(std::move(connection));
+        link->socket->connectToHost(address.left(separator), port);
+    }
+
+    if (m_connections.empty())
+    {
+        // Report after start returns like any other connection failure
+        QTimer::singleShot(0, this, [this]
+        {
+            if (m_running)
+            {
+                finish("No lint workers\n" + m_errors.join('\n'));
+            }
+        });
+    }
+}
+
+void DistributedLint::abort() noexcept
+{
+    if (!m_running)
+    {
+        return;
+    }
+    finish("Lint aborted");
+}
+
+void DistributedLint::readFrames(Connection& connection) noexcept
+{
+    Frame frame;
+    while (m_running && connection.reader.next(frame))
+    {
+        if (frame.type == FRAME_HELLO)
+        {
+            // The worker only says hello once it has accepted the token
+            QString token;
+            if (connection.ready || !decodeHello(frame.payload, token))
+            {
+                connectionLost(connection, "Not a compatible lint worker");
+                return;
+            }
+            connection.ready = true;
+            dispatch(connection);
+        }
+        else if (!connection.ready || (connection.job < 0))
+        {
+            connectionLost(connection, "Unexpected frame");
+            return;
+        }
+        else if (frame.type == FRAME_OUTPUT)
+        {
+            connection.output.append(frame.payload);
+            QByteArray const modules = takeModules(connection.output, false);
+            if (!modules.isEmpty())
+            {
+                emit signalOutput(modules);
+            }
+        }
+        else if (frame.type == FRAME_PROGRESS)
+        {
+            emit signalProgress(frame.payload);
+        }
+        else if (frame.type == FRAME_DONE)
+        {
+            ShardResult result;
+            if (!decodeResult(frame.payload, result) || (result.id != m_jobs[static_cast<size_t>(connection.job)].id))
+            {
+                connectionLost(connection, "Unexpected shard result");
+                return;
+            }
+            if (!result.error.isEmpty())
+            {
+                // Lint failed on the shard, the worker itself is still fine
+                shardFailed(connection, result.error);
+                continue;
+            }
+
+            QByteArray const modules = takeModules(connection.output, true);
+            if (!modules.isEmpty())
+            {
+                emit signalOutput(modules);
+            }
+            connection.job = -1;
+            if (--m_remaining == 0)
+            {
+                finish({});
+                return;
+            }
+            dispatch(connection);
+        }
+        else
+        {
+            connectionLost(connection, "Unexpected frame");
+            return;
+        }
+    }
+
+    if (connection.reader.hasError())
+    {
+        connectionLost(connection, "Broken stream");
+    }
+}
+
+void DistributedLint::dispatch(Connection& connection) noexcept
+{
+    if (!connection.ready || (connection.job >= 0) || m_pending.empty())
+    {
+        return;
+    }
+    connection.job = m_pending.front();
+    m_pending.pop_front();
+    connection.output.clear();
+
+    const ShardJob& job = m_jobs[static_cast<size_t>(connection.job)];
+    qDebug() << "Shard" << job.id << "of" << job.files.size() << "modules to" << connection.address;
+    sendFrame(*connection.socket, FRAME_JOB, encodeJob(job));
+}
+
+void DistributedLint::shardFailed(Connection& connection, const QString& reason) noexcept
+{
+    auto const job = connection.job;
+    const ShardJob& shard = m_jobs[static_cast<size_t>(job)];
+    // The last module stopped part way, the ones before it were already forwarded
+    connection.output.clear();
+    connection.job = -1;
+
+    if (++m_attempts[static_cast<size_t>(job)] < WORKER_SHARD_ATTEMPTS)
+    {
+        qCritical() << "Shard" << shard.id << "failed on" << connection.address << "and is linted again:" << reason;
+        m_pending.push_back(job);
+    }
+    else
+    {
+        qCritical() << "Shard" << shard.id << "failed" << WORKER_SHARD_ATTEMPTS << "times, giving up:" << reason;
+        emit signalShardFailed(shard.id, reason);
+        if (--m_remaining == 0)
+        {
+            finish({});
+            return;
+        }
+    }
+
+    // Any idle worker can take the shard again
+    for (auto& other : m_connections)
+    {
+        dispatch(*other);
+    }
+}
+
+void DistributedLint::connectionLost(Connection& connection, const QString& reason) noexcept
+{
+    if (!m_running || !connection.socket)
+    {
+        return;
+    }
+
+    qCritical() << "Lint worker" << connection.address << "lost:" << reason;
+    m_errors << connection.address + ": " + reason;
+
+    // Modules already forwarded are linted again, the results are deduplicated downstream
+    if (connection.job >= 0)
+    {
+        m_pending.push_front(connection.job);
+        connection.job = -1;
+    }
+    connection.ready = false;
+    connection.socket->disconnect(this);
+    connection.socket->abort();
+    // Signals of the socket may still be on the stack
+    connection.socket.release()->deleteLater();
+
+    bool workersLeft = false;
+    for (auto& other : m_connections)
+    {
+        if (other->socket)
+        {
+            workersLeft = true;
+            dispatch(*other);
+        }
+    }
+
+    if (!workersLeft)
+    {
+        finish("No lint workers left\n" + m_errors.join('\n'));
+    }
+}
+
+void DistributedLint::finish(const QString& errorMessage) noexcept
+{
+    m_running = false;
+    closeConnections();
+    emit signalFinished(errorMessage);
+}
+
+void DistributedLint::closeConnections() noexcept
+{
+    for (auto& connection : m_connections)
+    {
+        connection->ready = false;
+        connection->job = -1;
+        if (connection->socket)
+        {
+            connection->socket->disconnect(this);
+            connection->socket->abort();
+            connection->socket.release()->deleteLater();
+        }
+    }
+    // The connections themselves stay until the next start as their socket lambdas may be on the stack
+}
+
+LintWorker::LintWorker(const QString& lintExecutable, const QString& token, QObject* parent) :
+    QObject(parent),
+    m_lintExecutable(lintExecutable),
+    m_token(token)
+{
+    Q_ASSERT(!m_token.isEmpty());
+    QObject::connect(&m_server, &QTcpServer::newConnection, this, &LintWorker::newConnection);
+}
+
+LintWorker::~LintWorker()
+{
+    for (auto& session : m_sessions)
+    {
+        if (session->socket)
+        {
+            session->socket->disconnect(this);
+        }
+        if (session->process)
+        {
+            session->process->disconnect(this);
+            session->process->kill();
+            session->process->waitForFinished();
+        }
+    }
+}
+
+bool LintWorker::listen(const QHostAddress& address, quint16 port, QString& error) noexcept
+{
+    if (!m_server.listen(address, port))
+    {
+        error = m_server.errorString();
+        return false;
+    }
+    return true;
+}
+
+quint16 LintWorker::port() const noexcept
+{
+    return m_server.serverPort();
+}
+
+void LintWorker::newConnection() noexcept
+{
+    while (QTcpSocket* socket = m_server.nextPendingConnection())
+    {
+        auto session = std::make_unique<Session>();
+        session->socket = socket;
+        session->greeted = false;
+        session->job = -1;
+        Session* const link = session.get();
+        m_sessions.emplace_back(std::move(session));
+
+        qInfo() << "Coordinator connected from" << socket->peerAddress().toString();
+        QObject::connect(socket, &QTcpSocket::readyRead, this, [this, link]
+        {
+            link->reader.append(link->socket->readAll());
+            readFrames(*link);
+        });
+        QObject::connect(socket, &QTcpSocket::disconnected, this, [this, link]
+        {
+            endSession(link);
+        });
+        // Nothing is sent until the coordinator has shown it has the token
+    }
+}
+
+void LintWorker::readFrames(Session& session) noexcept
+{
+    Frame frame;
+    while (session.reader.next(frame))
+    {
+        if ((frame.type == FRAME_HELLO) && !session.greeted)
+        {
+            QString token;
+            if (!decodeHello(frame.payload, token) || !sameToken(token, m_token))
+            {
+                qCritical() << "Coordinator from" << session.socket->peerAddress().toString() << "didn't send the worker token, closing the connection";
+                session.socket->abort();
+                return;
+            }
+            session.greeted = true;
+            sendFrame(*session.socket, FRAME_HELLO, encodeHello({}));
+            continue;
+        }
+
+        ShardJob job;
+        if (!session.greeted || (frame.type != FRAME_JOB) || (session.job >= 0) || !decodeJob(frame.payload, job))
+        {
+            qCritical() << "Unexpected frame from coordinator, closing the connection";
+            session.socket->abort();
+            return;
+        }
+        runJob(session, job);
+    }
+
+    if (session.reader.hasError())
+    {
+        session.socket->abort();
+    }
+}
+
+void LintWorker::runJob(Session& session, const ShardJob& job) noexcept
+{
+    session.job = job.id;
+    Session* const link = &session;
+    auto const fail = [link](const QString& error)
+    {
+        qCritical() << "Shard" << link->job << "failed:" << error;
+        sendFrame(*link->socket, FRAME_DONE, encodeResult({link->job, -1, error}));
+        link->job = -1;
+    };
+
+    // Lint resolves relative paths in the options from the working directory, not the lint file
+    session.lintFile = std::make_unique<QTemporaryFile>(QDir::temp().filePath("PC-Lint GUI Shard XXXXXX.lnt"));
+    if (!session.lintFile->open() || (session.lintFile->write(job.lintFile) != job.lintFile.size()) || !session.lintFile->flush())
+    {
+        fail("Unable to write the shard lint file: " + session.lintFile->errorString());
+        return;
+    }
+    session.lintFile->close();
+
+    if (!QDir(job.workingDirectory).exists())
+    {
+        fail("Working directory " + job.workingDirectory + " doesn't exist on this worker");
+        return;
+    }
+
+    // The coordinator's thread count may be more than this machine has
+    int const threads = std::clamp(job.threads, 1, std::max(1, QThread::idealThreadCount()));
+    qInfo() << "Linting shard" << job.id << "of" << job.files.size() << "modules with" << threads << "threads";
+    session.process = std::make_unique<QProcess>();
+    session.process->setWorkingDirectory(job.workingDirectory);
+    session.process->setProgram(m_lintExecutable);
+    // Only the lint file comes from the coordinator, the options are this worker's own
+    session.process->setArguments(QStringList{"-max_threads=" + QString::number(threads)} + lintOutputOptions() + QStringList{session.lintFile->fileName()});
+
+    QObject::connect(session.process.get(), &QProcess::readyReadStandardOutput, this, [link]
+    {
+        sendFrame(*link->socket, FRAME_OUTPUT, link->process->readAllStandardOutput());
+    });
+    QObject::connect(session.process.get(), &QProcess::readyReadStandardError, this, [link]
+    {
+        sendFrame(*link->socket, FRAME_PROGRESS, link->process->readAllStandardError());
+    });
+    QObject::connect(session.process.get(), &QProcess::errorOccurred, this, [fail, link](QProcess::ProcessError error)
+    {
+        // Every other error is followed by finished
+        if (error == QProcess::FailedToStart)
+        {
+            fail("Unable to run lint: " + link->process->errorString());
+        }
+    });
+    QObject::connect(session.process.get(), QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, [link](int exitCode, QProcess::ExitStatus exitStatus)
+    {
+        sendFrame(*link->socket, FRAME_OUTPUT, link->process->readAllStandardOutput());
+        sendFrame(*link->socket, FRAME_PROGRESS, link->process->readAllStandardError());
+        // Output of a crashed lint stops part way so the shard has to be linted again
+        if (exitStatus == QProcess::CrashExit)
+        {
+            qCritical() << "Shard" << link->job << "failed: lint crashed";
+            sendFrame(*link->socket, FRAME_DONE, encodeResult({link->job, -1, "Lint crashed"}));
+        }
+        else
+        {
+            sendFrame(*link->socket, FRAME_DONE, encodeResult({link->job, exitCode, {}}));
+            qInfo() << "Shard" << link->job << "complete, exit code" << exitCode;
+        }
+        link->job = -1;
+    });
+    session.process->start();
+}
+
+void LintWorker::endSession(Session* session) noexcept
+{
+    qInfo() << "Coordinator disconnected";
+    session->socket->disconnect(this);
+    session->socket->deleteLater();
+    session->socket = nullptr;
+    if (session->process)
+    {
+        session->process->disconnect(this);
+        session->process->kill();
+        session->process->waitForFinished();
+    }
+
+    // Called from the socket's signal, free the session after it returns
+    QTimer::singleShot(0, this, [this, session]
+    {
+        m_sessions.erase(std::remove_if(m_sessions.begin(), m_sessions.end(), [session](const std::unique_ptr<Session>& other)
+        {
+            return other.get() == session;
+        }), m_sessions.end());
+    });
+}
+
+};
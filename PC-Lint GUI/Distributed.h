@@ -0,0 +1,197 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QByteArray>
+#include <QHostAddress>
+#include <QObject>
+#include <QProcess>
+#include <QStringList>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryFile>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace Lint
+{
+
+// Worker protocol identification, sent by both sides before anything else
+constexpr quint32 WORKER_MAGIC = 0x50434C57; // "PCLW"
+constexpr quint32 WORKER_VERSION = 2;
+// Frames bigger than this mean the stream is broken
+constexpr quint32 WORKER_MAX_FRAME = 64 << 20;
+// Shards per worker so a slow worker doesn't hold up the end of the run
+constexpr int WORKER_SHARDS_PER_WORKER = 4;
+// Times a shard is linted before it's given up on when lint fails on it
+constexpr int WORKER_SHARD_ATTEMPTS = 3;
+
+// Every frame is a quint32 payload size and a quint8 type (big endian) followed by the payload
+enum FrameType : quint8
+{
+    FRAME_HELLO,    // Both ways: magic, version and token, the worker only answers a coordinator with its token
+    FRAME_JOB,      // Coordinator to worker: a ShardJob
+    FRAME_OUTPUT,   // Worker to coordinator: lint stdout (XML)
+    FRAME_PROGRESS, // Worker to coordinator: lint stderr (module progress)
+    FRAME_DONE      // Worker to coordinator: a ShardResult, the worker takes the next job after it
+};
+
+struct Frame
+{
+    FrameType type;
+    QByteArray payload;
+};
+
+// Part of a lint run handed to one worker
+struct ShardJob
+{
+    qint32 id;
+    QString workingDirectory; // Relative paths in the lint file start here
+    QByteArray lintFile;      // Options with only this shard's modules
+    QStringList files;        // Modules of the shard
+    qint32 threads;           // -max_threads
+};
+
+struct ShardResult
+{
+    qint32 id;
+    qint32 exitCode;
+    QString error; // Empty unless lint couldn't be run or crashed
+};
+
+QByteArray encodeFrame(FrameType type, const QByteArray& payload) noexcept;
+QByteArray encodeHello(const QString& token) noexcept;
+bool decodeHello(const QByteArray& payload, QString& token) noexcept;
+QByteArray encodeJob(const ShardJob& job) noexcept;
+bool decodeJob(const QByteArray& payload, ShardJob& job) noexcept;
+QByteArray encodeResult(const ShardResult& result) noexcept;
+bool decodeResult(const QByteArray& payload, ShardResult& result) noexcept;
+
+// Splits a byte stream back into frames
+class FrameReader
+{
+public:
+    void append(const QByteArray& data) noexcept;
+    // Next complete frame, false if there isn't one yet or the stream is broken
+    bool next(Frame& frame) noexcept;
+    bool hasError() const noexcept;
+
+private:
+    QByteArray m_buffer;
+    bool m_error = false;
+};
+
+// Modules dealt out to shards in order, neighbours stay together so -env_push scopes are rarely repeated
+std::vector<QStringList> splitShards(const QStringList& modules, int shards) noexcept;
+
+// Take the complete modules at the front of a worker's output, the rest stays in buffer
+// A module is complete once the next one starts, at the end of the shard everything up to </doc> is
+QByteArray takeModules(QByteArray& buffer, bool shardComplete) noexcept;
+
+// Messages from lint's whole-program pass (unused headers, symbols, macros, ...)
+// A shard only sees its own modules so they can be false positives when linting on workers
+bool isWholeProgramMessage(int number) noexcept;
+
+// Hands shard jobs to workers and streams back their modules
+// Each connection takes the next job when it's done with one, the jobs of a lost worker go to the others
+// A shard lint fails on is tried again a few times, the worker keeps its connection
+class DistributedLint : public QObject
+{
+    Q_OBJECT
+public:
+    DistributedLint(QObject* parent = nullptr);
+    ~DistributedLint();
+
+    // workers are "host:port", token is the one they were started with
+    void start(const QStringList& workers, const QString& token, std::vector<ShardJob> jobs) noexcept;
+    void abort() noexcept;
+
+signals:
+    // Whole modules of lint output, ready for the stitcher
+    void signalOutput(const QByteArray& modules);
+    void signalProgress(const QByteArray& progress);
+    // Lint failed on the shard every time, its modules are missing from the output
+    void signalShardFailed(qint32 id, const QString& errorMessage);
+    // Empty error unless the workers couldn't be used, failed shards are reported on their own
+    void signalFinished(const QString& errorMessage);
+
+private:
+    struct Connection
+    {
+        QString address;
+        std::unique_ptr<QTcpSocket> socket;
+        FrameReader reader;
+        bool ready;       // Said hello and is still there
+        int job;          // Index into m_jobs, -1 when idle
+        QByteArray output;
+    };
+
+    void readFrames(Connection& connection) noexcept;
+    void dispatch(Connection& connection) noexcept;
+    void shardFailed(Connection& connection, const QString& reason) noexcept;
+    void connectionLost(Connection& connection, const QString& reason) noexcept;
+    void finish(const QString& errorMessage) noexcept;
+    void closeConnections() noexcept;
+
+    std::vector<std::unique_ptr<Connection>> m_connections;
+    QString m_token;
+    std::vector<ShardJob> m_jobs;
+    std::deque<int> m_pending;
+    std::vector<int> m_attempts; // Failed runs of each job
+    int m_remaining;
+    bool m_running;
+    QStringList m_errors;
+};
+
+// Lints the shard jobs of coordinators that connect to it
+// Each connection runs one job at a time, coordinators open more connections for more
+// Coordinators have to send the worker's token, jobs run with the worker's own lint options
+class LintWorker : public QObject
+{
+    Q_OBJECT
+public:
+    LintWorker(const QString& lintExecutable, const QString& token, QObject* parent = nullptr);
+    ~LintWorker();
+
+    // Only reachable from this machine unless another address is given
+    bool listen(const QHostAddress& address, quint16 port, QString& error) noexcept;
+    quint16 port() const noexcept;
+
+private:
+    struct Session
+    {
+        QTcpSocket* socket; // Owned by the server
+        FrameReader reader;
+        bool greeted;
+        qint32 job;
+        std::unique_ptr<QProcess> process;
+        std::unique_ptr<QTemporaryFile> lintFile;
+    };
+
+    void newConnection() noexcept;
+    void readFrames(Session& session) noexcept;
+    void runJob(Session& session, const ShardJob& job) noexcept;
+    void endSession(Session* session) noexcept;
+
+    QString m_lintExecutable;
+    QString m_token;
+    QTcpServer m_server;
+    std::vector<std::unique_ptr<Session>> m_sessions;
+};
+
+};
@@ -0,0 +1,210 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "DocumentCache.h"
+#include "Highlighter.h"
+#include "CodeEditor.h"
+#include <QPlainTextDocumentLayout>
+#include <QFileInfo>
+#include <QFile>
+#include <QTextStream>
+#include <QtConcurrent>
+#include <QDebug>
+#include <algorithm>
+
+namespace Lint
+{
+
+DocumentCache::DocumentCache(QObject* parent) :
+    QObject(parent),
+    m_clock(0)
+{
+
+}
+
+DocumentCache::~DocumentCache()
+{
+    // Prefetches post back to this object
+    for (auto& prefetch : m_prefetches)
+    {
+        prefetch.waitForFinished();
+    }
+}
+
+std::unique_ptr<QTextDocument> DocumentCache::createDocument() noexcept
+{
+    auto document = std::make_unique<QTextDocument>();
+    document->setDocumentLayout(new QPlainTextDocumentLayout(document.get()));
+    return document;
+}
+
+bool DocumentCache::readFile(const QString& file, QString& text, QDateTime& lastModified) noexcept
+{
+    QFile input(file);
+    if (!input.open(QIODevice::ReadOnly | QFile::Text))
+    {
+        return false;
+    }
+
+    lastModified = QFileInfo(input).lastModified();
+    QTextStream in(&input);
+    text = in.readAll();
+    return true;
+}
+
+DocumentCache::Entry* DocumentCache::find(const QString& file) noexcept
+{
+    auto const entry = std::find_if(m_entries.begin(), m_entries.end(), [&file](const Entry& entry)
+    {
+        return entry.file == file;
+    });
+    return (entry != m_entries.end()) ? &(*entry) : nullptr;
+}
+
+DocumentCache::Entry& DocumentCache::insert(const QString& file, const QString& text, const QDateTime& lastModified) noexcept
+{
+    evict();
+
+    Entry entry{file, createDocument(), lastModified, ++m_clock};
+    entry.document->setPlainText(text);
+    entry.document->setModified(false);
+    // Owned by the document it highlights
+    new Highlighter(entry.document.get(), dialectForFile(file));
+
+    m_entries.emplace_back(std::move(entry));
+    return m_entries.back();
+}
+
+void DocumentCache::evict() noexcept
+{
+    while (static_cast<int>(m_entries.size()) >= DOCUMENT_CACHE_SIZE)
+    {
+        // Least recently used document that isn't shown and has no unsaved changes
+        auto oldest = m_entries.end();
+        for (auto entry = m_entries.begin(); entry != m_entries.end(); ++entry)
+        {
+            if ((entry->file != m_current) && !entry->document->isModified() &&
+                ((oldest == m_entries.end()) || (entry->lastUsed < oldest->lastUsed)))
+            {
+                oldest = entry;
+            }
+        }
+
+        if (oldest == m_entries.end())
+        {
+            // Everything is pinned, let the cache grow
+            return;
+        }
+        m_entries.erase(oldest);
+    }
+}
+
+QTextDocument* DocumentCache::document(const QString& file) noexcept
+{
+    auto entry = find(file);
+
+    // Pick up changes made outside the editor unless there are unsaved edits
+    if (entry && !entry->document->isModified() && (QFileInfo(file).lastModified() != entry->lastModified))
+    {
+        qInfo() << file << "changed on disk, reloading";
+        remove(file);
+        entry = nullptr;
+    }
+
+    if (!entry)
+    {
+        QString text;
+        QDateTime lastModified;
+        if (!readFile(file, text, lastModified))
+        {
+            return nullptr;
+        }
+        entry = &insert(file, text, lastModified);
+    }
+
+    entry->lastUsed = ++m_clock;
+    m_current = file;
+    return entry->document.get();
+}
+
+void DocumentCache::prefetch(const QString& file) noexcept
+{
+    if (file.isEmpty() || find(file) || m_pending.contains(file))
+    {
+        return;
+    }
+
+    // Large files are never cached
+    if (QFileInfo(file).size() > LARGE_FILE_THRESHOLD)
+    {
+        return;
+    }
+
+    // Only the prefetches still running need to be kept for the destructor
+    m_prefetches.erase(std::remove_if(m_prefetches.begin(), m_prefetches.end(), [](const QFuture<void>& prefetch)
+    {
+        return prefetch.isFinished();
+    }), m_prefetches.end());
+
+    m_pending.insert(file);
+    m_prefetches.append(QtConcurrent::run([this, file]()
+    {
+        QString text;
+        QDateTime lastModified;
+        auto const success = readFile(file, text, lastModified);
+
+        // Documents can only be built on the GUI thread
+        QMetaObject::invokeMethod(this, [this, file, text, lastModified, success]()
+        {
+            m_pending.remove(file);
+            if (success && !find(file))
+            {
+                // Prefetched files are the first to go if nobody looks at them
+                insert(file, text, lastModified).lastUsed = 0;
+            }
+        }, Qt::QueuedConnection);
+    }));
+}
+
+void DocumentCache::remove(const QString& file) noexcept
+{
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), [&file](const Entry& entry)
+    {
+        return entry.file == file;
+    }), m_entries.end());
+
+    if (m_current == file)
+    {
+        m_current.clear();
+    }
+}
+
+void DocumentCache::markSaved(const QString& file) noexcept
+{
+    if (auto const entry = find(file))
+    {
+        entry->document->setModified(false);
+        entry->lastModified = QFileInfo(file).lastModified();
+    }
+}
+
+bool DocumentCache::isModified(const QString& file) noexcept
+{
+    auto const entry = find(file);
+    return entry && entry->document->isModified();
+}
+
+};
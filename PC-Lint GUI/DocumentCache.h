@@ -0,0 +1,87 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QSet>
+#include <QDateTime>
+#include <QTextDocument>
+#include <QFuture>
+#include <memory>
+#include <vector>
+
+namespace Lint
+{
+
+// Number of documents kept loaded and highlighted
+constexpr int DOCUMENT_CACHE_SIZE = 16;
+// Other files prefetched in each direction from a selected message
+constexpr int DOCUMENT_PREFETCH_FILES = 2;
+// Tree rows looked at in each direction to find them
+constexpr int DOCUMENT_PREFETCH_SEARCH = 256;
+
+// Bounded LRU cache of loaded and highlighted source files
+// Switching back to a cached file costs nothing instead of a disk read and a full highlighting pass
+class DocumentCache : public QObject
+{
+    Q_OBJECT
+public:
+    DocumentCache(QObject* parent = nullptr);
+    ~DocumentCache();
+
+    // Loaded and highlighted document for the file, nullptr if it can't be read
+    // The document stays valid until it is evicted or removed
+    QTextDocument* document(const QString& file) noexcept;
+    // Read the file in the background so a later document() call doesn't touch the disk
+    void prefetch(const QString& file) noexcept;
+    // Drop the file, unsaved changes included
+    void remove(const QString& file) noexcept;
+    // The file has been written out from its document
+    void markSaved(const QString& file) noexcept;
+    // Whether the cached document has unsaved changes
+    bool isModified(const QString& file) noexcept;
+
+    // Empty document that can be shown by a QPlainTextEdit
+    static std::unique_ptr<QTextDocument> createDocument() noexcept;
+    // Whole text of a file and its modification time
+    static bool readFile(const QString& file, QString& text, QDateTime& lastModified) noexcept;
+
+private:
+    struct Entry
+    {
+        QString file;
+        std::unique_ptr<QTextDocument> document;
+        QDateTime lastModified; // Of the file when it was read
+        quint64 lastUsed;       // LRU stamp
+    };
+
+    Entry* find(const QString& file) noexcept;
+    Entry& insert(const QString& file, const QString& text, const QDateTime& lastModified) noexcept;
+    void evict() noexcept;
+
+    std::vector<Entry> m_entries;
+    quint64 m_clock;
+    // Most recently returned by document() so never evicted
+    QString m_current;
+
+    // Files being read in the background
+    QSet<QString> m_pending;
+    QList<QFuture<void>> m_prefetches;
+};
+
+};
@@ -0,0 +1,307 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Export.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QUrl>
+#include <QDebug>
+
+namespace Lint
+{
+
+namespace
+{
+    const QByteArray CSV_HEADER = "File,Line,Type,Number,Description\r\n";
+
+    const QByteArray SARIF_HEADER =
+        "{\"$schema\":\"https://json.schemastore.org/sarif-2.1.0.json\",\"version\":\"2.1.0\",\"runs\":[{"
+        "\"tool\":{\"driver\":{\"name\":\"PC-Lint Plus\",\"informationUri\":\"https://pclintplus.com\"}},"
+        "\"results\":[\n";
+    const QByteArray SARIF_FOOTER = "\n]}]}\n";
+
+    // SARIF only knows error, warning and note
+    QByteArray sarifLevel(const QString& type) noexcept
+    {
+        if (type == Type::TYPE_ERROR)
+        {
+            return "error";
+        }
+        if (type == Type::TYPE_WARNING)
+        {
+            return "warning";
+        }
+        return "note";
+    }
+};
+
+bool exportFormatForFile(const QString& file, ExportFormat& format) noexcept
+{
+    auto const suffix = QFileInfo(file).suffix().toLower();
+    if (suffix == "csv")
+    {
+        format = EXPORT_CSV;
+    }
+    else if ((suffix == "jsonl") || (suffix == "ndjson"))
+    {
+        format = EXPORT_JSON_LINES;
+    }
+    else if ((suffix == "sarif") || file.endsWith(".sarif.json", Qt::CaseInsensitive))
+    {
+        format = EXPORT_SARIF;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+ResultExporter::ResultExporter(QIODevice& device, ExportFormat format) noexcept :
+    m_device(device),
+    m_format(format),
+    m_results(0),
+    m_failed(false)
+{
+    m_buffer.reserve(EXPORT_BUFFER_SIZE + EXPORT_BUFFER_SIZE / 4);
+    if (m_format == EXPORT_CSV)
+    {
+        m_buffer += CSV_HEADER;
+    }
+    else if (m_format == EXPORT_SARIF)
+    {
+        m_buffer += SARIF_HEADER;
+    }
+}
+
+void ResultExporter::write(const LintMessage& message) noexcept
+{
+    // CSV rows don't depend on each other, the others need the whole group
+    if (m_format == EXPORT_CSV)
+    {
+        m_results += (message.type != Type::TYPE_SUPPLEMENTAL) ? 1 : 0;
+        writeCsv(message);
+        flush(false);
+        return;
+    }
+
+    if ((message.type != Type::TYPE_SUPPLEMENTAL) && !m_group.empty())
+    {
+        writeGroup();
+    }
+    m_group.push_back(message);
+}
+
+bool ResultExporter::finish() noexcept
+{
+    if (!m_group.empty())
+    {
+        writeGroup();
+    }
+    if (m_format == EXPORT_SARIF)
+    {
+        m_buffer += SARIF_FOOTER;
+    }
+    flush(true);
+    return !m_failed;
+}
+
+qint64 ResultExporter::resultCount() const noexcept
+{
+    return m_results;
+}
+
+void ResultExporter::writeGroup() noexcept
+{
+    // Supplementals without a message (results starting mid group) are written on their own
+    auto const& message = m_group.front();
+
+    if (m_format == EXPORT_JSON_LINES)
+    {
+        m_buffer += '{';
+        writeJsonMessage(message);
+        if (m_group.size() > 1)
+        {
+            m_buffer += ",\"supplemental\":[";
+            for (size_t supplemental = 1; supplemental < m_group.size(); supplemental++)
+            {
+                m_buffer += (supplemental > 1) ? ",{" : "{";
+                writeJsonMessage(m_group[supplemental]);
+                m_buffer += '}';
+            }
+            m_buffer += ']';
+        }
+        m_buffer += "}\n";
+    }
+    else
+    {
+        m_buffer += (m_results > 0) ? ",\n{\"ruleId\":\"" : "{\"ruleId\":\"";
+        m_buffer += QByteArray::number(message.number);
+        m_buffer += "\",\"level\":\"" + sarifLevel(message.type) + "\",\"message\":{\"text\":";
+        appendJson(message.description);
+        m_buffer += "},\"locations\":[{";
+        writeSarifLocation(message);
+        m_buffer += "}]";
+        if (m_group.size() > 1)
+        {
+            m_buffer += ",\"relatedLocations\":[";
+            for (size_t supplemental = 1; supplemental < m_group.size(); supplemental++)
+            {
+                m_buffer += (supplemental > 1) ? ",{\"id\":" : "{\"id\":";
+                m_buffer += QByteArray::number(static_cast<qulonglong>(supplemental - 1));
+                m_buffer += ",\"message\":{\"text\":";
+                appendJson(m_group[supplemental].description);
+                m_buffer += "},";
+                writeSarifLocation(m_group[supplemental]);
+                m_buffer += '}';
+            }
+            m_buffer += ']';
+        }
+        m_buffer += '}';
+    }
+
+    m_results++;
+    m_group.clear();
+    flush(false);
+}
+
+void ResultExporter::writeCsv(const LintMessage& message) noexcept
+{
+    appendCsv(message.file);
+    m_buffer += ',';
+    m_buffer += QByteArray::number(message.line);
+    m_buffer += ',';
+    appendCsv(message.type);
+    m_buffer += ',';
+    m_buffer += QByteArray::number(message.number);
+    m_buffer += ',';
+    appendCsv(message.description);
+    m_buffer += "\r\n";
+}
+
+void ResultExporter::writeJsonMessage(const LintMessage& message) noexcept
+{
+    m_buffer += "\"file\":";
+    appendJson(message.file);
+    m_buffer += ",\"line\":";
+    m_buffer += QByteArray::number(message.line);
+    m_buffer += ",\"type\":";
+    appendJson(message.type);
+    m_buffer += ",\"number\":";
+    m_buffer += QByteArray::number(message.number);
+    m_buffer += ",\"description\":";
+    appendJson(message.description);
+}
+
+void ResultExporter::writeSarifLocation(const LintMessage& message) noexcept
+{
+    // Messages without a file (lint configuration problems) only have a line at best
+    m_buffer += "\"physicalLocation\":{";
+    if (!message.file.isEmpty())
+    {
+        m_buffer += "\"artifactLocation\":{\"uri\":";
+        auto const file = QDir::fromNativeSeparators(message.file);
+        appendJson(QDir::isAbsolutePath(file) ? QString::fromUtf8(QUrl::fromLocalFile(file).toEncoded()) : file);
+        m_buffer += '}';
+        if (message.line > 0)
+        {
+            m_buffer += ',';
+        }
+    }
+    if (message.line > 0)
+    {
+        m_buffer += "\"region\":{\"startLine\":" + QByteArray::number(message.line) + '}';
+    }
+    m_buffer += '}';
+}
+
+void ResultExporter::appendCsv(const QString& text) noexcept
+{
+    auto const utf8 = text.toUtf8();
+    if ((utf8.indexOf(',') < 0) && (utf8.indexOf('"') < 0) && (utf8.indexOf('\n') < 0) && (utf8.indexOf('\r') < 0))
+    {
+        m_buffer += utf8;
+        return;
+    }
+
+    m_buffer += '"';
+    for (auto const character : utf8)
+    {
+        if (character == '"')
+        {
+            m_buffer += '"';
+        }
+        m_buffer += character;
+    }
+    m_buffer += '"';
+}
+
+void ResultExporter::appendJson(const QString& text) noexcept
+{
+    static const char hex[] = "0123456789abcdef";
+
+    m_buffer += '"';
+    for (auto const character : text.toUtf8())
+    {
+        auto const byte = static_cast<unsigned char>(character);
+        if ((character == '"') || (character == '\\'))
+        {
+            m_buffer += '\\';
+            m_buffer += character;
+        }
+        else if (character == '\n')
+        {
+            m_buffer += "\\n";
+        }
+        else if (character == '\r')
+        {
+            m_buffer += "\\r";
+        }
+        else if (character == '\t')
+        {
+            m_buffer += "\\t";
+        }
+        else if (byte < 0x20)
+        {
+            m_buffer += "\\u00";
+            m_buffer += hex[byte >> 4];
+            m_buffer += hex[byte & 0xF];
+        }
+        else
+        {
+            m_buffer += character;
+        }
+    }
+    m_buffer += '"';
+}
+
+void ResultExporter::flush(bool force) noexcept
+{
+    if (m_buffer.isEmpty() || (!force && (m_buffer.size() < EXPORT_BUFFER_SIZE)))
+    {
+        return;
+    }
+
+    if (!m_failed && (m_device.write(m_buffer) != m_buffer.size()))
+    {
+        qCritical() << "Export failed:" << m_device.errorString();
+        m_failed = true;
+    }
+    // Keeps its capacity so the buffer is only ever allocated once
+    m_buffer.resize(0);
+}
+
+};
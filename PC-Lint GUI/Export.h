@@ -0,0 +1,72 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QString>
+#include "PCLintPlus.h"
+
+namespace Lint
+{
+
+// Output is handed to the device in blocks of this size
+constexpr int EXPORT_BUFFER_SIZE = 1 << 20;
+
+enum ExportFormat
+{
+    EXPORT_CSV,        // One row per message, supplementals follow their message
+    EXPORT_JSON_LINES, // One object per message with its supplementals nested in it
+    EXPORT_SARIF       // SARIF 2.1.0, supplementals are related locations
+};
+
+// Format for a file name (.csv, .jsonl or .sarif), false if the extension isn't known
+bool exportFormatForFile(const QString& file, ExportFormat& format) noexcept;
+
+// Streams lint messages to a device in one of the export formats
+// Only the message being written and its supplementals are held in memory,
+// everything else goes through a fixed size buffer straight to the device
+class ResultExporter
+{
+public:
+    ResultExporter(QIODevice& device, ExportFormat format) noexcept;
+
+    // Messages in lint order, supplementals right after the message they belong to
+    void write(const LintMessage& message) noexcept;
+    // Write out the rest, false if the device failed along the way
+    bool finish() noexcept;
+    // Top-level messages written so far
+    qint64 resultCount() const noexcept;
+
+private:
+    void writeGroup() noexcept;
+    void writeCsv(const LintMessage& message) noexcept;
+    void writeJsonMessage(const LintMessage& message) noexcept;
+    void writeSarifLocation(const LintMessage& message) noexcept;
+    void appendCsv(const QString& text) noexcept;
+    void appendJson(const QString& text) noexcept;
+    void flush(bool force) noexcept;
+
+    QIODevice& m_device;
+    ExportFormat m_format;
+    QByteArray m_buffer;
+    LintMessages m_group;
+    qint64 m_results;
+    bool m_failed;
+};
+
+};
@@ -0,0 +1,146 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "FileWatcher.h"
+#include <QFileInfo>
+#include <QDebug>
+
+namespace Lint
+{
+
+FileWatcher::FileWatcher(QObject* parent) :
+    QObject(parent)
+{
+    m_debounce.setSingleShot(true);
+    m_debounce.setInterval(FILE_WATCH_DEBOUNCE);
+
+    QObject::connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, &FileWatcher::slotFileChanged);
+    QObject::connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &FileWatcher::slotDirectoryChanged);
+    QObject::connect(&m_debounce, &QTimer::timeout, this, &FileWatcher::slotDebounced);
+}
+
+void FileWatcher::addFiles(const QStringList& files) noexcept
+{
+    QStringList newFiles;
+    QStringList newDirectories;
+
+    for (auto const& file : files)
+    {
+        if (file.isEmpty() || m_stamps.contains(file))
+        {
+            continue;
+        }
+
+        const QFileInfo fileInfo(file);
+        if (!fileInfo.exists())
+        {
+            continue;
+        }
+
+        m_stamps.insert(file, fileInfo.lastModified());
+        m_watched.insert(file);
+        newFiles << file;
+
+        auto const directory = fileInfo.absolutePath();
+        if (!m_directories.contains(directory))
+        {
+            newDirectories << directory;
+        }
+        m_directories[directory] << file;
+    }
+
+    // Adding paths one at a time is slow on some platforms
+    if (!newFiles.isEmpty())
+    {
+        m_watcher.addPaths(newFiles);
+    }
+    if (!newDirectories.isEmpty())
+    {
+        m_watcher.addPaths(newDirectories);
+    }
+
+    qDebug() << "Watching" << m_stamps.size() << "files in" << m_directories.size() << "directories";
+}
+
+void FileWatcher::clear() noexcept
+{
+    auto const paths = m_watcher.files() + m_watcher.directories();
+    if (!paths.isEmpty())
+    {
+        m_watcher.removePaths(paths);
+    }
+    m_stamps.clear();
+    m_directories.clear();
+    m_watched.clear();
+    m_changed.clear();
+    m_debounce.stop();
+}
+
+void FileWatcher::checkFile(const QString& file) noexcept
+{
+    const QFileInfo fileInfo(file);
+    if (!fileInfo.exists())
+    {
+        // Probably being replaced, the directory watch sees it come back
+        m_watched.remove(file);
+        return;
+    }
+
+    auto const lastModified = fileInfo.lastModified();
+    auto& stamp = m_stamps[file];
+    if (stamp != lastModified)
+    {
+        stamp = lastModified;
+        m_changed.insert(file);
+        m_debounce.start();
+    }
+
+    // Replacing a file drops its watch
+    if (!m_watched.contains(file))
+    {
+        m_watched.insert(file);
+        m_watcher.addPath(file);
+    }
+}
+
+void FileWatcher::slotFileChanged(const QString& file) noexcept
+{
+    checkFile(file);
+}
+
+void FileWatcher::slotDirectoryChanged(const QString& directory) noexcept
+{
+    for (auto const& file : m_directories.value(directory))
+    {
+        checkFile(file);
+    }
+}
+
+void FileWatcher::slotDebounced() noexcept
+{
+    if (m_changed.isEmpty())
+    {
+        return;
+    }
+
+    QStringList files(m_changed.cbegin(), m_changed.cend());
+    m_changed.clear();
+
+    qInfo() << files.size() << "watched files changed";
+    emit signalFilesChanged(files);
+}
+
+};
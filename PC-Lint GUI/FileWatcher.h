@@ -0,0 +1,70 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QObject>
+#include <QFileSystemWatcher>
+#include <QStringList>
+#include <QDateTime>
+#include <QHash>
+#include <QSet>
+#include <QTimer>
+
+namespace Lint
+{
+
+// Changes are reported once files have been quiet for this long (ms)
+constexpr int FILE_WATCH_DEBOUNCE = 500;
+
+// Watches a set of files and reports the ones that changed
+// Editors that save by replacing the file are handled through the directory watches
+// Bursts of changes (a save, a branch checkout) are coalesced into one signal
+class FileWatcher : public QObject
+{
+    Q_OBJECT
+public:
+    FileWatcher(QObject* parent = nullptr);
+
+    // Start watching these files as they are now
+    void addFiles(const QStringList& files) noexcept;
+    // Stop watching everything
+    void clear() noexcept;
+
+signals:
+    void signalFilesChanged(const QStringList& files);
+
+private slots:
+    void slotFileChanged(const QString& file) noexcept;
+    void slotDirectoryChanged(const QString& directory) noexcept;
+    void slotDebounced() noexcept;
+
+private:
+    void checkFile(const QString& file) noexcept;
+
+    QFileSystemWatcher m_watcher;
+    // File -> last modified time when last seen
+    QHash<QString, QDateTime> m_stamps;
+    // Directory -> watched files in it
+    QHash<QString, QStringList> m_directories;
+    // Files with a watch on them right now
+    QSet<QString> m_watched;
+    // Changed since the last signal
+    QSet<QString> m_changed;
+    QTimer m_debounce;
+};
+
+};
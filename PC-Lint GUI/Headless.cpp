@@ -0,0 +1,98 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Headless.h"
+#include "Export.h"
+#include "PCLintPlus.h"
+#include "Preferences.h"
+#include <QEventLoop>
+#include <QSaveFile>
+#include <QThread>
+#include <QDebug>
+#include <algorithm>
+
+namespace Lint
+{
+
+int lintHeadless(const QString& exportFile, const QString& lintExecutable, const QString& lintFile, const QStringList& workers, const QString& workerToken) noexcept
+{
+    ExportFormat format;
+    if (!exportFormatForFile(exportFile, format))
+    {
+        qCritical() << "Unknown export format, use .csv, .jsonl or .sarif:" << exportFile;
+        return 2;
+    }
+
+    auto const settings = readSettings();
+    PCLintPlus lint(lintExecutable.isEmpty() ? settings.lintExecutable : lintExecutable,
+                    lintFile.isEmpty() ? settings.lintFile : lintFile);
+    // Nothing saved yet reads as 0 threads
+    lint.setHardwareThreads((settings.maxThreads > 0) ? settings.maxThreads : std::max(1, QThread::idealThreadCount()));
+    // Nothing to keep responsive, messages go out as fast as they're parsed
+    lint.setThrottle(false);
+    lint.setWorkers(workers.isEmpty() ? settings.workers : workers, workerToken.isEmpty() ? settings.workerToken : workerToken);
+
+    QSaveFile output(exportFile);
+    if (!output.open(QIODevice::WriteOnly))
+    {
+        qCritical() << "Unable to open" << exportFile << output.errorString();
+        return 2;
+    }
+
+    // Messages go straight to the file as they arrive
+    ResultExporter exporter(output, format);
+    int problems = 0;
+    auto const addMessage = [&exporter, &problems](const LintMessage& message)
+    {
+        problems += ((message.type == Type::TYPE_ERROR) || (message.type == Type::TYPE_WARNING)) ? 1 : 0;
+        exporter.write(message);
+    };
+    QObject::connect(&lint, &PCLintPlus::signalAddTreeParent, addMessage);
+    QObject::connect(&lint, &PCLintPlus::signalAddTreeChild, addMessage);
+
+    // The exporter runs on the consumer thread as addMessage has no context object
+    // That's safe as completion is only signalled once lint has joined the consumer thread
+    QEventLoop loop;
+    Status status = Status::STATUS_COMPLETE;
+    QString errorMessage;
+    QObject::connect(&lint, &PCLintPlus::signalLintComplete, &loop, [&](const Status& lintStatus, const QString& lintError)
+    {
+        status = lintStatus;
+        errorMessage = lintError;
+        loop.quit();
+    }, Qt::QueuedConnection);
+
+    qInfo() << "Linting" << lint.getLintFile() << "to" << exportFile;
+    lint.lint();
+    loop.exec();
+
+    if ((status != Status::STATUS_COMPLETE) && (status != Status::STATUS_PARTIAL_COMPLETE))
+    {
+        qCritical() << "Lint failed:" << status << errorMessage;
+        return 2;
+    }
+
+    if (!exporter.finish() || !output.commit())
+    {
+        qCritical() << "Unable to write" << exportFile << output.errorString();
+        return 2;
+    }
+
+    qInfo() << "Exported" << exporter.resultCount() << "messages to" << exportFile;
+    return (problems > 0) ? 1 : 0;
+}
+
+};
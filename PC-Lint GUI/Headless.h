@@ -0,0 +1,30 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+namespace Lint
+{
+
+// Lint without showing any windows and stream the results to a file
+// Empty executable, lint file, workers or worker token fall back to the saved settings
+// Returns the process exit code: 0 if there were no errors or warnings, 1 if there were, 2 if it failed
+int lintHeadless(const QString& exportFile, const QString& lintExecutable, const QString& lintFile, const QStringList& workers, const QString& workerToken) noexcept;
+
+};
@@ -15,123 +15,158 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "Highlighter.h"
+#include <QTextDocument>
+#include <QElapsedTimer>
 
 namespace Lint
 {
 
-Highlighter::Highlighter(QTextDocument *parent)
-    : QSyntaxHighlighter(parent)
+Highlighter::Highlighter(QTextDocument *parent, Dialect dialect)
+    : QSyntaxHighlighter(parent),
+      m_dialect(dialect),
+      m_formatAll(false),
+      m_formatBlock(-1),
+      m_visibleFirst(-1),
+      m_visibleLast(-1)
 {
-    HighlightingRule rule;
-
     // Keywords
-    m_keywordFormat.setForeground(Qt::darkBlue);
-    m_keywordFormat.setFontWeight(QFont::Bold);
-
-    const QString keywordPatterns[] =
-    {
-        // TODO: Highlight C or C++ keywords only
-        QStringLiteral("\\bchar\\b"), QStringLiteral("\\bclass\\b"), QStringLiteral("\\bconst\\b"),
-        QStringLiteral("\\bdouble\\b"), QStringLiteral("\\benum\\b"), QStringLiteral("\\bexplicit\\b"),
-        QStringLiteral("\\bfriend\\b"), QStringLiteral("\\binline\\b"), QStringLiteral("\\bint\\b"),
-        QStringLiteral("\\blong\\b"), QStringLiteral("\\bnamespace\\b"), QStringLiteral("\\boperator\\b"),
-        QStringLiteral("\\bprivate\\b"), QStringLiteral("\\bprotected\\b"), QStringLiteral("\\bpublic\\b"),
-        QStringLiteral("\\bshort\\b"), QStringLiteral("\\bextern\\b"), QStringLiteral("\\bsigned\\b"),
-        QStringLiteral("\\bslots\\b"), QStringLiteral("\\bstatic\\b"), QStringLiteral("\\bstruct\\b"),
-        QStringLiteral("\\btemplate\\b"), QStringLiteral("\\btypedef\\b"), QStringLiteral("\\btypename\\b"),
-        QStringLiteral("\\bunion\\b"), QStringLiteral("\\bunsigned\\b"), QStringLiteral("\\bvirtual\\b"),
-        QStringLiteral("\\bvoid\\b"), QStringLiteral("\\bvolatile\\b"), QStringLiteral("\\bbool\\b"),
-        QStringLiteral("\\breturn\\b"), QStringLiteral("\\bcase\\b"), QStringLiteral("\\bbreak\\b"),
-        QStringLiteral("\\bdefault\\b"), QStringLiteral("\\bif\\b"), QStringLiteral("\\belse\\b"),
-        QStringLiteral("\\bfor\\b"), QStringLiteral("\\bswitch\\b"), QStringLiteral("\\bwhile\\b"),
-        QStringLiteral("\\bdo\\b"), QStringLiteral("\\bauto\\b"), QStringLiteral("\\bcontinue\\b"),
-        QStringLiteral("\\bfloat\\b"), QStringLiteral("\\bgoto\\b"), QStringLiteral("\\bregister\\b"),
-        QStringLiteral("\\bsizeof\\b")
-
-    };
-
-    for (const QString &pattern : keywordPatterns)
-    {
-        rule.pattern = QRegularExpression(pattern);
-        rule.format = m_keywordFormat;
-        m_highlightingRules.emplace_back(rule);
-    }
+    m_formats[TOKEN_KEYWORD].setForeground(Qt::darkBlue);
+    m_formats[TOKEN_KEYWORD].setFontWeight(QFont::Bold);
 
-    // TODO: Preprocessor syntax highlighting
-    m_preprocessorFormat.setFontWeight(QFont::Bold);
-    m_preprocessorFormat.setForeground(BRUSH_GREY);
-    rule.pattern = QRegularExpression(QStringLiteral("#[a-z]+"));
-    rule.format = m_preprocessorFormat;
-    m_highlightingRules.emplace_back(rule);
+    // Preprocessor directives
+    m_formats[TOKEN_PREPROCESSOR].setFontWeight(QFont::Bold);
+    m_formats[TOKEN_PREPROCESSOR].setForeground(BRUSH_GREY);
 
     // Classes
-    m_classFormat.setFontWeight(QFont::Bold);
-    m_classFormat.setForeground(Qt::darkMagenta);
-    rule.pattern = QRegularExpression(QStringLiteral("\\bQ[A-Za-z]+\\b"));
-    rule.format = m_classFormat;
-    m_highlightingRules.emplace_back(rule);
+    m_formats[TOKEN_CLASS].setFontWeight(QFont::Bold);
+    m_formats[TOKEN_CLASS].setForeground(Qt::darkMagenta);
 
     // Comments
-    m_singleLineCommentFormat.setForeground(BRUSH_HALF_GREEN);
-    rule.pattern = QRegularExpression(QStringLiteral("//[^\n]*"));
-    rule.format = m_singleLineCommentFormat;
-    m_highlightingRules.emplace_back(rule);
-    m_multiLineCommentFormat.setForeground(BRUSH_HALF_GREEN);
-
-    // Quotes
-    m_quotationFormat.setForeground(Qt::darkGreen);
-    rule.pattern = QRegularExpression(QStringLiteral("\".*\""));
-    rule.format = m_quotationFormat;
-    m_highlightingRules.emplace_back(rule);
+    m_formats[TOKEN_COMMENT].setForeground(BRUSH_HALF_GREEN);
+
+    // Strings and characters
+    m_formats[TOKEN_STRING].setForeground(Qt::darkGreen);
+    m_formats[TOKEN_CHARACTER].setForeground(Qt::darkGreen);
+
+    // Numbers
+    m_formats[TOKEN_NUMBER].setForeground(Qt::darkCyan);
+
+    // Operators
+    m_formats[TOKEN_OPERATOR].setForeground(Qt::darkRed);
 
     // Functions
-    m_functionFormat.setFontItalic(true);
-    m_functionFormat.setForeground(BRUSH_BLUE);
-    rule.pattern = QRegularExpression(QStringLiteral("\\b[A-Za-z0-9_]+(?=\\()"));
-    rule.format = m_functionFormat;
-    m_highlightingRules.emplace_back(rule);
+    m_formats[TOKEN_FUNCTION].setFontItalic(true);
+    m_formats[TOKEN_FUNCTION].setForeground(BRUSH_BLUE);
 
-    // TODO: Numbers
-    // TODO: Operators
+    // A cursor keeps its place as text is inserted or removed before it
+    if (parent)
+    {
+        m_frontier = QTextCursor(parent);
+    }
 
-    m_commentStartExpression = QRegularExpression(QStringLiteral("/\\*"));
-    m_commentEndExpression = QRegularExpression(QStringLiteral("\\*/"));
+    // Runs whenever the event loop is idle
+    m_backgroundTimer.setInterval(0);
+    QObject::connect(&m_backgroundTimer, &QTimer::timeout, this, &Highlighter::slotFormatChunk);
+    m_backgroundTimer.start();
 }
 
-void Highlighter::highlightBlock(const QString &text) noexcept
+void Highlighter::restartBackgroundFormat() noexcept
+{
+    m_formatAll = false;
+    m_frontier.movePosition(QTextCursor::Start);
+    m_backgroundTimer.start();
+}
+
+void Highlighter::setDialect(Dialect dialect) noexcept
+{
+    if (m_dialect != dialect)
+    {
+        m_dialect = dialect;
+        // Only the visible blocks are lexed again straight away
+        restartBackgroundFormat();
+        rehighlight();
+    }
+}
+
+void Highlighter::setVisibleBlocks(int first, int last) noexcept
+{
+    if ((first == m_visibleFirst) && (last == m_visibleLast))
+    {
+        return;
+    }
+    m_visibleFirst = first;
+    m_visibleLast = last;
+
+    if (m_formatAll || m_frontier.isNull())
+    {
+        return;
+    }
+
+    // Blocks before the frontier are already formatted
+    auto const frontier = m_frontier.block().blockNumber();
+    for (auto block = document()->findBlockByNumber(qMax(first, frontier)); block.isValid() && (block.blockNumber() <= last); block = block.next())
+    {
+        rehighlightBlock(block);
+    }
+}
+
+void Highlighter::slotFormatChunk() noexcept
 {
-    for (const HighlightingRule &rule : qAsConst(m_highlightingRules))
+    if (m_formatAll || m_frontier.isNull())
     {
-        QRegularExpressionMatchIterator matchIterator = rule.pattern.globalMatch(text);
-        while (matchIterator.hasNext())
+        m_backgroundTimer.stop();
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    auto block = m_frontier.block();
+    while (block.isValid() && (timer.elapsed() < HIGHLIGHT_SLICE_MS))
+    {
+        // The block before has the right state so this one will too
+        m_formatBlock = block.position();
+        rehighlightBlock(block);
+        block = block.next();
+        if (block.isValid())
         {
-            QRegularExpressionMatch match = matchIterator.next();
-            setFormat(match.capturedStart(), match.capturedLength(), rule.format);
+            m_frontier.setPosition(block.position());
         }
     }
-    setCurrentBlockState(0);
+    m_formatBlock = -1;
 
-    int startIndex = 0;
-    if (previousBlockState() != 1)
+    if (!block.isValid())
     {
-        startIndex = text.indexOf(m_commentStartExpression);
+        // Edits are highlighted as normal from now on
+        m_formatAll = true;
+        m_backgroundTimer.stop();
     }
+}
 
-    while (startIndex >= 0)
+void Highlighter::highlightBlock(const QString &text) noexcept
+{
+    // Blocks past the frontier that nobody can see are left for the background pass
+    // so loading a document or switching dialect doesn't lex the whole of it
+    auto const block = currentBlock();
+    if (!m_formatAll && !m_frontier.isNull() && (block.position() >= m_frontier.position()) &&
+        (block.position() != m_formatBlock))
     {
-        QRegularExpressionMatch match = m_commentEndExpression.match(text, startIndex);
-        int endIndex = match.capturedStart();
-        int commentLength = 0;
-        if (endIndex == -1)
+        auto const number = block.blockNumber();
+        if ((number < m_visibleFirst) || (number > m_visibleLast))
         {
-            setCurrentBlockState(1);
-            commentLength = text.length() - startIndex;
-        } else
-        {
-            commentLength = endIndex - startIndex + match.capturedLength();
+            return;
         }
-        setFormat(startIndex, commentLength, m_multiLineCommentFormat);
-        startIndex = text.indexOf(m_commentStartExpression, startIndex + commentLength);
+        // Visible blocks are formatted from the state before them even if that isn't known yet,
+        // the background pass puts them right when it gets there
+    }
+
+    // One pass over the line instead of a regex per rule
+    m_tokens.clear();
+    setCurrentBlockState(lexLine(text, previousBlockState(), m_dialect, m_tokens));
+
+    for (auto const& token : m_tokens)
+    {
+        setFormat(token.start, token.length, m_formats[token.type]);
     }
 }
 
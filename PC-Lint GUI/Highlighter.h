@@ -18,7 +18,11 @@
 
 #include <QSyntaxHighlighter>
 #include <QTextCharFormat>
-#include <QRegularExpression>
+#include <QTextCursor>
+#include <QTimer>
+#include <array>
+#include <vector>
+#include "Lexer.h"
 
 // TODO: Namespacify
 #define BRUSH_HALF_GREEN QBrush(QColor(0,128,0))
@@ -32,33 +36,44 @@ QT_END_NAMESPACE
 namespace Lint
 {
 
+// Background highlighting runs for this long before letting other events through
+constexpr int HIGHLIGHT_SLICE_MS = 8;
+
 class Highlighter : public QSyntaxHighlighter
 {
     Q_OBJECT
 
 public:
-    Highlighter(QTextDocument *parent = nullptr);
+    Highlighter(QTextDocument *parent = nullptr, Dialect dialect = DIALECT_CPP);
+
+    // Keywords of this language are highlighted
+    void setDialect(Dialect dialect) noexcept;
+    // Blocks shown by the editor, these are formatted before the rest of the document
+    void setVisibleBlocks(int first, int last) noexcept;
 
 protected:
     void highlightBlock(const QString &text) noexcept override;
 
+private slots:
+    void slotFormatChunk() noexcept;
+
 private:
-    struct HighlightingRule
-    {
-        QRegularExpression pattern;
-        QTextCharFormat format;
-    };
-    std::vector<HighlightingRule> m_highlightingRules;
-
-    QRegularExpression m_commentStartExpression;
-    QRegularExpression m_commentEndExpression;
-    QTextCharFormat m_preprocessorFormat;
-    QTextCharFormat m_keywordFormat;
-    QTextCharFormat m_classFormat;
-    QTextCharFormat m_singleLineCommentFormat;
-    QTextCharFormat m_multiLineCommentFormat;
-    QTextCharFormat m_quotationFormat;
-    QTextCharFormat m_functionFormat;
+    void restartBackgroundFormat() noexcept;
+
+    Dialect m_dialect;
+    // Token type -> format
+    std::array<QTextCharFormat, TOKEN_COUNT> m_formats;
+    // Reused between blocks
+    std::vector<Token> m_tokens;
+
+    // Until the background pass has been through the whole document only the blocks before
+    // the frontier have the right state, blocks after it are only lexed if they are visible
+    bool m_formatAll;
+    QTextCursor m_frontier; // Start of the first block not yet formatted, moves with edits
+    int m_formatBlock;      // Position of the block the background pass is formatting
+    int m_visibleFirst;
+    int m_visibleLast;
+    QTimer m_backgroundTimer;
 };
 
 };
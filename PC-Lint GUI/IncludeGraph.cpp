@@ -0,0 +1,590 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "IncludeGraph.h"
+#include <QtConcurrent>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QDebug>
+#include <algorithm>
+
+namespace Lint
+{
+
+namespace
+{
+    constexpr quint32 INCLUDE_GRAPH_MAGIC = 0x4C494E43;
+    constexpr quint32 INCLUDE_GRAPH_VERSION = 1;
+
+    bool isHorizontalSpace(QChar character) noexcept
+    {
+        return (character == ' ') || (character == '\t') || (character == '\f') || (character == '\v') || (character == '\r');
+    }
+
+    // Directory of a -i option, empty for anything else
+    QString includeDirectory(const QString& option, const QDir& workingDirectory) noexcept
+    {
+        if (!option.startsWith("-i") || (option.size() <= 2) || option.contains('('))
+        {
+            return QString();
+        }
+        auto path = option.mid(2);
+        path.remove('"');
+        return QDir::cleanPath(workingDirectory.absoluteFilePath(QDir::fromNativeSeparators(path)));
+    }
+};
+
+std::vector<IncludeDirective> scanIncludes(QStringView text) noexcept
+{
+    std::vector<IncludeDirective> directives;
+    auto const size = text.size();
+    auto const at = [&text, size](qsizetype position) -> QChar
+    {
+        return (position < size) ? text[position] : QChar();
+    };
+
+    int line = 1;
+    bool lineStart = true;
+    qsizetype i = 0;
+
+    // Skip to the end of the line, following backslash continuations
+    auto const skipLine = [&]()
+    {
+        while (i < size && (text[i] != '\n'))
+        {
+            if ((text[i] == '\\') && (at(i + 1) == '\n'))
+            {
+                line++;
+                i++;
+            }
+            i++;
+        }
+    };
+
+    while (i < size)
+    {
+        auto const character = text[i];
+
+        if (character == '\n')
+        {
+            line++;
+            lineStart = true;
+            i++;
+        }
+        else if (isHorizontalSpace(character) || ((character == '\\') && (at(i + 1) == '\n')))
+        {
+            // A continuation doesn't start a new line as far as the preprocessor is concerned
+            if (character == '\\')
+            {
+                line++;
+                i++;
+            }
+            i++;
+        }
+        else if ((character == '/') && (at(i + 1) == '*'))
+        {
+            i += 2;
+            while ((i < size) && !((text[i] == '*') && (at(i + 1) == '/')))
+            {
+                if (text[i] == '\n')
+                {
+                    line++;
+                }
+                i++;
+            }
+            i += 2;
+        }
+        else if ((character == '/') && (at(i + 1) == '/'))
+        {
+            skipLine();
+        }
+        else if (lineStart && (character == '#'))
+        {
+            auto const directiveLine = line;
+            i++;
+            while ((i < size) && isHorizontalSpace(text[i]))
+            {
+                i++;
+            }
+
+            auto const start = i;
+            while ((i < size) && (text[i].isLetter() || (text[i] == '_')))
+            {
+                i++;
+            }
+            auto const directive = text.mid(start, i - start);
+
+            if ((directive == QLatin1String("include")) || (directive == QLatin1String("include_next")) || (directive == QLatin1String("import")))
+            {
+                while ((i < size) && isHorizontalSpace(text[i]))
+                {
+                    i++;
+                }
+
+                auto const open = at(i);
+                auto const close = (open == '<') ? QChar('>') : QChar('"');
+                if ((open == '<') || (open == '"'))
+                {
+                    auto const nameStart = ++i;
+                    while ((i < size) && (text[i] != close) && (text[i] != '\n'))
+                    {
+                        i++;
+                    }
+                    if (at(i) == close)
+                    {
+                        directives.push_back(IncludeDirective{text.mid(nameStart, i - nameStart).toString(), open == '<', directiveLine});
+                    }
+                }
+                // Computed includes (#include MACRO) can't be followed without a preprocessor
+            }
+
+            skipLine();
+            lineStart = false;
+        }
+        else if ((character == '"') && (i > 0) && (text[i - 1] == 'R'))
+        {
+            // Raw string R"delimiter(...)delimiter"
+            auto const open = text.indexOf(QLatin1Char('('), i);
+            if (open < 0)
+            {
+                break;
+            }
+            auto const terminator = ')' + text.mid(i + 1, open - i - 1).toString() + '"';
+            auto const end = text.indexOf(terminator, open);
+            auto const last = (end < 0) ? size : (end + terminator.size());
+            line += static_cast<int>(std::count(text.begin() + i, text.begin() + last, QLatin1Char('\n')));
+            i = last;
+            lineStart = false;
+        }
+        else if ((character == '"') || (character == '\''))
+        {
+            // Literals end at the closing quote or the end of the line
+            i++;
+            while ((i < size) && (text[i] != character) && (text[i] != '\n'))
+            {
+                i += (text[i] == '\\') ? 2 : 1;
+            }
+            if ((i < size) && (text[i] == character))
+            {
+                i++;
+            }
+            lineStart = false;
+        }
+        else
+        {
+            lineStart = false;
+            i++;
+        }
+    }
+
+    return directives;
+}
+
+QString includeGraphCacheFile(const QString& lintFile) noexcept
+{
+    auto const directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    auto const hash = QCryptographicHash::hash(QFileInfo(lintFile).absoluteFilePath().toUtf8(), QCryptographicHash::Sha1).toHex().left(16);
+    return directory + "/include-graph-" + QString::fromLatin1(hash) + ".cache";
+}
+
+void IncludeGraph::build(const ParsedLintFile& lintFile, const QString& workingDirectory) noexcept
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    m_contexts.clear();
+    m_files.clear();
+    m_fileIds.clear();
+    m_includes.clear();
+    m_includedBy.clear();
+    m_fileContexts.clear();
+    m_modules.clear();
+    m_resolved.clear();
+
+    // Follow the -env_push scopes to know which -i directories each module sees
+    const QDir directory(workingDirectory);
+    std::vector<QStringList> scopes{QStringList()};
+    QHash<QString, int> contextIds;
+    QVector<Visit> pending;
+    for (auto const& option : lintFile.options)
+    {
+        if (option.kind == LINT_TOKEN_MODULE)
+        {
+            if (option.path.isEmpty())
+            {
+                continue;
+            }
+
+            auto const key = scopes.back().join('\n');
+            auto context = contextIds.value(key, -1);
+            if (context < 0)
+            {
+                context = static_cast<int>(m_contexts.size());
+                m_contexts.push_back(scopes.back());
+                contextIds.insert(key, context);
+            }
+
+            auto const file = fileId(option.path);
+            m_modules[static_cast<size_t>(file)] = true;
+            auto& contexts = m_fileContexts[static_cast<size_t>(file)];
+            if (!contexts.contains(context))
+            {
+                contexts.insert(context);
+                pending << Visit{file, context};
+            }
+        }
+        else if (option.text == "-env_push")
+        {
+            scopes.push_back(scopes.back());
+        }
+        else if (option.text == "-env_pop")
+        {
+            if (scopes.size() > 1)
+            {
+                scopes.pop_back();
+            }
+        }
+        else
+        {
+            auto const include = includeDirectory(option.text, directory);
+            if (!include.isEmpty())
+            {
+                scopes.back() << include;
+            }
+        }
+    }
+
+    auto const cachedScans = m_scans.size();
+    visit(pending);
+
+    // Files no longer in the graph don't need to be remembered
+    for (auto scan = m_scans.begin(); scan != m_scans.end();)
+    {
+        scan = m_fileIds.contains(scan.key()) ? std::next(scan) : m_scans.erase(scan);
+    }
+
+    qInfo() << "Include graph of" << pending.size() << "modules has" << m_files.size() << "files," << m_contexts.size()
+            << "include paths, built in" << timer.elapsed() << "ms with" << cachedScans << "cached scans";
+}
+
+QStringList IncludeGraph::update(const QStringList& changedFiles) noexcept
+{
+    // New files may now be found first in the include directories
+    m_resolved.clear();
+
+    QStringList changed;
+    QVector<Visit> pending;
+    for (auto const& changedFile : changedFiles)
+    {
+        auto const path = QFileInfo(changedFile).canonicalFilePath();
+        auto const file = m_fileIds.value(path, -1);
+        if (file < 0)
+        {
+            continue;
+        }
+        changed << path;
+
+        // Replaced by whatever the file includes now
+        auto& includes = m_includes[static_cast<size_t>(file)];
+        for (auto const included : includes)
+        {
+            m_includedBy[static_cast<size_t>(included)].remove(file);
+        }
+        includes.clear();
+        m_scans.remove(path);
+
+        for (auto const context : m_fileContexts[static_cast<size_t>(file)])
+        {
+            pending << Visit{file, context};
+        }
+    }
+
+    visit(pending);
+    return dependents(changed);
+}
+
+QStringList IncludeGraph::dependents(const QStringList& files) const noexcept
+{
+    std::vector<int> stack;
+    for (auto const& file : files)
+    {
+        auto id = m_fileIds.value(file, -1);
+        if (id < 0)
+        {
+            id = m_fileIds.value(QFileInfo(file).canonicalFilePath(), -1);
+        }
+        if (id >= 0)
+        {
+            stack.push_back(id);
+        }
+    }
+
+    // Walk up the reverse edges, include cycles are fine as each file is seen once
+    std::vector<bool> seen(m_files.size(), false);
+    QStringList modules;
+    while (!stack.empty())
+    {
+        auto const file = static_cast<size_t>(stack.back());
+        stack.pop_back();
+        if (seen[file])
+        {
+            continue;
+        }
+        seen[file] = true;
+
+        if (m_modules[file])
+        {
+            modules << m_files[file];
+        }
+        for (auto const includer : m_includedBy[file])
+        {
+            stack.push_back(includer);
+        }
+    }
+    return modules;
+}
+
+QStringList IncludeGraph::files() const noexcept
+{
+    return QStringList(m_files.cbegin(), m_files.cend());
+}
+
+QStringList IncludeGraph::includes(const QString& file) const noexcept
+{
+    QStringList includes;
+    auto const id = m_fileIds.value(file, -1);
+    if (id >= 0)
+    {
+        for (auto const included : m_includes[static_cast<size_t>(id)])
+        {
+            includes << m_files[static_cast<size_t>(included)];
+        }
+        includes.sort();
+    }
+    return includes;
+}
+
+bool IncludeGraph::load(const QString& cacheFile) noexcept
+{
+    QFile file(cacheFile);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 count = 0;
+    stream >> magic >> version >> count;
+    if ((magic != INCLUDE_GRAPH_MAGIC) || (version != INCLUDE_GRAPH_VERSION))
+    {
+        qDebug() << "Ignoring include graph cache:" << cacheFile;
+        return false;
+    }
+
+    QHash<QString, std::shared_ptr<const Scan>> scans;
+    scans.reserve(static_cast<int>(count));
+    for (quint32 i = 0; (i < count) && (stream.status() == QDataStream::Ok); i++)
+    {
+        QString path;
+        quint32 directives = 0;
+        auto scan = std::make_shared<Scan>();
+        stream >> path >> scan->modified >> scan->size >> directives;
+        for (quint32 directive = 0; (directive < directives) && (stream.status() == QDataStream::Ok); directive++)
+        {
+            IncludeDirective include;
+            qint32 line = 0;
+            stream >> include.name >> include.angled >> line;
+            include.line = line;
+            scan->directives.emplace_back(std::move(include));
+        }
+        scans.insert(path, std::move(scan));
+    }
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        qCritical() << "Include graph cache is corrupt:" << cacheFile;
+        return false;
+    }
+
+    m_scans = std::move(scans);
+    return true;
+}
+
+bool IncludeGraph::save(const QString& cacheFile) const noexcept
+{
+    QDir().mkpath(QFileInfo(cacheFile).absolutePath());
+    QSaveFile file(cacheFile);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCritical() << "Failed to save include graph:" << cacheFile << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream << INCLUDE_GRAPH_MAGIC << INCLUDE_GRAPH_VERSION << static_cast<quint32>(m_scans.size());
+    for (auto scan = m_scans.cbegin(); scan != m_scans.cend(); ++scan)
+    {
+        stream << scan.key() << scan.value()->modified << scan.value()->size << static_cast<quint32>(scan.value()->directives.size());
+        for (auto const& directive : scan.value()->directives)
+        {
+            stream << directive.name << directive.angled << static_cast<qint32>(directive.line);
+        }
+    }
+    return (stream.status() == QDataStream::Ok) && file.commit();
+}
+
+int IncludeGraph::fileId(const QString& file) noexcept
+{
+    auto const id = m_fileIds.find(file);
+    if (id != m_fileIds.end())
+    {
+        return *id;
+    }
+
+    auto const newId = static_cast<int>(m_files.size());
+    m_fileIds.insert(file, newId);
+    m_files.push_back(file);
+    m_includes.emplace_back();
+    m_includedBy.emplace_back();
+    m_fileContexts.emplace_back();
+    m_modules.push_back(false);
+    return newId;
+}
+
+void IncludeGraph::visit(QVector<Visit> pending) noexcept
+{
+    // Every file of a level is scanned in parallel, the graph is only changed between levels
+    while (!pending.isEmpty())
+    {
+        auto const results = QtConcurrent::blockingMapped<QVector<VisitResult>>(pending, VisitFile{this});
+
+        QVector<Visit> next;
+        for (auto const& result : results)
+        {
+            if (result.scan)
+            {
+                m_scans.insert(m_files[static_cast<size_t>(result.file)], result.scan);
+            }
+
+            for (auto const& include : result.includes)
+            {
+                auto const included = fileId(include);
+                m_includes[static_cast<size_t>(result.file)].insert(included);
+                m_includedBy[static_cast<size_t>(included)].insert(result.file);
+
+                auto& contexts = m_fileContexts[static_cast<size_t>(included)];
+                if (!contexts.contains(result.context))
+                {
+                    contexts.insert(result.context);
+                    next << Visit{included, result.context};
+                }
+            }
+        }
+        pending = std::move(next);
+    }
+}
+
+IncludeGraph::VisitResult IncludeGraph::visitFile(const Visit& visit) const noexcept
+{
+    VisitResult result{visit.file, visit.context, {}, nullptr};
+    auto const& path = m_files[static_cast<size_t>(visit.file)];
+    const QFileInfo fileInfo(path);
+    auto const modified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+    // Only read the file if it changed since it was last scanned
+    auto scan = m_scans.value(path);
+    if (!scan || (scan->modified != modified) || (scan->size != fileInfo.size()))
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return result;
+        }
+        auto newScan = std::make_shared<Scan>();
+        newScan->modified = modified;
+        newScan->size = fileInfo.size();
+        newScan->directives = scanIncludes(QString::fromUtf8(file.readAll()));
+        scan = std::move(newScan);
+    }
+    result.scan = scan;
+
+    auto const directory = fileInfo.absolutePath();
+    for (auto const& directive : scan->directives)
+    {
+        auto const include = resolve(directive, directory, visit.context);
+        if (!include.isEmpty())
+        {
+            result.includes << include;
+        }
+    }
+    return result;
+}
+
+QString IncludeGraph::resolve(const IncludeDirective& directive, const QString& directory, int context) const noexcept
+{
+    auto const name = QDir::fromNativeSeparators(directive.name);
+    if (QDir::isAbsolutePath(name))
+    {
+        return QFileInfo(name).canonicalFilePath();
+    }
+
+    // "name" is looked for next to the file including it first
+    if (!directive.angled)
+    {
+        auto const local = QFileInfo(directory + '/' + name).canonicalFilePath();
+        if (!local.isEmpty())
+        {
+            return local;
+        }
+    }
+
+    auto const key = QString::number(context) + '|' + name;
+    {
+        QMutexLocker lock(&m_resolvedMutex);
+        auto const resolved = m_resolved.constFind(key);
+        if (resolved != m_resolved.constEnd())
+        {
+            return *resolved;
+        }
+    }
+
+    // Headers that aren't found (system headers lint finds itself) are left out of the graph
+    QString include;
+    for (auto const& includeDirectory : m_contexts[static_cast<size_t>(context)])
+    {
+        include = QFileInfo(includeDirectory + '/' + name).canonicalFilePath();
+        if (!include.isEmpty())
+        {
+            break;
+        }
+    }
+
+    QMutexLocker lock(&m_resolvedMutex);
+    m_resolved.insert(key, include);
+    return include;
+}
+
+};
@@ -0,0 +1,136 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include <QMutex>
+#include <memory>
+#include <vector>
+#include "LintFile.h"
+
+namespace Lint
+{
+
+// #include, #include_next or #import of a source file
+struct IncludeDirective
+{
+    QString name; // As written between the quotes or angle brackets
+    bool angled;  // <name> rather than "name"
+    int line;     // Line of the directive (from 1)
+};
+
+// Find the include directives of a source file without preprocessing it
+// Comments, string and character literals (raw strings too) are skipped but conditionals aren't
+// evaluated, so every include that might be used is returned
+std::vector<IncludeDirective> scanIncludes(QStringView text) noexcept;
+
+// Where the include graph of a lint file is kept between sessions
+QString includeGraphCacheFile(const QString& lintFile) noexcept;
+
+// Which files each module of a lint file includes, directly or through other headers
+// Built in parallel one level of includes at a time and updated incrementally as files change
+// Includes are resolved the way lint does, the including file's directory first for "name" then
+// the -i directories in effect for the module (-env_push scopes are followed)
+class IncludeGraph
+{
+public:
+    IncludeGraph() = default;
+
+    // Scan the modules of a lint file and everything they include
+    // Relative -i directories are taken from workingDirectory
+    void build(const ParsedLintFile& lintFile, const QString& workingDirectory) noexcept;
+    // Rescan files that changed and return the modules that need to be linted again
+    QStringList update(const QStringList& changedFiles) noexcept;
+    // Modules that are or include (directly or indirectly) any of these files
+    QStringList dependents(const QStringList& files) const noexcept;
+    // Every file in the graph
+    QStringList files() const noexcept;
+    // Files a file includes directly
+    QStringList includes(const QString& file) const noexcept;
+
+    // Scanned include directives are kept between sessions so only files
+    // that changed since are read again
+    bool load(const QString& cacheFile) noexcept;
+    bool save(const QString& cacheFile) const noexcept;
+
+private:
+    // Include directives of a file as it was when scanned
+    struct Scan
+    {
+        qint64 modified;
+        qint64 size;
+        std::vector<IncludeDirective> directives;
+    };
+
+    // File reached from a module with these include directories
+    struct Visit
+    {
+        int file;
+        int context;
+    };
+
+    struct VisitResult
+    {
+        int file;
+        int context;
+        QStringList includes; // Canonical paths
+        std::shared_ptr<const Scan> scan;
+    };
+
+    // Run on the thread pool, only reads the graph
+    struct VisitFile
+    {
+        using result_type = VisitResult;
+
+        const IncludeGraph* graph;
+
+        VisitResult operator()(const Visit& visit) const noexcept
+        {
+            return graph->visitFile(visit);
+        }
+    };
+
+    int fileId(const QString& file) noexcept;
+    void visit(QVector<Visit> pending) noexcept;
+    VisitResult visitFile(const Visit& visit) const noexcept;
+    QString resolve(const IncludeDirective& directive, const QString& directory, int context) const noexcept;
+
+    // Include directories of every -env_push scope with modules in it
+    std::vector<QStringList> m_contexts;
+
+    // File table and edges in both directions
+    std::vector<QString> m_files;
+    QHash<QString, int> m_fileIds;
+    std::vector<QSet<int>> m_includes;
+    std::vector<QSet<int>> m_includedBy;
+    std::vector<QSet<int>> m_fileContexts;
+    std::vector<bool> m_modules;
+
+    // Canonical path -> include directives
+    QHash<QString, std::shared_ptr<const Scan>> m_scans;
+
+    // Context and name -> file found in the include directories
+    mutable QMutex m_resolvedMutex;
+    mutable QHash<QString, QString> m_resolved;
+};
+
+};
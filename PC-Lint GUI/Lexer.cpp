@@ -0,0 +1,699 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Lexer.h"
+#include <QFileInfo>
+#include <algorithm>
+
+namespace Lint
+{
+
+namespace
+{
+    constexpr quint8 DIALECT_C_BIT = 0x1;
+    constexpr quint8 DIALECT_CPP_BIT = 0x2;
+
+    // Keywords are found with a hash and displace perfect hash
+    // The word picks a bucket, the bucket's seed picks a slot no other keyword uses
+    constexpr int KEYWORD_BUCKETS = 64;
+    constexpr int KEYWORD_SLOTS = 256;
+    constexpr int KEYWORD_MAX_LENGTH = 16;
+
+    // Raw string delimiters can't be longer than this
+    constexpr int RAW_DELIMITER_MAX_LENGTH = 16;
+
+    struct Keyword
+    {
+        const char* word;
+        quint8 dialects;
+    };
+
+    // Generated for the C17 and C++20 keywords (plus the Qt signals, slots and emit macros)
+    // Regenerate both tables when adding a keyword
+    constexpr quint8 KEYWORD_SEEDS[KEYWORD_BUCKETS] =
+    {
+        1, 2, 0, 3, 1, 3, 1, 1, 1, 2, 5, 1, 1, 2, 2, 0,
+        1, 2, 1, 2, 2, 1, 2, 1, 1, 0, 0, 2, 1, 1, 1, 3,
+        1, 1, 3, 1, 1, 1, 1, 1, 0, 5, 0, 0, 0, 2, 0, 5,
+        1, 1, 1, 1, 1, 0, 4, 1, 1, 0, 1, 2, 2, 1, 1, 1
+    };
+
+    // Slot -> keyword, empty slots have no word
+    constexpr Keyword KEYWORD_TABLE[KEYWORD_SLOTS] =
+    {
+        {nullptr, 0},
+        {"long", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"public", DIALECT_CPP_BIT},
+        {"constexpr", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"xor", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"override", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"switch", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {"static_assert", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"operator", DIALECT_CPP_BIT},
+        {"_Thread_local", DIALECT_C_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"while", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"co_yield", DIALECT_CPP_BIT},
+        {"_Noreturn", DIALECT_C_BIT},
+        {"enum", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {"noexcept", DIALECT_CPP_BIT},
+        {"if", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"and", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"this", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"thread_local", DIALECT_CPP_BIT},
+        {"consteval", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"not_eq", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"const", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"_Atomic", DIALECT_C_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"explicit", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"double", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {"wchar_t", DIALECT_CPP_BIT},
+        {"_Complex", DIALECT_C_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"_Bool", DIALECT_C_BIT},
+        {nullptr, 0},
+        {"concept", DIALECT_CPP_BIT},
+        {"do", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"true", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"signed", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"extern", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"xor_eq", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"restrict", DIALECT_C_BIT},
+        {"dynamic_cast", DIALECT_CPP_BIT},
+        {"_Static_assert", DIALECT_C_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"return", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {"emit", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"char16_t", DIALECT_CPP_BIT},
+        {"static_cast", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"_Imaginary", DIALECT_C_BIT},
+        {"unsigned", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"new", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"or_eq", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"inline", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {"constinit", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"void", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {"or", DIALECT_CPP_BIT},
+        {"protected", DIALECT_CPP_BIT},
+        {"and_eq", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"private", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"virtual", DIALECT_CPP_BIT},
+        {"bitand", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"friend", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"template", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"sizeof", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {"co_return", DIALECT_CPP_BIT},
+        {"export", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"nullptr", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"goto", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {"using", DIALECT_CPP_BIT},
+        {"default", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {"mutable", DIALECT_CPP_BIT},
+        {"delete", DIALECT_CPP_BIT},
+        {"typename", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"bitor", DIALECT_CPP_BIT},
+        {"decltype", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"const_cast", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"_Alignof", DIALECT_C_BIT},
+        {nullptr, 0},
+        {"register", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"volatile", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"not", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"union", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"requires", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"alignof", DIALECT_CPP_BIT},
+        {"for", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {"bool", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"reinterpret_cast", DIALECT_CPP_BIT},
+        {"typeid", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"auto", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"try", DIALECT_CPP_BIT},
+        {"char32_t", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"namespace", DIALECT_CPP_BIT},
+        {"class", DIALECT_CPP_BIT},
+        {"static", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"typedef", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {"signals", DIALECT_CPP_BIT},
+        {"compl", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"false", DIALECT_CPP_BIT},
+        {"case", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {"alignas", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"co_await", DIALECT_CPP_BIT},
+        {"final", DIALECT_CPP_BIT},
+        {"int", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"break", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"continue", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"asm", DIALECT_CPP_BIT},
+        {"float", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {"else", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {"char8_t", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"char", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {"slots", DIALECT_CPP_BIT},
+        {"_Generic", DIALECT_C_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"struct", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"throw", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {nullptr, 0},
+        {"catch", DIALECT_CPP_BIT},
+        {nullptr, 0},
+        {"_Alignas", DIALECT_C_BIT},
+        {"short", DIALECT_C_BIT | DIALECT_CPP_BIT},
+        {nullptr, 0}
+    };
+
+    // 32-bit FNV-1a
+    inline quint32 hashWord(QStringView word, quint32 seed) noexcept
+    {
+        quint32 hash = 2166136261U ^ seed;
+        for (auto const c : word)
+        {
+            hash ^= c.unicode();
+            hash *= 16777619U;
+        }
+        return hash;
+    }
+
+    inline bool equals(QStringView text, const char* word) noexcept
+    {
+        for (auto const c : text)
+        {
+            if ((*word == '\0') || (c.unicode() != static_cast<uchar>(*word)))
+            {
+                return false;
+            }
+            word++;
+        }
+        return *word == '\0';
+    }
+
+    inline bool isDigit(QChar c) noexcept
+    {
+        return (c >= '0') && (c <= '9');
+    }
+
+    inline bool isIdentifierStart(QChar c) noexcept
+    {
+        return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || (c == '_') ||
+               ((c.unicode() > 0x7F) && c.isLetter());
+    }
+
+    inline bool isIdentifierChar(QChar c) noexcept
+    {
+        return isIdentifierStart(c) || isDigit(c);
+    }
+
+    inline bool isOperator(QChar c) noexcept
+    {
+        switch (c.unicode())
+        {
+        case '+': case '-': case '*': case '/': case '%': case '=': case '&': case '|': case '^':
+        case '!': case '~': case '<': case '>': case '?': case ':': case ';': case ',': case '.':
+        case '[': case ']': case '(': case ')': case '{': case '}': case '#':
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Qt style class names (QString, QTextDocument)
+    inline bool isClassName(QStringView word) noexcept
+    {
+        if ((word.size() < 2) || (word[0] != 'Q'))
+        {
+            return false;
+        }
+        return std::all_of(word.begin() + 1, word.end(), [](QChar c)
+        {
+            return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z'));
+        });
+    }
+
+    // Encoding prefix of a string or character literal (L, u, U, u8 and the C++ raw forms)
+    inline bool isLiteralPrefix(QStringView word, Dialect dialect, bool& raw) noexcept
+    {
+        raw = (dialect == DIALECT_CPP) && word.endsWith(QLatin1Char('R'));
+        auto const prefix = raw ? word.chopped(1) : word;
+        return prefix.isEmpty() ? raw :
+               (equals(prefix, "L") || equals(prefix, "u") || equals(prefix, "U") || equals(prefix, "u8"));
+    }
+
+    // Index just past the closing quote, or the end of the line if it isn't closed
+    int quotedEnd(QStringView line, int open) noexcept
+    {
+        auto const quote = line[open];
+        auto const length = static_cast<int>(line.size());
+        for (int i = open + 1; i < length; i++)
+        {
+            if (line[i] == '\\')
+            {
+                i++;
+            }
+            else if (line[i] == quote)
+            {
+                return i + 1;
+            }
+        }
+        return length;
+    }
+
+    // Index just past "*/", -1 if the comment carries on
+    int commentEnd(QStringView line, int from) noexcept
+    {
+        auto const length = static_cast<int>(line.size());
+        for (int i = from; i + 1 < length; i++)
+        {
+            if ((line[i] == '*') && (line[i + 1] == '/'))
+            {
+                return i + 2;
+            }
+        }
+        return -1;
+    }
+
+    // Delimiters are kept as a hash so they fit in the block state
+    inline int delimiterHash(QStringView delimiter) noexcept
+    {
+        return static_cast<int>(hashWord(delimiter, 0) & 0xFFFFFF);
+    }
+
+    // Index just past )delimiter", -1 if the raw string carries on
+    int rawStringEnd(QStringView line, int from, int delimiter) noexcept
+    {
+        auto const length = static_cast<int>(line.size());
+        for (int i = from; i < length; i++)
+        {
+            if (line[i] != ')')
+            {
+                continue;
+            }
+            for (int j = i + 1; (j < length) && (j - i - 1 <= RAW_DELIMITER_MAX_LENGTH); j++)
+            {
+                if (line[j] == '"')
+                {
+                    if (delimiterHash(line.mid(i + 1, j - i - 1)) == delimiter)
+                    {
+                        return j + 1;
+                    }
+                    break;
+                }
+            }
+        }
+        return -1;
+    }
+};
+
+Dialect dialectForFile(const QString& file) noexcept
+{
+    // Headers could be either so they get the C++ keywords
+    return (QFileInfo(file).suffix().compare("c", Qt::CaseInsensitive) == 0) ? DIALECT_C : DIALECT_CPP;
+}
+
+bool isKeyword(QStringView word, Dialect dialect) noexcept
+{
+    if ((word.size() < 2) || (word.size() > KEYWORD_MAX_LENGTH))
+    {
+        return false;
+    }
+
+    auto const seed = KEYWORD_SEEDS[hashWord(word, 0) % KEYWORD_BUCKETS];
+    auto const& keyword = KEYWORD_TABLE[hashWord(word, seed) % KEYWORD_SLOTS];
+    auto const dialectBit = (dialect == DIALECT_C) ? DIALECT_C_BIT : DIALECT_CPP_BIT;
+
+    return keyword.word && (keyword.dialects & dialectBit) && equals(word, keyword.word);
+}
+
+int lexLine(QStringView line, int state, Dialect dialect, std::vector<Token>& tokens) noexcept
+{
+    auto const length = static_cast<int>(line.size());
+    auto const addToken = [&tokens](int start, int end, TokenType type)
+    {
+        tokens.push_back(Token{start, end - start, type});
+    };
+
+    int i = 0;
+
+    // Finish whatever was left open on the previous line
+    // QSyntaxHighlighter starts with -1
+    if (state < 0)
+    {
+        state = LEXER_STATE_NORMAL;
+    }
+
+    if ((state & LEXER_STATE_MASK) == LEXER_STATE_COMMENT)
+    {
+        i = commentEnd(line, 0);
+        if (i < 0)
+        {
+            addToken(0, length, TOKEN_COMMENT);
+            return LEXER_STATE_COMMENT;
+        }
+        addToken(0, i, TOKEN_COMMENT);
+    }
+    else if ((state & LEXER_STATE_MASK) == LEXER_STATE_RAW_STRING)
+    {
+        i = rawStringEnd(line, 0, state >> 2);
+        if (i < 0)
+        {
+            addToken(0, length, TOKEN_STRING);
+            return state;
+        }
+        addToken(0, i, TOKEN_STRING);
+    }
+
+    // Preprocessor directives start with the first character that isn't whitespace
+    auto directive = i;
+    while ((directive < length) && line[directive].isSpace())
+    {
+        directive++;
+    }
+    if ((directive < length) && (line[directive] == '#'))
+    {
+        auto name = directive + 1;
+        while ((name < length) && line[name].isSpace())
+        {
+            name++;
+        }
+        i = name;
+        while ((i < length) && isIdentifierChar(line[i]))
+        {
+            i++;
+        }
+        addToken(directive, i, TOKEN_PREPROCESSOR);
+
+        // <header> names
+        if (equals(line.mid(name, i - name), "include"))
+        {
+            while ((i < length) && line[i].isSpace())
+            {
+                i++;
+            }
+            if ((i < length) && (line[i] == '<'))
+            {
+                auto const close = line.indexOf(QLatin1Char('>'), i);
+                auto const end = (close < 0) ? length : static_cast<int>(close) + 1;
+                addToken(i, end, TOKEN_STRING);
+                i = end;
+            }
+        }
+    }
+
+    while (i < length)
+    {
+        auto const c = line[i];
+
+        // Comments
+        if ((c == '/') && (i + 1 < length))
+        {
+            if (line[i + 1] == '/')
+            {
+                addToken(i, length, TOKEN_COMMENT);
+                return LEXER_STATE_NORMAL;
+            }
+            if (line[i + 1] == '*')
+            {
+                auto const end = commentEnd(line, i + 2);
+                if (end < 0)
+                {
+                    addToken(i, length, TOKEN_COMMENT);
+                    return LEXER_STATE_COMMENT;
+                }
+                addToken(i, end, TOKEN_COMMENT);
+                i = end;
+                continue;
+            }
+        }
+
+        // Numbers follow the preprocessing number rules so 0x1p-3, 1.5e+10f and 1'000'000 are single tokens
+        if (isDigit(c) || ((c == '.') && (i + 1 < length) && isDigit(line[i + 1])))
+        {
+            auto end = i + 1;
+            while (end < length)
+            {
+                auto const next = line[end];
+                auto const previous = line[end - 1];
+                if (((next == '+') || (next == '-')) &&
+                    ((previous == 'e') || (previous == 'E') || (previous == 'p') || (previous == 'P')))
+                {
+                    end++;
+                }
+                else if (isIdentifierChar(next) || (next == '.'))
+                {
+                    end++;
+                }
+                else if ((next == '\'') && (dialect == DIALECT_CPP) && (end + 1 < length) && isIdentifierChar(line[end + 1]))
+                {
+                    end += 2;
+                }
+                else
+                {
+                    break;
+                }
+            }
+            addToken(i, end, TOKEN_NUMBER);
+            i = end;
+            continue;
+        }
+
+        // Identifiers, keywords and literal prefixes
+        if (isIdentifierStart(c))
+        {
+            auto end = i + 1;
+            while ((end < length) && isIdentifierChar(line[end]))
+            {
+                end++;
+            }
+            auto const word = line.mid(i, end - i);
+
+            bool raw = false;
+            if ((end < length) && ((line[end] == '"') || (line[end] == '\'')) && isLiteralPrefix(word, dialect, raw))
+            {
+                if (raw && (line[end] == '"'))
+                {
+                    // R"delimiter( ... )delimiter"
+                    auto const open = line.indexOf(QLatin1Char('('), end + 1);
+                    if ((open >= 0) && (open - end - 1 <= RAW_DELIMITER_MAX_LENGTH))
+                    {
+                        auto const delimiter = delimiterHash(line.mid(end + 1, open - end - 1));
+                        auto const close = rawStringEnd(line, static_cast<int>(open) + 1, delimiter);
+                        if (close < 0)
+                        {
+                            addToken(i, length, TOKEN_STRING);
+                            return LEXER_STATE_RAW_STRING | (delimiter << 2);
+                        }
+                        addToken(i, close, TOKEN_STRING);
+                        i = close;
+                        continue;
+                    }
+                }
+                else if (!raw)
+                {
+                    auto const close = quotedEnd(line, end);
+                    addToken(i, close, (line[end] == '"') ? TOKEN_STRING : TOKEN_CHARACTER);
+                    i = close;
+                    continue;
+                }
+            }
+
+            if (isKeyword(word, dialect))
+            {
+                addToken(i, end, TOKEN_KEYWORD);
+            }
+            else if ((end < length) && (line[end] == '('))
+            {
+                addToken(i, end, TOKEN_FUNCTION);
+            }
+            else if (isClassName(word))
+            {
+                addToken(i, end, TOKEN_CLASS);
+            }
+            i = end;
+            continue;
+        }
+
+        // String and character literals
+        if ((c == '"') || (c == '\''))
+        {
+            auto const close = quotedEnd(line, i);
+            addToken(i, close, (c == '"') ? TOKEN_STRING : TOKEN_CHARACTER);
+            i = close;
+            continue;
+        }
+
+        // Runs of operators and punctuation are one token
+        if (isOperator(c))
+        {
+            auto end = i + 1;
+            while ((end < length) && isOperator(line[end]))
+            {
+                // Stop before a comment or a number like .5
+                if (((line[end] == '/') && (end + 1 < length) && ((line[end + 1] == '/') || (line[end + 1] == '*'))) ||
+                    ((line[end] == '.') && (end + 1 < length) && isDigit(line[end + 1])))
+                {
+                    break;
+                }
+                end++;
+            }
+            addToken(i, end, TOKEN_OPERATOR);
+            i = end;
+            continue;
+        }
+
+        // Whitespace and anything else
+        i++;
+    }
+
+    return LEXER_STATE_NORMAL;
+}
+
+};
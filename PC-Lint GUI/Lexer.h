@@ -0,0 +1,72 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QString>
+#include <QStringView>
+#include <vector>
+
+namespace Lint
+{
+
+// Language the keywords are taken from
+enum Dialect
+{
+    DIALECT_C,
+    DIALECT_CPP
+};
+
+enum TokenType
+{
+    TOKEN_KEYWORD,
+    TOKEN_PREPROCESSOR,
+    TOKEN_CLASS,
+    TOKEN_COMMENT,
+    TOKEN_STRING,
+    TOKEN_CHARACTER,
+    TOKEN_NUMBER,
+    TOKEN_OPERATOR,
+    TOKEN_FUNCTION,
+    TOKEN_COUNT
+};
+
+struct Token
+{
+    int start;
+    int length;
+    TokenType type;
+};
+
+// State carried from one line to the next
+// Raw strings keep a hash of their delimiter in the upper bits
+constexpr int LEXER_STATE_NORMAL = 0;
+constexpr int LEXER_STATE_COMMENT = 1;
+constexpr int LEXER_STATE_RAW_STRING = 2;
+constexpr int LEXER_STATE_MASK = 0x3;
+
+// Dialect to highlight a file with based on its extension
+Dialect dialectForFile(const QString& file) noexcept;
+
+// Whether the word is a keyword of the dialect
+bool isKeyword(QStringView word, Dialect dialect) noexcept;
+
+// Split one line into tokens in a single pass
+// Anything that isn't a token (identifiers, whitespace) is left out
+// Returns the state to pass in with the next line
+int lexLine(QStringView line, int state, Dialect dialect, std::vector<Token>& tokens) noexcept;
+
+};
@@ -0,0 +1,433 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "LintFile.h"
+#include "SourceDiscovery.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDir>
+#include <QHash>
+#include <QSet>
+#include <QTextStream>
+#include <QRegularExpression>
+#include <QElapsedTimer>
+#include <QtConcurrent>
+#include <QDebug>
+#include <mutex>
+
+namespace Lint
+{
+
+namespace
+{
+    struct CachedTokens
+    {
+        QDateTime lastModified;
+        qint64 size;
+        std::shared_ptr<const std::vector<LintFileToken>> tokens;
+    };
+
+    // Tokens of a lint file, read again only when the file changes
+    std::shared_ptr<const std::vector<LintFileToken>> readTokens(const QString& file) noexcept
+    {
+        static std::mutex mutex;
+        static QHash<QString, CachedTokens> cache;
+
+        const QFileInfo fileInfo(file);
+        auto const lastModified = fileInfo.lastModified();
+        auto const size = fileInfo.size();
+        {
+            std::scoped_lock lock(mutex);
+            auto const cached = cache.constFind(file);
+            if ((cached != cache.constEnd()) && (cached->lastModified == lastModified) && (cached->size == size))
+            {
+                return cached->tokens;
+            }
+        }
+
+        QFile input(file);
+        if (!input.open(QIODevice::ReadOnly | QIODevice::Text))
+        {
+            return nullptr;
+        }
+        QTextStream stream(&input);
+        auto const tokens = std::make_shared<const std::vector<LintFileToken>>(tokenizeLintFile(stream.readAll()));
+
+        std::scoped_lock lock(mutex);
+        cache.insert(file, CachedTokens{lastModified, size, tokens});
+        return tokens;
+    }
+
+    // PC-Lint expands %NAME% from the environment
+    QString expandEnvironment(const QString& text) noexcept
+    {
+        if (!text.contains('%'))
+        {
+            return text;
+        }
+
+        static const QRegularExpression variable("%([^%]+)%");
+        QString expanded;
+        int last = 0;
+        auto matches = variable.globalMatch(text);
+        while (matches.hasNext())
+        {
+            auto const match = matches.next();
+            auto const name = match.captured(1).toLocal8Bit();
+            expanded += text.midRef(last, match.capturedStart() - last);
+            expanded += qEnvironmentVariableIsSet(name.constData()) ? qEnvironmentVariable(name.constData()) : match.captured();
+            last = match.capturedEnd();
+        }
+        expanded += text.midRef(last);
+        return expanded;
+    }
+
+    // File name a token refers to
+    QString tokenPath(const QString& text) noexcept
+    {
+        QString path = text;
+        path.remove('"');
+        return QDir::fromNativeSeparators(expandEnvironment(path.trimmed()));
+    }
+
+    // Canonical path of a module, empty if it isn't a file
+    QString resolveModule(const QString& path)
+    {
+        const QFileInfo fileInfo(path);
+        return fileInfo.isFile() ? fileInfo.canonicalFilePath() : QString();
+    }
+
+    class Parser
+    {
+    public:
+        explicit Parser(const QString& lintFile) :
+            m_workingDirectory(QFileInfo(lintFile).absoluteDir()),
+            m_envDepth(0),
+            m_discovery{false, SOURCE_DEFAULT_EXTENSIONS}
+        {
+        }
+
+        void read(const QString& file, int depth) noexcept
+        {
+            auto const canonicalFile = QFileInfo(file).canonicalFilePath();
+            if ((depth > LINT_FILE_MAX_DEPTH) || m_reading.contains(canonicalFile))
+            {
+                m_result.errors << "Lint file includes itself: " + file;
+                return;
+            }
+
+            auto const tokens = canonicalFile.isEmpty() ? nullptr : readTokens(canonicalFile);
+            if (!tokens)
+            {
+                m_result.errors << "Unable to read lint file: " + file;
+                return;
+            }
+
+            m_reading.insert(canonicalFile);
+            m_result.lintFiles << canonicalFile;
+            auto const directory = QFileInfo(canonicalFile).absolutePath();
+
+            for (auto const& token : *tokens)
+            {
+                auto const& text = token.text;
+                auto const where = QString("%1(%2)").arg(QFileInfo(canonicalFile).fileName(), QString::number(token.line));
+
+                if (text.startsWith('-') || text.startsWith('+'))
+                {
+                    if (text == "-env_push")
+                    {
+                        m_result.options.push_back(LintOption{text, LINT_TOKEN_OPTION, QString(), m_envDepth});
+                        m_envDepth++;
+                    }
+                    else if (text == "-env_pop")
+                    {
+                        if (m_envDepth == 0)
+                        {
+                            m_result.errors << where + ": -env_pop without a -env_push";
+                        }
+                        else
+                        {
+                            m_envDepth--;
+                        }
+                        m_result.options.push_back(LintOption{text, LINT_TOKEN_OPTION, QString(), m_envDepth});
+                    }
+                    else if (text.startsWith("-indirect(") && text.endsWith(')'))
+                    {
+                        // Replaced by the options of the files
+                        for (auto const& name : text.mid(10, text.size() - 11).split(','))
+                        {
+                            readNested(tokenPath(name), directory, where, depth);
+                        }
+                    }
+                    else
+                    {
+                        updateDiscovery(text);
+
+                        // Include directories are also searched for nested lint files
+                        if (text.startsWith("-i") && (text.size() > 2) && !text.contains('('))
+                        {
+                            m_includeDirectories << m_workingDirectory.absoluteFilePath(tokenPath(text.mid(2)));
+                        }
+                        m_result.options.push_back(LintOption{text, LINT_TOKEN_OPTION, QString(), m_envDepth});
+                    }
+                }
+                else if (tokenPath(text).endsWith(".lnt", Qt::CaseInsensitive))
+                {
+                    readNested(tokenPath(text), directory, where, depth);
+                }
+                else
+                {
+                    m_result.options.push_back(LintOption{text, LINT_TOKEN_MODULE, QString(), m_envDepth});
+                    m_moduleDiscovery.push_back(m_discovery);
+                }
+            }
+
+            m_reading.remove(canonicalFile);
+        }
+
+        // Look for the modules on disk in parallel
+        ParsedLintFile finish() noexcept
+        {
+            if (m_envDepth > 0)
+            {
+                m_result.errors << QString("%1 -env_push without a -env_pop").arg(m_envDepth);
+            }
+
+            QStringList paths;
+            for (auto const& option : m_result.options)
+            {
+                if (option.kind == LINT_TOKEN_MODULE)
+                {
+                    paths << m_workingDirectory.absoluteFilePath(tokenPath(option.text));
+                }
+            }
+
+            auto const resolved = QtConcurrent::blockingMapped<QStringList>(paths, resolveModule);
+
+            // Wildcards and directories become the modules they stand for
+            std::vector<LintOption> options;
+            options.reserve(m_result.options.size());
+            int module = 0;
+            for (auto& option : m_result.options)
+            {
+                if (option.kind != LINT_TOKEN_MODULE)
+                {
+                    options.push_back(std::move(option));
+                    continue;
+                }
+
+                auto const& path = paths[module];
+                auto const& discovery = m_moduleDiscovery[static_cast<size_t>(module)];
+                option.path = resolved[module];
+                module++;
+
+                if (!option.path.isEmpty())
+                {
+                    m_result.modules << option.path;
+                    options.push_back(std::move(option));
+                }
+                else if (isModulePattern(path) || QFileInfo(path).isDir())
+                {
+                    auto const sources = discoverSources(path, discovery);
+                    if (sources.isEmpty())
+                    {
+                        m_result.errors << "No modules match: " + option.text;
+                    }
+                    for (auto const& source : sources)
+                    {
+                        options.push_back(LintOption{'"' + QDir::toNativeSeparators(source) + '"', LINT_TOKEN_MODULE, source, option.envDepth});
+                        m_result.modules << source;
+                    }
+                }
+                else
+                {
+                    m_result.errors << "Module not found: " + option.text;
+                }
+            }
+            m_result.options = std::move(options);
+
+            return std::move(m_result);
+        }
+
+    private:
+        // Options that change what wildcards and directories expand to
+        void updateDiscovery(const QString& option) noexcept
+        {
+            if (option == "-subdir")
+            {
+                m_discovery.recursive = true;
+            }
+            else if ((option.startsWith("+cpp(") || option.startsWith("-cpp(")) && option.endsWith(')'))
+            {
+                for (auto extension : option.mid(5, option.size() - 6).split(','))
+                {
+                    extension = extension.trimmed();
+                    if (extension.startsWith('.'))
+                    {
+                        extension.remove(0, 1);
+                    }
+                    if (option.startsWith('+') && !m_discovery.extensions.contains(extension))
+                    {
+                        m_discovery.extensions << extension;
+                    }
+                    else if (option.startsWith('-'))
+                    {
+                        m_discovery.extensions.removeAll(extension);
+                    }
+                }
+            }
+        }
+
+        // Nested lint files are looked for where lint is run, then in the include directories
+        // and then next to the file naming them
+        void readNested(const QString& name, const QString& directory, const QString& where, int depth) noexcept
+        {
+            QStringList candidates;
+            if (QFileInfo(name).isAbsolute())
+            {
+                candidates << name;
+            }
+            else
+            {
+                candidates << m_workingDirectory.absoluteFilePath(name);
+                for (auto const& includeDirectory : m_includeDirectories)
+                {
+                    candidates << QDir(includeDirectory).absoluteFilePath(name);
+                }
+                candidates << QDir(directory).absoluteFilePath(name);
+            }
+
+            for (auto const& candidate : candidates)
+            {
+                if (QFileInfo(candidate).isFile())
+                {
+                    read(candidate, depth + 1);
+                    return;
+                }
+            }
+            m_result.errors << where + ": lint file not found: " + name;
+        }
+
+        const QDir m_workingDirectory;
+        QStringList m_includeDirectories;
+        QSet<QString> m_reading;
+        int m_envDepth;
+        SourceDiscoveryOptions m_discovery;
+        // Discovery options in effect for each module token
+        std::vector<SourceDiscoveryOptions> m_moduleDiscovery;
+        ParsedLintFile m_result;
+    };
+};
+
+std::vector<LintFileToken> tokenizeLintFile(QStringView text) noexcept
+{
+    std::vector<LintFileToken> tokens;
+    auto const size = text.size();
+    int line = 1;
+    int i = 0;
+
+    while (i < size)
+    {
+        auto const character = text[i];
+        auto const next = (i + 1 < size) ? text[i + 1] : QChar();
+
+        if (character == '\n')
+        {
+            line++;
+            i++;
+        }
+        else if (character.isSpace())
+        {
+            i++;
+        }
+        else if ((character == '/') && (next == '/'))
+        {
+            while ((i < size) && (text[i] != '\n'))
+            {
+                i++;
+            }
+        }
+        else if ((character == '/') && (next == '*'))
+        {
+            // Block comments don't nest
+            i += 2;
+            while ((i < size) && !((text[i] == '*') && (i + 1 < size) && (text[i + 1] == '/')))
+            {
+                line += (text[i] == '\n') ? 1 : 0;
+                i++;
+            }
+            i = qMin(i + 2, size);
+        }
+        else
+        {
+            // Quotes and parentheses keep spaces in the token, a token never goes past the end of its line
+            auto const start = i;
+            bool quoted = false;
+            int parentheses = 0;
+            while ((i < size) && (text[i] != '\n'))
+            {
+                auto const current = text[i];
+                if (current == '"')
+                {
+                    quoted = !quoted;
+                }
+                else if (!quoted)
+                {
+                    if (current == '(')
+                    {
+                        parentheses++;
+                    }
+                    else if ((current == ')') && (parentheses > 0))
+                    {
+                        parentheses--;
+                    }
+                    else if ((parentheses == 0) && current.isSpace())
+                    {
+                        break;
+                    }
+                    else if ((parentheses == 0) && (current == '/') && (i + 1 < size) && ((text[i + 1] == '/') || (text[i + 1] == '*')))
+                    {
+                        break;
+                    }
+                }
+                i++;
+            }
+            tokens.push_back(LintFileToken{text.mid(start, i - start).trimmed().toString(), line});
+        }
+    }
+
+    return tokens;
+}
+
+ParsedLintFile parseLintFile(const QString& lintFile) noexcept
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    Parser parser(lintFile);
+    parser.read(lintFile, 0);
+    auto result = parser.finish();
+
+    qInfo() << "Read" << result.lintFiles.size() << "lint files with" << result.modules.size() << "modules in" << timer.elapsed() << "ms";
+    for (auto const& error : result.errors)
+    {
+        qWarning() << error;
+    }
+    return result;
+}
+
+};
@@ -0,0 +1,74 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+#include <memory>
+#include <vector>
+
+namespace Lint
+{
+
+// Nested lint files deeper than this are assumed to be a cycle
+constexpr int LINT_FILE_MAX_DEPTH = 32;
+
+// Whitespace separated item of a lint option file
+struct LintFileToken
+{
+    QString text; // As written, quotes included
+    int line;     // Line the token starts on (from 1)
+};
+
+enum LintTokenKind
+{
+    LINT_TOKEN_OPTION, // -x or +x
+    LINT_TOKEN_MODULE  // Source file to lint
+};
+
+// Token of a lint file with nested lint files replaced by their tokens
+struct LintOption
+{
+    QString text;      // As written, or the quoted path of a file found for a wildcard
+    LintTokenKind kind;
+    QString path;  // Modules: canonical path, empty if the file doesn't exist
+    int envDepth;  // Number of -env_push scopes the token is in
+};
+
+// Everything PC-Lint will see when given a lint file
+struct ParsedLintFile
+{
+    std::vector<LintOption> options; // In the order PC-Lint reads them
+    QStringList modules;             // Canonical paths of the modules that exist, in lint order
+    QStringList lintFiles;           // Every lint file read, the top one first
+    QStringList errors;              // Missing nested files, unbalanced -env_pop, missing modules
+};
+
+// Split the text of a lint option file into tokens
+// Handles // and /* */ comments, quoted parts ("C:\Program Files\x") and spaces inside
+// parentheses (-esym(534, a b)) the way PC-Lint does
+std::vector<LintFileToken> tokenizeLintFile(QStringView text) noexcept;
+
+// Read a lint file following nested lint files (x.lnt and -indirect(x.lnt))
+// Relative paths are taken from the directory of the top lint file as that's where lint is run from
+// Tokens of every file are cached until its modification time changes and the modules
+// are checked for on disk in parallel
+// Wildcard and directory modules are replaced by the files they stand for
+ParsedLintFile parseLintFile(const QString& lintFile) noexcept;
+
+};
@@ -19,10 +19,41 @@
 #include "CodeEditor.h"
 #include "Preferences.h"
 #include "Jenkins.h"
+#include "Trace.h"
+#include "Headless.h"
+#include "Distributed.h"
+#include <QCommandLineParser>
+#include <memory>
+
+// --worker and --export never show a window so they run without a GUI (or a display)
+static bool isHeadless(int argc, char *argv[]) noexcept
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const QByteArray argument(argv[i]);
+        if ((argument == "--worker") || argument.startsWith("--worker=") ||
+            (argument == "--export") || argument.startsWith("--export="))
+        {
+            return true;
+        }
+    }
+    return false;
+}
 
 int main(int argc, char *argv[])
 {
-    QApplication EditorApp(argc, argv);
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+
+    std::unique_ptr<QCoreApplication> EditorApp;
+    if (isHeadless(argc, argv))
+    {
+        EditorApp = std::make_unique<QCoreApplication>(argc, argv);
+    }
+    else
+    {
+        EditorApp = std::make_unique<QApplication>(argc, argv);
+    }
 
     QCoreApplication::setOrganizationName(Lint::SETTINGS_APPLICATION_NAME);
     QCoreApplication::setApplicationName(Lint::SETTINGS_APPLICATION_NAME);
@@ -34,6 +65,77 @@ int main(int argc, char *argv[])
                           Lint::SETTINGS_APPLICATION_NAME << "------------------------------";
     qDebug() << Lint::SETTINGS_APPLICATION_NAME << "version: " BUILD_VERSION;
 
+    // --trace file.json records the whole session and writes it out on exit
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    const QCommandLineOption traceOption("trace", "Record a pipeline trace and write it to <file> on exit.", "file");
+    parser.addOption(traceOption);
+    // --export results.sarif lints without a window and writes the results instead
+    const QCommandLineOption exportOption("export", "Lint without showing a window and export the results to <file> (.csv, .jsonl or .sarif).", "file");
+    const QCommandLineOption lintFileOption("lint-file", "Lint file (.lnt) to use with --export instead of the saved one.", "file");
+    const QCommandLineOption lintExecutableOption("lint-executable", "Lint executable to use with --export instead of the saved one.", "file");
+    parser.addOption(exportOption);
+    parser.addOption(lintFileOption);
+    parser.addOption(lintExecutableOption);
+    // --worker 7878 lints shards for other machines, --workers spreads an --export over them
+    const QCommandLineOption workerOption("worker", "Run as a lint worker on <port> without showing a window.", "port");
+    const QCommandLineOption workersOption("workers", "Lint workers (host:port,host:port) to use with --export instead of the saved ones.", "workers");
+    // Workers only listen on this machine unless told otherwise and always need the token
+    const QCommandLineOption workerBindOption("worker-bind", "Address the --worker listens on (default 127.0.0.1).", "address", "127.0.0.1");
+    const QCommandLineOption workerTokenOption("worker-token", "Token shared by the --worker and its coordinators instead of the saved one.", "token");
+    parser.addOption(workerOption);
+    parser.addOption(workersOption);
+    parser.addOption(workerBindOption);
+    parser.addOption(workerTokenOption);
+    parser.process(*EditorApp);
+    auto const traceFile = parser.value(traceOption);
+    if (!traceFile.isEmpty())
+    {
+        Lint::Trace::setEnabled(true);
+    }
+
+    if (parser.isSet(workerOption))
+    {
+        auto const settings = Lint::readSettings();
+        auto const lintExecutable = parser.isSet(lintExecutableOption) ? parser.value(lintExecutableOption) : settings.lintExecutable;
+        auto const token = parser.isSet(workerTokenOption) ? parser.value(workerTokenOption) : settings.workerToken;
+        if (token.isEmpty())
+        {
+            qCritical() << "A lint worker needs a token, use --worker-token or set one in the preferences";
+            return 2;
+        }
+        QHostAddress address;
+        if (!address.setAddress(parser.value(workerBindOption)))
+        {
+            qCritical() << "Not an address to listen on:" << parser.value(workerBindOption);
+            return 2;
+        }
+
+        Lint::LintWorker worker(lintExecutable, token);
+        bool validPort = false;
+        auto const port = parser.value(workerOption).toUShort(&validPort);
+        QString error;
+        if (!validPort || !worker.listen(address, port, error))
+        {
+            qCritical() << "Unable to listen on" << address.toString() << "port" << parser.value(workerOption) << error;
+            return 2;
+        }
+        qInfo() << "Lint worker listening on" << address.toString() << "port" << worker.port() << "with" << lintExecutable;
+        return EditorApp->exec();
+    }
+
+    if (parser.isSet(exportOption))
+    {
+        auto const workers = parser.value(workersOption).split(',', Qt::SkipEmptyParts);
+        auto const result = Lint::lintHeadless(parser.value(exportOption), parser.value(lintExecutableOption), parser.value(lintFileOption), workers,
+                                               parser.value(workerTokenOption));
+        if (!traceFile.isEmpty())
+        {
+            Lint::Trace::exportChromeTrace(traceFile);
+        }
+        return result;
+    }
+
     MainWindow mainWindow;
 
 
@@ -51,8 +153,17 @@ int main(int argc, char *argv[])
     mainWindow.setWindowTitle(APPLICATION_NAME " " BUILD_VERSION);
     mainWindow.show();
 
+    // Settings and the last session load on a worker thread while the window paints
+    mainWindow.startSession(startupTimer);
+
     //mainWindow.showMaximized();
 
 
-    return EditorApp.exec();
+    auto const result = EditorApp->exec();
+
+    if (!traceFile.isEmpty())
+    {
+        Lint::Trace::exportChromeTrace(traceFile);
+    }
+    return result;
 }
@@ -29,10 +29,19 @@
 #include <QtGlobal>
 #include <QClipboard>
 #include <QTreeWidget>
+#include <QHeaderView>
+#include <QInputDialog>
+#include <QCloseEvent>
+#include <QStandardPaths>
+#include <QtConcurrent>
+#include <QSaveFile>
+#include <QLocale>
+#include <algorithm>
 
 
 #include "MainWindow.h"
 #include "ui_MainWindow.h"
+#include "Export.h"
 #include "PCLintPlus.h"
 #include "ProgressWindow.h"
 #include "About.h"
@@ -47,17 +56,33 @@ MainWindow::MainWindow(QWidget *parent) :
     m_actionError(std::make_unique<QAction>()),
     m_actionWarning(std::make_unique<QAction>()),
     m_actionInformation(std::make_unique<QAction>()),
+    m_editorContainer(std::make_unique<QWidget>()),
+    m_editorTabs(std::make_unique<QTabBar>()),
+    m_lintTreeContainer(std::make_unique<QWidget>()),
+    m_groupByToolbar(std::make_unique<QToolBar>()),
+    m_groupByComboBox(std::make_unique<QComboBox>()),
+    m_statisticsDock(std::make_unique<QDockWidget>("Statistics")),
+    m_statistics(std::make_unique<Lint::StatisticsWindow>()),
+    m_messageHelpDock(std::make_unique<QDockWidget>("Message Help")),
+    m_messageHelp(std::make_unique<Lint::MessageHelpWindow>()),
     // Toggled on (show messages only of this type)
     // Toggle off (hide messages only of this type)
     m_toggleError(true),
     m_toggleWarning(true),
     m_toggleInformation(true),
-    m_preferences(std::make_unique<Preferences>(this)),
     m_m_lintTreeMenu(std::make_unique<QMenu>(this)),
     m_numberOfErrors(0),
     m_numberOfWarnings(0),
     m_numberOfInformations(0),
-    m_parent(nullptr)
+    m_fileWatcher(std::make_unique<Lint::FileWatcher>()),
+    m_relintRunning(false),
+    m_includeGraphGeneration(0),
+    m_includeGraphRequest(0),
+    m_sessionChanged(false),
+    m_strings(std::make_shared<Lint::StringPool>()),
+    m_scheduler(std::make_unique<Lint::LintScheduler>(m_strings)),
+    m_projectComboBox(std::make_unique<QComboBox>()),
+    m_projectAction(nullptr)
 {
     qRegisterMetaType<Lint::Status>("Status");
     qRegisterMetaType<Lint::LintMessageGroup>("LintMessageGroup");
@@ -72,9 +97,90 @@ MainWindow::MainWindow(QWidget *parent) :
     // Setup tree view
     setupLintTree();
 
+    // Group by selector above the tree view
+    m_groupByComboBox->addItem("File", Lint::GROUP_BY_FILE);
+    m_groupByComboBox->addItem("Message number", Lint::GROUP_BY_NUMBER);
+    m_groupByComboBox->addItem("Directory", Lint::GROUP_BY_DIRECTORY);
+    m_groupByComboBox->addItem("Type", Lint::GROUP_BY_TYPE);
+    m_groupByToolbar->addWidget(new QLabel("Group by: "));
+    m_groupByToolbar->addWidget(m_groupByComboBox.get());
+
+    // Project selector, only there while workspace results are shown
+    auto* projectSelector = new QWidget();
+    auto* projectLayout = new QHBoxLayout(projectSelector);
+    projectLayout->setContentsMargins(0, 0, 0, 0);
+    projectLayout->addWidget(new QLabel("  Project: "));
+    projectLayout->addWidget(m_projectComboBox.get());
+    m_projectAction = m_groupByToolbar->addWidget(projectSelector);
+    m_projectAction->setVisible(false);
+    QObject::connect(m_projectComboBox.get(), QOverload<int>::of(&QComboBox::activated), this, &MainWindow::showProject);
+
+    QObject::connect(m_scheduler.get(), &Lint::LintScheduler::signalProjectStarted, this, &MainWindow::projectStarted);
+    QObject::connect(m_scheduler.get(), &Lint::LintScheduler::signalProjectComplete, this, &MainWindow::projectComplete);
+    QObject::connect(m_scheduler.get(), &Lint::LintScheduler::signalWorkspaceComplete, this, &MainWindow::workspaceComplete);
+    QObject::connect(m_scheduler.get(), &Lint::LintScheduler::signalConcurrencyChanged, this, [this](int processes)
+    {
+        m_ui->statusBar->showMessage(QString("Linting up to %1 projects at once").arg(processes));
+    });
+
+    auto const lintTreePosition = m_ui->splitter->indexOf(m_ui->m_lintTree);
+    auto* lintTreeLayout = new QVBoxLayout(m_lintTreeContainer.get());
+    lintTreeLayout->setContentsMargins(0, 0, 0, 0);
+    lintTreeLayout->setSpacing(0);
+    lintTreeLayout->addWidget(m_groupByToolbar.get());
+    lintTreeLayout->addWidget(m_ui->m_lintTree);
+    m_ui->splitter->insertWidget(lintTreePosition, m_lintTreeContainer.get());
+
+    QObject::connect(m_groupByComboBox.get(), QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index)
+    {
+        m_treeModel.setGrouping(static_cast<Lint::Grouping>(m_groupByComboBox->itemData(index).toInt()));
+    });
+
+    // Run statistics, hidden until asked for from the View menu
+    m_statisticsDock->setObjectName("statisticsDock");
+    m_statisticsDock->setWidget(m_statistics.get());
+    addDockWidget(Qt::RightDockWidgetArea, m_statisticsDock.get());
+    m_statisticsDock->hide();
+    m_ui->menuView->addAction(m_statisticsDock->toggleViewAction());
+
+    // Explanation of the selected message, also hidden until asked for
+    m_messageHelpDock->setObjectName("messageHelpDock");
+    m_messageHelpDock->setWidget(m_messageHelp.get());
+    addDockWidget(Qt::RightDockWidgetArea, m_messageHelpDock.get());
+    m_messageHelpDock->hide();
+    m_ui->menuView->addAction(m_messageHelpDock->toggleViewAction());
+
+    // Tabs of open files above the code editor
+    m_editorTabs->setTabsClosable(true);
+    m_editorTabs->setMovable(true);
+    m_editorTabs->setDocumentMode(true);
+    m_editorTabs->setExpanding(false);
+
+    auto const codeEditorPosition = m_ui->splitter->indexOf(m_ui->m_codeEditor);
+    auto* codeEditorLayout = new QVBoxLayout(m_editorContainer.get());
+    codeEditorLayout->setContentsMargins(0, 0, 0, 0);
+    codeEditorLayout->setSpacing(0);
+    codeEditorLayout->addWidget(m_editorTabs.get());
+    codeEditorLayout->addWidget(m_ui->m_codeEditor);
+    m_ui->splitter->insertWidget(codeEditorPosition, m_editorContainer.get());
+
+    QObject::connect(m_editorTabs.get(), &QTabBar::currentChanged, this, [this](int index)
+    {
+        if (index >= 0)
+        {
+            openFile(m_editorTabs->tabData(index).toString(), 0);
+        }
+    });
+    QObject::connect(m_editorTabs.get(), &QTabBar::tabCloseRequested, this, &MainWindow::closeTab);
+
     // Configure the code editor
     m_ui->m_codeEditor->setLineNumberAreaColour(LINE_NUMBER_AREA_COLOUR);
     m_ui->m_codeEditor->setLineNumberBackgroundColour(LINE_CURRENT_BACKGROUND_COLOUR);
+    m_ui->m_codeEditor->setMessageModel(&m_treeModel);
+
+    // Pick up edits made outside of the GUI
+    QObject::connect(m_fileWatcher.get(), &Lint::FileWatcher::signalFilesChanged, this, &MainWindow::slotFilesChanged);
+    QObject::connect(&m_includeGraphWatcher, &QFutureWatcher<std::shared_ptr<Lint::IncludeGraph>>::finished, this, &MainWindow::includeGraphBuilt);
 
     // Set the splitter size
     m_ui->splitter->setSizes(QList<int>() << 400 << 200);
@@ -138,139 +244,231 @@ MainWindow::MainWindow(QWidget *parent) :
         m_proxyModel.invalidate();
         m_proxyModel.setFilter(m_toggleError, m_toggleWarning, m_toggleInformation);
     });
-
-    // With syntax highlighting
-    m_highlighter = std::make_unique<Lint::Highlighter>(m_ui->m_codeEditor->document());
 }
 
 void MainWindow::setupLintTree() noexcept
 {
-    m_treeModel.setHorizontalHeaderItem(Lint::LINT_TABLE_FILE_COLUMN, new QStandardItem("File"));
-    m_treeModel.setHorizontalHeaderItem(Lint::LINT_TABLE_NUMBER_COLUMN, new QStandardItem("Number"));
-    m_treeModel.setHorizontalHeaderItem(Lint::LINT_TABLE_DESCRIPTION_COLUMN, new QStandardItem("Description"));
-    m_treeModel.setHorizontalHeaderItem(Lint::LINT_TABLE_LINE_COLUMN, new QStandardItem("Line"));
-
-    // TODO: Replace with QAbstractItemModel for performance
     m_proxyModel.setSourceModel(&m_treeModel);
     m_proxyModel.setFilter(m_toggleError, m_toggleWarning, m_toggleInformation);
     m_ui->m_lintTree->setModel(&m_proxyModel);
 
+    // Right click suppresses the message
+    m_ui->m_lintTree->setContextMenuPolicy(Qt::CustomContextMenu);
+    QObject::connect(m_ui->m_lintTree, &QTreeView::customContextMenuRequested, this, &MainWindow::showLintTreeMenu);
+
     m_ui->m_lintTree->setColumnWidth(Lint::LINT_TABLE_FILE_COLUMN,256);
     m_ui->m_lintTree->setColumnWidth(Lint::LINT_TABLE_NUMBER_COLUMN,80);
     m_ui->m_lintTree->setColumnWidth(Lint::LINT_TABLE_DESCRIPTION_COLUMN,800);
     m_ui->m_lintTree->setColumnWidth(Lint::LINT_TABLE_LINE_COLUMN,80);
 }
 
-auto MainWindow::createTreeNodes(const Lint::LintMessage& message) noexcept
+void MainWindow::updateMessageCount(const Lint::LintMessage& message, int count) noexcept
 {
-    QList<QStandardItem*> items;
-
-    auto* treeFileItem = new QStandardItem(QFileInfo(message.file).fileName());
-    treeFileItem->setData(message.file, Qt::UserRole);  
-    auto* treeNumberItem = new QStandardItem(QString::number(message.number));
-    auto* treeDescriptionItem = new QStandardItem(message.description);
-    treeDescriptionItem->setData(message.type, Qt::UserRole);
-    auto* treeLineItem = new QStandardItem(QString::number(message.line));
-
-    QImage icon;
-    // TODO: Use enum Message instead of string for performance so this can be put in the LintMessage struct
-    //Lint::Message messageType = Lint::MESSAGE_UNKNOWN;
-
-    if (message.type == Lint::Type::TYPE_ERROR)
+    switch (Lint::messageType(message.type))
     {
-        icon.load(":/images/error.png");
-        m_numberOfErrors++;
+    case Lint::MESSAGE_ERROR:
+        m_numberOfErrors += count;
         m_actionError->setText("Errors:" + QString::number(m_numberOfErrors));
-        //messageType = PCLint::MESSAGE_ERROR;
-    }
-    else if (message.type == Lint::Type::TYPE_WARNING)
-    {
-        icon.load(":/images/warning.png");
-        m_numberOfWarnings++;
+        break;
+    case Lint::MESSAGE_WARNING:
+        m_numberOfWarnings += count;
         m_actionWarning->setText("Warnings:" + QString::number(m_numberOfWarnings));
-        //messageType = PCLint::MESSAGE_WARNING;
-    }
-    else if (message.type == Lint::Type::TYPE_INFORMATION)
-    {
-        icon.load(":/images/info.png");
-        m_numberOfInformations++;
+        break;
+    case Lint::MESSAGE_INFORMATION:
+        m_numberOfInformations += count;
         m_actionInformation->setText("Information:" + QString::number(m_numberOfInformations));
-        //messageType = PCLint::MESSAGE_INFORMATION;
-    }
-    else if (message.type == Lint::Type::TYPE_SUPPLEMENTAL)
-    {
-        icon.load(":/images/info.png");
-        //messageType = PCLint::MESSAGE_SUPPLEMENTAL;
-    }
-    else if (message.type == Lint::Type::TYPE_NOTE)
-    {
-        icon.load(":/images/info.png");
+        break;
+    case Lint::MESSAGE_SUPPLEMENTAL:
+    case Lint::MESSAGE_NOTE:
+        break;
+    case Lint::MESSAGE_UNKNOWN:
+        Q_ASSERT(false);
+        break;
     }
-    else
+}
+
+void MainWindow::resetMessageCount() noexcept
+{
+    m_numberOfErrors = 0;
+    m_numberOfWarnings = 0;
+    m_numberOfInformations = 0;
+
+    m_actionError->setText("Errors:" + QString::number(m_numberOfErrors));
+    m_actionWarning->setText("Warnings:" + QString::number(m_numberOfWarnings));
+    m_actionInformation->setText("Information:" + QString::number(m_numberOfInformations));
+}
+
+void MainWindow::slotAddTreeParent(const Lint::LintMessage& parentMessage) noexcept
+{
+    Lint::TraceScope trace("slotAddTreeParent");
+    m_sessionChanged = true;
+    updateMessageCount(parentMessage);
+    m_statistics->addMessage(parentMessage);
+    m_treeModel.addParent(parentMessage);
+}
+
+void MainWindow::slotAddTreeChild(const Lint::LintMessage& childMessage) noexcept
+{
+    Lint::TraceScope trace("slotAddTreeChild");
+    m_sessionChanged = true;
+    updateMessageCount(childMessage);
+    m_statistics->addMessage(childMessage);
+    m_treeModel.addChild(childMessage);
+}
+
+MainWindow::~MainWindow()
+{
+    // The last session has to be on disk before the process goes
+    m_sessionWriter.waitForFinished();
+    delete m_ui;
+}
+
+Preferences& MainWindow::preferences() noexcept
+{
+    if (!m_preferences)
     {
-        Q_ASSERT(false);
+        // Only needed before the settings read at startup are in
+        m_preferences = std::make_unique<Preferences>(Lint::readSettings(), this);
     }
+    return *m_preferences;
+}
 
-    treeFileItem->setData(QPixmap::fromImage(icon), Qt::DecorationRole);
+void MainWindow::startSession(const QElapsedTimer& startupTimer) noexcept
+{
+    m_startupTimer = startupTimer;
+    qInfo() << "Window shown" << m_startupTimer.elapsed() << "ms after start";
 
-    items.append(treeFileItem);
-    items.append(treeNumberItem);
-    items.append(treeDescriptionItem);
-    items.append(treeLineItem);
+    QObject::connect(&m_startupWatcher, &QFutureWatcher<StartupState>::finished, this, &MainWindow::startupLoaded);
+    m_startupWatcher.setFuture(QtConcurrent::run([]()
+    {
+        return loadStartupState();
+    }));
+}
 
-    return items;
+MainWindow::StartupState MainWindow::loadStartupState() noexcept
+{
+    QElapsedTimer timer;
+    timer.start();
 
-};
+    StartupState state{Lint::readSettings(), {}, false, 0, 0};
+    state.settingsTime = timer.restart();
 
+    auto const sessionFile = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/" + SESSION_FILE_NAME;
+    if (QFileInfo::exists(sessionFile))
+    {
+        state.restored = state.session.load(sessionFile);
+    }
+    state.sessionTime = timer.elapsed();
+    return state;
+}
 
-// This should be in a separate class to handle this logic (TreeModel)
-void MainWindow::slotAddTreeParent(const Lint::LintMessage& parentMessage) noexcept
+void MainWindow::startupLoaded() noexcept
 {
-    auto const parentName = QFileInfo(parentMessage.file).fileName();
-    auto const parentList = m_treeModel.findItems(parentName, Qt::MatchExactly);
-    QStandardItem* parentNode;
+    auto const state = m_startupWatcher.result();
 
-    // Determine if the we added the file to the tree already
-    if (parentList.size() > 0)
+    // Nothing has needed the preferences yet so they are filled in from what was read on the worker
+    if (!m_preferences)
     {
-        Q_ASSERT(parentList.size() == 1);
-        parentNode = parentList.front();
+        m_preferences = std::make_unique<Preferences>(state.settings, this);
     }
-    else
+
+    // File dialogs opened before the preferences have been shown start here
+    if (Preferences::m_lastDirectory.isEmpty())
     {
-        parentNode = new QStandardItem(parentName);
-        // TODO: Why is the QModelIndex the QString here?
-        parentNode->setData(parentMessage.file, Qt::UserRole);
-        m_treeModel.appendRow(parentNode);
+        Preferences::m_lastDirectory = state.settings.lastDirectory;
     }
 
-    // Duplicate the parent node under itself
-    auto treeItems = createTreeNodes(parentMessage);
-    parentNode->appendRow(treeItems);
+    // Tracing asked for on the command line stays on
+    if (state.settings.trace)
+    {
+        Lint::Trace::setEnabled(true);
+    }
+
+    // Only if nothing was linted while it loaded
+    QElapsedTimer timer;
+    timer.start();
+    if (state.restored && (m_treeModel.messageCount() == 0) && !m_lint)
+    {
+        showMessages(state.session.messages());
+        m_ui->m_lintTree->setSortingEnabled(true);
+        // Already what is on disk
+        m_sessionChanged = false;
+        m_ui->statusBar->showMessage("Restored " + QString::number(m_treeModel.messageCount()) + " messages from the last session");
+    }
 
-    // Set parent to first child
-    m_parent = treeItems.first();
+    qInfo() << "Startup complete after" << m_startupTimer.elapsed() << "ms: settings read in" << state.settingsTime
+            << "ms, last session (" << state.session.messages().size() << "messages ) read in" << state.sessionTime
+            << "ms and shown in" << timer.elapsed() << "ms";
 }
 
-void MainWindow::slotAddTreeChild(const Lint::LintMessage& childMessage) noexcept
+void MainWindow::closeEvent(QCloseEvent* event)
 {
-    // This slot must use the correct parent node
-    Q_ASSERT(m_parent);
+    // Nothing may be added to the results once they are being saved
+    if (m_lint)
+    {
+        QObject::disconnect(m_lint.get(), nullptr, this, nullptr);
+        m_lint->slotAbortLint(true);
+    }
+    if (m_relint)
+    {
+        QObject::disconnect(m_relint.get(), nullptr, this, nullptr);
+        m_relint->slotAbortLint(true);
+        m_relintRunning = false;
+    }
+    m_scheduler->abort();
 
-    // Add children under parent
-    auto treeItems = createTreeNodes(childMessage);
-    m_parent->appendRow(treeItems);
+    // The results are put back next time, unchanged results are already on disk
+    if (m_sessionChanged)
+    {
+        m_sessionChanged = false;
+        auto const directory = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+        auto const sessionFile = directory + "/" + SESSION_FILE_NAME;
+        if (m_treeModel.messageCount() > 0)
+        {
+            // Written while the window goes away, the destructor waits for it
+            m_sessionWriter = QtConcurrent::run([directory, sessionFile, session = currentRun()]()
+            {
+                QDir().mkpath(directory);
+                session.save(sessionFile);
+            });
+        }
+        else
+        {
+            QFile::remove(sessionFile);
+        }
+    }
+    QMainWindow::closeEvent(event);
 }
 
-MainWindow::~MainWindow()
+void MainWindow::showMessages(const Lint::LintMessages& messages) noexcept
 {
-    delete m_ui;
+    clearTreeNodes();
+    m_statistics->clear();
+    resetMessageCount();
+    for (auto const& message : messages)
+    {
+        if (message.type == Lint::Type::TYPE_SUPPLEMENTAL)
+        {
+            slotAddTreeChild(message);
+        }
+        else
+        {
+            slotAddTreeParent(message);
+        }
+    }
 }
 
 void MainWindow::save()
 {
     QString currentFile = m_ui->m_codeEditor->loadedFile();
 
+    // Only part of a large file is in the editor so saving it would truncate the file
+    if (m_ui->m_codeEditor->isLargeFile())
+    {
+        m_ui->statusBar->showMessage("Large files are opened read-only");
+        return;
+    }
+
     // If we have a loaded file then save it
     if (!currentFile.isEmpty())
     {
@@ -285,6 +483,7 @@ void MainWindow::save()
         QString text = m_ui->m_codeEditor->toPlainText();
         out << text;
         file.close();
+        m_ui->m_codeEditor->markSaved();
         m_ui->statusBar->showMessage("Saved " + currentFile + " at " + QDateTime::currentDateTime().toString());
     }
 }
@@ -292,8 +491,8 @@ void MainWindow::save()
 // Open preferences
 void MainWindow::on_actionPreferences_triggered()
 {
-    m_preferences->setModal(true);
-    m_preferences->exec();
+    preferences().setModal(true);
+    preferences().exec();
 }
 
 bool MainWindow::checkLint()
@@ -301,7 +500,7 @@ bool MainWindow::checkLint()
     QFileInfo fileInfo;
 
     // Check if executable exists
-    auto const lintExecutable = m_preferences->getLintExecutablePath().trimmed();
+    auto const lintExecutable = preferences().getLintExecutablePath().trimmed();
     if (lintExecutable.isEmpty())
     {
         QMessageBox::critical(this,"Error", "No PC-Lint/PC-Lint Plus executable specified in Preferences");
@@ -321,7 +520,7 @@ bool MainWindow::checkLint()
     }
 
     // Check if lint file exists
-    auto const lintFile = m_preferences->getLintFilePath().trimmed();
+    auto const lintFile = preferences().getLintFilePath().trimmed();
     if (lintFile.isEmpty())
     {
         QMessageBox::critical(this,"Error", "No lint file (.lnt) specified in Preferences");
@@ -339,9 +538,8 @@ bool MainWindow::checkLint()
 
 void MainWindow::clearTreeNodes() noexcept
 {
+    m_sessionChanged = true;
     m_treeModel.clear();
-    setupLintTree();
-    m_parent = nullptr;
 }
 
 void MainWindow::slotLintComplete(const Lint::Status& lintStatus, const QString& errorMessage) noexcept
@@ -374,26 +572,257 @@ void MainWindow::slotLintComplete(const Lint::Status& lintStatus, const QString&
         Q_ASSERT(false);
     break;
     }
+
+    // Sorting is on typed keys in the model so enabling it here is cheap
     m_ui->m_lintTree->setSortingEnabled(true);
 
+    if (m_baseline)
+    {
+        qInfo() << "Baseline suppressed" << m_lint->suppressedMessages() << "messages";
+        m_ui->statusBar->showMessage(QString::number(m_lint->suppressedMessages()) + " messages suppressed by the baseline");
+    }
+
+    if ((lintStatus == Lint::Status::STATUS_COMPLETE) || (lintStatus == Lint::Status::STATUS_PARTIAL_COMPLETE))
+    {
+        auto const sourceFiles = m_lint->sourceFiles();
+        m_lintSourceFiles = QSet<QString>(sourceFiles.begin(), sourceFiles.end());
+        watchResults();
+        buildIncludeGraph();
+    }
 }
 
-void MainWindow::startLint(QString)
+void MainWindow::buildIncludeGraph() noexcept
 {
-    m_numberOfErrors = 0;
-    m_numberOfWarnings = 0;
-    m_numberOfInformations = 0;
+    // Built away from the GUI thread, headers only trigger a re-lint once it's ready
+    m_includeGraphRequest = ++m_includeGraphGeneration;
+    auto const lintFile = m_lint->getLintFile();
+    auto const parsedLintFile = m_lint->parsedLintFile();
+    m_includeGraphWatcher.setFuture(QtConcurrent::run([lintFile, parsedLintFile]()
+    {
+        auto graph = std::make_shared<Lint::IncludeGraph>();
+        auto const cacheFile = Lint::includeGraphCacheFile(lintFile);
+        graph->load(cacheFile);
+        graph->build(parsedLintFile, QFileInfo(lintFile).absolutePath());
+        graph->save(cacheFile);
+        return graph;
+    }));
+}
 
-    m_actionError->setText("Errors:" + QString::number(m_numberOfErrors));
-    m_actionWarning->setText("Warnings:" + QString::number(m_numberOfWarnings));
-    m_actionInformation->setText("Information:" + QString::number(m_numberOfInformations));
+void MainWindow::includeGraphBuilt() noexcept
+{
+    // A lint started since the graph was asked for makes it out of date
+    if (m_includeGraphRequest != m_includeGraphGeneration)
+    {
+        return;
+    }
+    m_includeGraph = m_includeGraphWatcher.result();
+    m_fileWatcher->addFiles(m_includeGraph->files());
+}
+
+void MainWindow::watchResults() noexcept
+{
+    // Translation units and every file with a message in it
+    QStringList files = m_lint->sourceFiles();
+    for (int file = 0; file < m_treeModel.fileCount(); file++)
+    {
+        files << m_treeModel.filePath(file);
+    }
+    m_fileWatcher->addFiles(files);
+}
+
+void MainWindow::slotFilesChanged(const QStringList& files) noexcept
+{
+    auto const loadedFile = QFileInfo(m_ui->m_codeEditor->loadedFile()).canonicalFilePath();
+
+    QStringList changedFiles;
+    for (auto const& file : files)
+    {
+        auto const canonicalFile = QFileInfo(file).canonicalFilePath();
+        qDebug() << "Changed on disk:" << file;
+
+        // Other open files are reloaded by the document cache when they are next shown
+        if (!loadedFile.isEmpty() && (canonicalFile == loadedFile))
+        {
+            m_ui->m_codeEditor->reloadFile();
+        }
+        changedFiles << canonicalFile;
+    }
+
+    // Until the include graph is ready only changed translation units are re-linted
+    auto modules = changedFiles;
+    if (m_includeGraph)
+    {
+        modules = m_includeGraph->update(changedFiles);
+        // Headers that are included now and weren't before
+        m_fileWatcher->addFiles(m_includeGraph->files());
+        qInfo() << "Changed files" << changedFiles << "affect" << modules.size() << "modules";
+    }
+
+    int sourceFiles = 0;
+    for (auto const& module : modules)
+    {
+        if (m_lintSourceFiles.contains(module))
+        {
+            m_relintQueue.insert(module);
+            sourceFiles++;
+        }
+    }
+
+    if ((sourceFiles > 0) && !m_relintRunning)
+    {
+        startRelint();
+    }
+}
+
+void MainWindow::startRelint() noexcept
+{
+    Q_ASSERT(!m_relintRunning);
+
+    m_relintFiles = m_relintQueue.values();
+    m_relintQueue.clear();
+    m_relintMessages.clear();
+
+    // The previous re-lint is finished with by now
+    m_relint = std::make_unique<Lint::PCLintPlus>(preferences().getLintExecutablePath().trimmed(), preferences().getLintFilePath().trimmed());
+    m_relint->setHardwareThreads(preferences().getLintHardwareThreads());
+    m_relint->setBaseline(m_baseline);
+    m_relint->setSourceFiles(m_relintFiles);
+
+    QObject::connect(m_relint.get(), &Lint::PCLintPlus::signalAddTreeParent, this, [this](const Lint::LintMessage& message)
+    {
+        m_relintMessages.push_back(message);
+    });
+    QObject::connect(m_relint.get(), &Lint::PCLintPlus::signalAddTreeChild, this, [this](const Lint::LintMessage& message)
+    {
+        m_relintMessages.push_back(message);
+    });
+
+    // Queued so it runs after the queued messages from the consumer thread
+    QObject::connect(m_relint.get(), &Lint::PCLintPlus::signalLintComplete, this, &MainWindow::slotRelintComplete, Qt::QueuedConnection);
+
+    qInfo() << "Re-linting" << m_relintFiles;
+    m_ui->statusBar->showMessage("Re-linting " + QString::number(m_relintFiles.size()) + " changed files");
+    m_relintRunning = true;
+    m_relint->lint();
+}
+
+void MainWindow::slotRelintComplete(const Lint::Status& lintStatus, const QString& errorMessage) noexcept
+{
+    qInfo() << "Re-lint finished with" << lintStatus;
+    m_relintRunning = false;
+
+    if ((lintStatus == Lint::Status::STATUS_COMPLETE) || (lintStatus == Lint::Status::STATUS_PARTIAL_COMPLETE))
+    {
+        mergeRelint();
+        m_ui->statusBar->showMessage("Re-linted " + QString::number(m_relintFiles.size()) + " changed files");
+    }
+    else if (lintStatus != Lint::Status::STATUS_ABORT)
+    {
+        qCritical() << "Re-lint failed:" << errorMessage;
+        m_ui->statusBar->showMessage("Re-lint failed: " + errorMessage);
+    }
+
+    // Files that changed while this one was running
+    if (!m_relintQueue.isEmpty())
+    {
+        startRelint();
+    }
+}
+
+void MainWindow::mergeRelint() noexcept
+{
+    const QSet<QString> relinted(m_relintFiles.begin(), m_relintFiles.end());
+
+    // Only the rows of the re-linted files are replaced, the rest of the tree is left alone
+    std::vector<int> files;
+    for (int file = 0; file < m_treeModel.fileCount(); file++)
+    {
+        if (relinted.contains(QFileInfo(m_treeModel.filePath(file)).canonicalFilePath()))
+        {
+            files.emplace_back(file);
+        }
+    }
+
+    int removed = 0;
+    for (auto const& message : m_treeModel.removeFiles(files))
+    {
+        m_sessionChanged = true;
+        updateMessageCount(message, -1);
+        m_statistics->removeMessage(message);
+        removed += (message.type != Lint::Type::TYPE_SUPPLEMENTAL) ? 1 : 0;
+    }
+
+    // A group reported again from a file that wasn't re-linted (e.g. a header) is already shown
+    auto const shown = [this](const Lint::LintMessage& message)
+    {
+        auto const file = m_treeModel.findFile(message.file);
+        if (file < 0)
+        {
+            return false;
+        }
+        auto const messages = m_treeModel.lineMessages(file, message.line, message.line);
+        return std::any_of(messages.first, messages.second, [this, &message](int index)
+        {
+            auto const& treeMessage = m_treeModel.message(index);
+            return (treeMessage.number == message.number) && (treeMessage.description == message.description);
+        });
+    };
+
+    int added = 0;
+    bool skipGroup = false;
+    for (auto const& message : m_relintMessages)
+    {
+        if (message.type != Lint::Type::TYPE_SUPPLEMENTAL)
+        {
+            skipGroup = shown(message);
+            if (!skipGroup)
+            {
+                added++;
+                slotAddTreeParent(message);
+            }
+        }
+        else if (!skipGroup)
+        {
+            slotAddTreeChild(message);
+        }
+    }
+    qInfo() << "Replaced" << removed << "messages with" << added << "from the re-lint";
+
+    // Put back the order the user chose
+    auto const* header = m_ui->m_lintTree->header();
+    if (m_ui->m_lintTree->isSortingEnabled())
+    {
+        m_treeModel.sort(header->sortIndicatorSection(), header->sortIndicatorOrder());
+    }
+
+    // New files with messages
+    watchResults();
+}
+
+void MainWindow::startLint(QString)
+{
+    resetMessageCount();
+    replaceResults();
 
     clearTreeNodes();
+    m_statistics->clear();
 
     m_progressWindow = std::make_unique<ProgressWindow>(this);
-    m_lint = std::make_unique<Lint::PCLintPlus>(m_preferences->getLintExecutablePath().trimmed(), m_preferences->getLintFilePath().trimmed());
+    m_lint = std::make_unique<Lint::PCLintPlus>(preferences().getLintExecutablePath().trimmed(), preferences().getLintFilePath().trimmed());
 
-    m_lint->setHardwareThreads(m_preferences->getLintHardwareThreads());
+    // Adaptive mode gives lint the CPUs that were idle since the last look
+    if (preferences().getAdaptiveConcurrency())
+    {
+        auto const threads = Lint::adaptiveLintThreads(QThread::idealThreadCount(), m_loadMonitor.sample());
+        qInfo() << "Adaptive lint threads:" << threads;
+        m_lint->setHardwareThreads(threads);
+    }
+    else
+    {
+        m_lint->setHardwareThreads(preferences().getLintHardwareThreads());
+    }
+    m_lint->setBaseline(m_baseline);
+    m_lint->setWorkers(preferences().getWorkers(), preferences().getWorkerToken());
 
     QObject::connect(m_progressWindow.get(), &ProgressWindow::signalLintComplete, this, &MainWindow::slotLintComplete);
     QObject::connect(m_lint.get(), &Lint::PCLintPlus::signalLintComplete, m_progressWindow.get(), &ProgressWindow::slotLintComplete);
@@ -407,12 +836,40 @@ void MainWindow::startLint(QString)
     QObject::connect(m_lint.get(), &Lint::PCLintPlus::signalAddTreeChild, this, &MainWindow::slotAddTreeChild);
 
     m_progressWindow->setTitle(m_lint->getLintFile());
+    m_progressWindow->setMetricsSource([this]()
+    {
+        return PipelineSample{m_lint->metrics(), m_treeModel.messageCount()};
+    });
     m_progressWindow->show();
     m_lint->lint();
     m_progressWindow->setModal(true);
 
 }
 
+void MainWindow::replaceResults() noexcept
+{
+    // Results from anywhere else aren't one of the workspace projects
+    m_projectAction->setVisible(false);
+
+    // New results replace anything being re-linted
+    m_fileWatcher->clear();
+    m_includeGraph.reset();
+    m_includeGraphGeneration++;
+    m_relintQueue.clear();
+    if (m_relint)
+    {
+        QObject::disconnect(m_relint.get(), nullptr, this, nullptr);
+        m_relint->slotAbortLint(true);
+        m_relintRunning = false;
+    }
+
+    // Keep the results about to be cleared so the new run can be compared against them
+    if (m_treeModel.messageCount() > 0)
+    {
+        m_previousRun = currentRun();
+    }
+}
+
 void MainWindow::on_aboutLint_triggered()
 {
     m_about.display();
@@ -447,7 +904,7 @@ void MainWindow::on_actionLint_triggered()
 }
 
 
-void MainWindow::on_m_lintTree_clicked(const QModelIndex&)
+void MainWindow::on_m_lintTree_clicked(const QModelIndex& index)
 {
     QModelIndexList selection = m_ui->m_lintTree->selectionModel()->selectedIndexes();
     // 4 columns only
@@ -459,6 +916,20 @@ void MainWindow::on_m_lintTree_clicked(const QModelIndex&)
 
     qDebug() << fileToLoad;
 
+    // Group rows have no message number
+    bool isNumber = false;
+    auto const number = selection[Lint::LINT_TABLE_NUMBER_COLUMN].data(Qt::DisplayRole).toInt(&isNumber);
+    if (isNumber)
+    {
+        m_messageHelp->showMessage(number);
+    }
+
+    openFile(fileToLoad, lineNumber.toInt());
+    prefetchNeighbours(index);
+}
+
+void MainWindow::openFile(const QString& fileToLoad, int lineNumber) noexcept
+{
     if (!fileToLoad.isEmpty())
     {
         // TODO:
@@ -478,10 +949,12 @@ void MainWindow::on_m_lintTree_clicked(const QModelIndex&)
                 qInfo() << "Loading file: " << fileToLoad;
 
                 // Select the line number
-                if (!lineNumber.isEmpty())
+                if (lineNumber > 0)
                 {
-                    m_ui->m_codeEditor->selectLine(lineNumber.toUInt());
+                    m_ui->m_codeEditor->selectLine(lineNumber);
                 }
+                showTab(fileToLoad);
+
                 // Update the status bar
                 m_ui->statusBar->showMessage("Loaded " + fileToLoad + " at " + QDateTime::currentDateTime().toString());
             }
@@ -494,10 +967,637 @@ void MainWindow::on_m_lintTree_clicked(const QModelIndex&)
         else
         {
             // Select the line number
-            if (!lineNumber.isEmpty())
+            if (lineNumber > 0)
             {
-                m_ui->m_codeEditor->selectLine(lineNumber.toUInt());
+                m_ui->m_codeEditor->selectLine(lineNumber);
             }
         }
     }
 }
+
+void MainWindow::showTab(const QString& file) noexcept
+{
+    // Selecting the tab would load the file again
+    const QSignalBlocker blocker(m_editorTabs.get());
+
+    for (int i = 0; i < m_editorTabs->count(); i++)
+    {
+        if (m_editorTabs->tabData(i).toString() == file)
+        {
+            m_editorTabs->setCurrentIndex(i);
+            return;
+        }
+    }
+
+    auto const index = m_editorTabs->addTab(QFileInfo(file).fileName());
+    m_editorTabs->setTabData(index, file);
+    m_editorTabs->setTabToolTip(index, file);
+    m_editorTabs->setCurrentIndex(index);
+}
+
+void MainWindow::closeTab(int index) noexcept
+{
+    auto const file = m_editorTabs->tabData(index).toString();
+
+    if (m_ui->m_codeEditor->isFileModified(file))
+    {
+        auto const answer = QMessageBox::question(this, "Unsaved changes", "Save changes to " + QFileInfo(file).fileName() + "?",
+                                                  QMessageBox::Yes | QMessageBox::No | QMessageBox::Cancel);
+        if (answer == QMessageBox::Cancel)
+        {
+            return;
+        }
+        else if (answer == QMessageBox::Yes)
+        {
+            openFile(file, 0);
+            save();
+        }
+    }
+
+    // Closing the shown file clears the editor, removing its tab then shows the next one
+    m_ui->m_codeEditor->closeFile(file);
+    m_editorTabs->removeTab(index);
+}
+
+void MainWindow::prefetchNeighbours(const QModelIndex& index) noexcept
+{
+    auto const currentFile = index.sibling(index.row(), Lint::LINT_TABLE_FILE_COLUMN).data(Lint::LINT_ROLE_FILE_PATH).toString();
+
+    // Walk the tree in display order both ways so moving to the next file doesn't stall on a reload
+    for (auto const below : {true, false})
+    {
+        auto neighbour = index;
+        auto lastFile = currentFile;
+        int files = 0;
+
+        for (int i = 0; (i < Lint::DOCUMENT_PREFETCH_SEARCH) && (files < Lint::DOCUMENT_PREFETCH_FILES); i++)
+        {
+            neighbour = below ? m_ui->m_lintTree->indexBelow(neighbour) : m_ui->m_lintTree->indexAbove(neighbour);
+            if (!neighbour.isValid())
+            {
+                break;
+            }
+
+            auto const file = neighbour.sibling(neighbour.row(), Lint::LINT_TABLE_FILE_COLUMN).data(Lint::LINT_ROLE_FILE_PATH).toString();
+            if (!file.isEmpty() && (file != lastFile))
+            {
+                m_ui->m_codeEditor->prefetchFile(file);
+                lastFile = file;
+                files++;
+            }
+        }
+    }
+}
+
+Lint::Snapshot MainWindow::currentRun() const noexcept
+{
+    Lint::Snapshot snapshot;
+    for (int i = 0; i < m_treeModel.messageCount(); i++)
+    {
+        auto const& message = m_treeModel.message(i);
+        snapshot.append(Lint::LintMessage{m_treeModel.filePath(message.file), message.line,
+                                          Lint::messageTypeName(message.type), message.number, message.description});
+    }
+    return snapshot;
+}
+
+void MainWindow::showDiff(const Lint::Snapshot& previous) noexcept
+{
+    if (!m_diffWindow)
+    {
+        m_diffWindow = std::make_unique<Lint::DiffWindow>(this);
+        QObject::connect(m_diffWindow.get(), &Lint::DiffWindow::signalOpenMessage, this, &MainWindow::openFile);
+    }
+    m_diffWindow->setRuns(previous, currentRun(), QFileInfo(preferences().getLintFilePath().trimmed()).absolutePath());
+    m_diffWindow->show();
+    m_diffWindow->raise();
+}
+
+void MainWindow::on_actionSaveSnapshot_triggered()
+{
+    auto const fileName = QFileDialog::getSaveFileName(this, "Save results snapshot", Preferences::m_lastDirectory, "PC-Lint GUI snapshot (*.snapshot)");
+    if (fileName.isEmpty())
+    {
+        return;
+    }
+
+    if (!currentRun().save(fileName))
+    {
+        QMessageBox::critical(this, "Error", "Unable to save snapshot: " + fileName);
+    }
+}
+
+void MainWindow::on_actionComparePreviousRun_triggered()
+{
+    if (m_previousRun.isEmpty())
+    {
+        QMessageBox::information(this, "Information", "There is no previous run to compare against");
+        return;
+    }
+    showDiff(m_previousRun);
+}
+
+void MainWindow::on_actionCompareSnapshot_triggered()
+{
+    auto const fileName = QFileDialog::getOpenFileName(this, "Compare with snapshot", Preferences::m_lastDirectory, "PC-Lint GUI snapshot (*.snapshot)");
+    if (fileName.isEmpty())
+    {
+        return;
+    }
+
+    Lint::Snapshot snapshot;
+    if (!snapshot.load(fileName))
+    {
+        QMessageBox::critical(this, "Error", "Unable to load snapshot: " + fileName);
+        return;
+    }
+    showDiff(snapshot);
+}
+
+void MainWindow::setBaseline(const Lint::LintMessages& messages) noexcept
+{
+    m_baseline = std::make_shared<const Lint::Baseline>(messages, QFileInfo(preferences().getLintFilePath().trimmed()).absolutePath());
+    qInfo() << "Baseline set with" << m_baseline->size() << "messages";
+    m_ui->statusBar->showMessage("Baseline set with " + QString::number(m_baseline->size()) + " messages, they will be hidden from the next lint");
+}
+
+void MainWindow::on_actionBaselineFromResults_triggered()
+{
+    if (m_treeModel.messageCount() == 0)
+    {
+        QMessageBox::information(this, "Information", "There are no results to use as a baseline");
+        return;
+    }
+    setBaseline(currentRun().messages());
+}
+
+void MainWindow::on_actionBaselineFromSnapshot_triggered()
+{
+    auto const fileName = QFileDialog::getOpenFileName(this, "Baseline snapshot", Preferences::m_lastDirectory, "PC-Lint GUI snapshot (*.snapshot)");
+    if (fileName.isEmpty())
+    {
+        return;
+    }
+
+    Lint::Snapshot snapshot;
+    if (!snapshot.load(fileName))
+    {
+        QMessageBox::critical(this, "Error", "Unable to load snapshot: " + fileName);
+        return;
+    }
+    setBaseline(snapshot.messages());
+}
+
+void MainWindow::on_actionClearBaseline_triggered()
+{
+    m_baseline.reset();
+    m_ui->statusBar->showMessage("Baseline cleared");
+}
+
+void MainWindow::on_actionSuppressions_triggered()
+{
+    showSuppressions();
+}
+
+void MainWindow::on_actionImportCompileCommands_triggered()
+{
+    if (m_importWatcher.isRunning())
+    {
+        return;
+    }
+
+    auto const compileCommands = QFileDialog::getOpenFileName(this, "Import compilation database", Preferences::m_lastDirectory, "Compilation database (compile_commands.json);;JSON (*.json)");
+    if (compileCommands.isEmpty())
+    {
+        return;
+    }
+    Preferences::m_lastDirectory = QFileInfo(compileCommands).absolutePath();
+
+    auto const lintFile = QFileDialog::getSaveFileName(this, "Save generated lint file", QFileInfo(compileCommands).dir().filePath("project.lnt"), "PC-Lint/PC-Lint Plus file (*.lnt)");
+    if (lintFile.isEmpty())
+    {
+        return;
+    }
+
+    // Each shard is a lint file that can be linted on its own
+    bool ok = false;
+    auto const shards = QInputDialog::getInt(this, "Import compilation database", "Number of lint files to split the modules over:",
+                                             1, 1, QThread::idealThreadCount() * 4, 1, &ok);
+    if (!ok)
+    {
+        return;
+    }
+
+    // The compiler and library options still come from a hand written lint file
+    QString baseLintFile;
+    if (QMessageBox::question(this, "Import compilation database", "Include a base lint file (compiler and library options) in the generated lint file?") == QMessageBox::Yes)
+    {
+        baseLintFile = QFileDialog::getOpenFileName(this, "Select base lint file", Preferences::m_lastDirectory, "PC-Lint/PC-Lint Plus file (*.lnt)");
+    }
+
+    m_ui->actionImportCompileCommands->setEnabled(false);
+    QObject::connect(&m_importWatcher, &QFutureWatcher<Lint::CompileCommandsImport>::finished, this, &MainWindow::importComplete, Qt::UniqueConnection);
+    m_importWatcher.setFuture(QtConcurrent::run([compileCommands, lintFile, shards, baseLintFile]()
+    {
+        return Lint::importCompileCommands(compileCommands, lintFile, shards, baseLintFile);
+    }));
+}
+
+void MainWindow::importComplete() noexcept
+{
+    m_ui->actionImportCompileCommands->setEnabled(true);
+
+    auto const result = m_importWatcher.result();
+    if (!result.error.isEmpty())
+    {
+        QMessageBox::critical(this, "Error", result.error);
+        return;
+    }
+
+    auto const summary = QString("Imported %1 translation units with %2 different option sets into %3 lint file(s).")
+        .arg(result.translationUnits).arg(result.optionSets).arg(result.lintFiles.size());
+    if (result.lintFiles.size() == 1)
+    {
+        if (QMessageBox::question(this, "Import compilation database", summary + "\n\nLint " + QDir::toNativeSeparators(result.lintFiles.front()) + " from now on?") == QMessageBox::Yes)
+        {
+            preferences().setLintFilePath(result.lintFiles.front());
+        }
+        return;
+    }
+
+    // Shards are linted together as a workspace, saved next to them so Lint Workspace can run it again
+    Lint::WorkspaceProjects projects;
+    for (auto const& lintFile : result.lintFiles)
+    {
+        projects.push_back(Lint::WorkspaceProject{QFileInfo(lintFile).completeBaseName(), QString(), lintFile});
+    }
+    // project_1.lnt -> project.lintws
+    const QFileInfo firstShard(result.lintFiles.front());
+    auto const workspaceFile = firstShard.dir().filePath(firstShard.completeBaseName().section('_', 0, -2) + ".lintws");
+    if (QMessageBox::question(this, "Import compilation database", summary + "\n\nLint them now as the workspace " + QDir::toNativeSeparators(workspaceFile) + "?") != QMessageBox::Yes)
+    {
+        return;
+    }
+
+    QString error;
+    if (!Lint::writeWorkspace(workspaceFile, projects, error))
+    {
+        QMessageBox::critical(this, "Error", "Unable to save workspace: " + error);
+    }
+    if (m_scheduler->isRunning())
+    {
+        QMessageBox::information(this, "Information", "A workspace is already being linted");
+        return;
+    }
+    lintWorkspace(projects);
+}
+
+void MainWindow::on_actionOpenResults_triggered()
+{
+    if (m_resultsWatcher.isRunning())
+    {
+        return;
+    }
+
+    auto const fileName = QFileDialog::getOpenFileName(this, "Open lint results", Preferences::m_lastDirectory, "PC-Lint Plus XML output (*.xml);;All files (*)");
+    if (fileName.isEmpty())
+    {
+        return;
+    }
+    Preferences::m_lastDirectory = QFileInfo(fileName).absolutePath();
+
+    m_ui->actionOpenResults->setEnabled(false);
+    m_ui->statusBar->showMessage("Reading " + QDir::toNativeSeparators(fileName));
+    m_resultsTimer.start();
+
+    auto const baseline = m_baseline;
+    QObject::connect(&m_resultsWatcher, &QFutureWatcher<Lint::ResultsFile>::finished, this, &MainWindow::resultsOpened, Qt::UniqueConnection);
+    m_resultsWatcher.setFuture(QtConcurrent::run([fileName, baseline]()
+    {
+        return Lint::readResultsFile(fileName, baseline);
+    }));
+}
+
+void MainWindow::resultsOpened() noexcept
+{
+    m_ui->actionOpenResults->setEnabled(true);
+
+    auto const results = m_resultsWatcher.result();
+    if (!results.error.isEmpty())
+    {
+        m_ui->statusBar->clearMessage();
+        QMessageBox::critical(this, "Error", results.error);
+        return;
+    }
+
+    replaceResults();
+    showMessages(results.messages);
+    m_ui->statusBar->showMessage(QString("Opened %1 messages (%2 unique) in %3 ms")
+                                 .arg(results.parsedMessages).arg(results.messages.size()).arg(m_resultsTimer.elapsed()));
+}
+
+void MainWindow::on_actionLintWorkspace_triggered()
+{
+    if (m_scheduler->isRunning())
+    {
+        QMessageBox::information(this, "Information", "A workspace is already being linted");
+        return;
+    }
+
+    auto const files = QFileDialog::getOpenFileNames(this, "Lint workspace", Preferences::m_lastDirectory,
+                                                     "PC-Lint GUI workspace (*.lintws);;PC-Lint/PC-Lint Plus files (*.lnt)");
+    if (files.isEmpty())
+    {
+        return;
+    }
+    Preferences::m_lastDirectory = QFileInfo(files.front()).absolutePath();
+
+    // Either a saved workspace or a project per lint file
+    Lint::WorkspaceProjects projects;
+    QString error;
+    if ((files.size() == 1) && files.front().endsWith(".lintws", Qt::CaseInsensitive))
+    {
+        if (!Lint::readWorkspace(files.front(), projects, error))
+        {
+            QMessageBox::critical(this, "Error", "Unable to open workspace: " + error);
+            return;
+        }
+    }
+    else
+    {
+        for (auto const& file : files)
+        {
+            projects.push_back(Lint::WorkspaceProject{QFileInfo(file).completeBaseName(), QString(), file});
+        }
+
+        auto const workspaceFile = QFileDialog::getSaveFileName(this, "Save workspace (cancel to lint without saving)",
+                                                                Preferences::m_lastDirectory, "PC-Lint GUI workspace (*.lintws)");
+        if (!workspaceFile.isEmpty() && !Lint::writeWorkspace(workspaceFile, projects, error))
+        {
+            QMessageBox::critical(this, "Error", "Unable to save workspace: " + error);
+        }
+    }
+
+    lintWorkspace(projects);
+}
+
+void MainWindow::lintWorkspace(const Lint::WorkspaceProjects& projects) noexcept
+{
+    auto const lintExecutable = preferences().getLintExecutablePath().trimmed();
+    auto const needsExecutable = std::any_of(projects.cbegin(), projects.cend(), [](const Lint::WorkspaceProject& project)
+    {
+        return project.lintExecutable.isEmpty();
+    });
+    if (needsExecutable && lintExecutable.isEmpty())
+    {
+        QMessageBox::critical(this, "Error", "No PC-Lint/PC-Lint Plus executable specified in Preferences");
+        return;
+    }
+
+    replaceResults();
+    clearTreeNodes();
+    m_statistics->clear();
+    resetMessageCount();
+
+    m_projectComboBox->clear();
+    for (auto const& project : projects)
+    {
+        m_projectComboBox->addItem(project.name + " (waiting)");
+    }
+    m_projectAction->setVisible(true);
+
+    // One thread budget for the whole workspace rather than one per project
+    m_ui->actionLintWorkspace->setEnabled(false);
+    m_scheduler->setAdaptive(preferences().getAdaptiveConcurrency());
+    m_scheduler->start(projects, lintExecutable, preferences().getLintHardwareThreads(), m_baseline);
+}
+
+void MainWindow::projectStarted(int project, int threads) noexcept
+{
+    m_projectComboBox->setItemText(project, m_scheduler->project(project).name + " (linting)");
+    m_ui->statusBar->showMessage(QString("Linting %1 with %2 threads").arg(m_scheduler->project(project).name).arg(threads));
+}
+
+void MainWindow::projectComplete(int project) noexcept
+{
+    auto const& name = m_scheduler->project(project).name;
+    auto const status = m_scheduler->status(project);
+    if ((status == Lint::Status::STATUS_COMPLETE) || (status == Lint::Status::STATUS_PARTIAL_COMPLETE))
+    {
+        m_projectComboBox->setItemText(project, QString("%1 (%2 messages)").arg(name).arg(m_scheduler->messages(project).size()));
+    }
+    else
+    {
+        qCritical() << "Project" << name << "failed:" << m_scheduler->errorMessage(project);
+        m_projectComboBox->setItemText(project, name + " (failed)");
+    }
+
+    // Results show up as soon as the selected project is done
+    if (m_projectAction->isVisible() && (project == m_projectComboBox->currentIndex()))
+    {
+        showProject(project);
+    }
+    m_ui->statusBar->showMessage(QString("Linted %1 of %2 projects").arg(m_scheduler->completedProjects()).arg(m_scheduler->projectCount()));
+}
+
+void MainWindow::workspaceComplete() noexcept
+{
+    m_ui->actionLintWorkspace->setEnabled(true);
+
+    QStringList failed;
+    for (int project = 0; project < m_scheduler->projectCount(); project++)
+    {
+        auto const status = m_scheduler->status(project);
+        if ((status != Lint::Status::STATUS_COMPLETE) && (status != Lint::Status::STATUS_PARTIAL_COMPLETE))
+        {
+            failed << m_scheduler->project(project).name + ": " + m_scheduler->errorMessage(project);
+        }
+    }
+
+    if (!failed.isEmpty())
+    {
+        QMessageBox::critical(this, "Error", "Some projects could not be linted:\n\n" + failed.join('\n'));
+    }
+    m_ui->statusBar->showMessage(QString("Linted %1 projects, %2 distinct strings use %3")
+                                 .arg(m_scheduler->projectCount()).arg(m_strings->size())
+                                 .arg(QLocale().formattedDataSize(m_strings->bytes())));
+}
+
+void MainWindow::showProject(int project) noexcept
+{
+    if ((project < 0) || (project >= m_scheduler->projectCount()))
+    {
+        return;
+    }
+
+    // Projects still linting have nothing to show yet
+    auto const status = m_scheduler->status(project);
+    if ((status == Lint::Status::STATUS_COMPLETE) || (status == Lint::Status::STATUS_PARTIAL_COMPLETE))
+    {
+        showMessages(m_scheduler->messages(project));
+    }
+    else
+    {
+        clearTreeNodes();
+        m_statistics->clear();
+        resetMessageCount();
+    }
+}
+
+void MainWindow::on_actionExportTrace_triggered()
+{
+    if (Lint::Trace::spanCount() == 0)
+    {
+        QMessageBox::information(this, "Information", "Nothing has been traced, turn on \"Record a pipeline trace\" in Preferences and lint again");
+        return;
+    }
+
+    auto const fileName = QFileDialog::getSaveFileName(this, "Export trace", Preferences::m_lastDirectory, "Chrome trace (*.json)");
+    if (fileName.isEmpty())
+    {
+        return;
+    }
+
+    if (!Lint::Trace::exportChromeTrace(fileName))
+    {
+        QMessageBox::critical(this, "Error", "Unable to export trace: " + fileName);
+        return;
+    }
+    m_ui->statusBar->showMessage("Trace exported to " + fileName + ", open it in chrome://tracing or ui.perfetto.dev");
+}
+
+void MainWindow::on_actionExportResults_triggered()
+{
+    if (m_treeModel.messageCount() == 0)
+    {
+        QMessageBox::information(this, "Information", "There are no results to export");
+        return;
+    }
+
+    auto const fileName = QFileDialog::getSaveFileName(this, "Export results", Preferences::m_lastDirectory,
+                                                       "SARIF (*.sarif);;CSV (*.csv);;JSON Lines (*.jsonl)");
+    Lint::ExportFormat format;
+    if (fileName.isEmpty())
+    {
+        return;
+    }
+    if (!Lint::exportFormatForFile(fileName, format))
+    {
+        QMessageBox::critical(this, "Error", "Unknown export format, use .sarif, .csv or .jsonl: " + fileName);
+        return;
+    }
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        QMessageBox::critical(this, "Error", "Unable to export results: " + file.errorString());
+        return;
+    }
+
+    // Written straight from the model so the results are never copied
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    Lint::ResultExporter exporter(file, format);
+    Lint::LintMessage message;
+    for (int i = 0; i < m_treeModel.messageCount(); i++)
+    {
+        auto const& treeMessage = m_treeModel.message(i);
+        message.file = m_treeModel.filePath(treeMessage.file);
+        message.line = treeMessage.line;
+        message.type = Lint::messageTypeName(treeMessage.type);
+        message.number = treeMessage.number;
+        message.description = treeMessage.description;
+        exporter.write(message);
+    }
+    auto const exported = exporter.finish() && file.commit();
+    QApplication::restoreOverrideCursor();
+
+    if (!exported)
+    {
+        QMessageBox::critical(this, "Error", "Unable to export results: " + file.errorString());
+        return;
+    }
+    m_ui->statusBar->showMessage("Exported " + QString::number(exporter.resultCount()) + " messages to " + fileName);
+}
+
+void MainWindow::showSuppressions() noexcept
+{
+    if (!m_suppressionWindow)
+    {
+        m_suppressionWindow = std::make_unique<Lint::SuppressionWindow>(this);
+        QObject::connect(m_suppressionWindow.get(), &Lint::SuppressionWindow::signalSuppressionsChanged, this, &MainWindow::slotSuppressionsChanged);
+        m_suppressionWindow->setLintFile(preferences().getLintFilePath().trimmed());
+    }
+    m_suppressionWindow->show();
+    m_suppressionWindow->raise();
+}
+
+void MainWindow::slotSuppressionsChanged(std::shared_ptr<const Lint::SuppressionFilter> filter) noexcept
+{
+    m_suppressions = filter->isEmpty() ? nullptr : std::move(filter);
+    m_proxyModel.setSuppressions(m_suppressions);
+
+    // How many of the current results would go away
+    int hidden = 0;
+    if (m_suppressions)
+    {
+        for (int i = 0; i < m_treeModel.messageCount(); i++)
+        {
+            auto const& message = m_treeModel.message(i);
+            if ((message.type != Lint::MESSAGE_SUPPLEMENTAL) &&
+                m_suppressions->suppresses(message.number, m_treeModel.filePath(message.file), message.description))
+            {
+                hidden++;
+            }
+        }
+    }
+    m_suppressionWindow->setHiddenCount(hidden);
+    m_ui->statusBar->showMessage(QString::number(hidden) + " messages hidden by suppressions");
+}
+
+void MainWindow::showLintTreeMenu(const QPoint& position) noexcept
+{
+    auto const index = m_ui->m_lintTree->indexAt(position);
+    if (!index.isValid())
+    {
+        return;
+    }
+
+    // Group rows have no message number
+    bool isNumber = false;
+    auto const number = index.sibling(index.row(), Lint::LINT_TABLE_NUMBER_COLUMN).data().toInt(&isNumber);
+    if (!isNumber)
+    {
+        return;
+    }
+    auto const fileName = QFileInfo(index.data(Lint::LINT_ROLE_FILE_PATH).toString()).fileName();
+    auto const description = index.sibling(index.row(), Lint::LINT_TABLE_DESCRIPTION_COLUMN).data().toString();
+
+    auto const addSuppression = [this](const QString& text, const QString& option)
+    {
+        QObject::connect(m_m_lintTreeMenu->addAction(text), &QAction::triggered, this, [this, option]()
+        {
+            showSuppressions();
+            m_suppressionWindow->addSuppression(option);
+        });
+    };
+
+    m_m_lintTreeMenu->clear();
+    addSuppression("Suppress message " + QString::number(number), "-e" + QString::number(number));
+
+    // First quoted name in the description is usually the symbol the message is about
+    auto const symbolStart = description.indexOf('\'');
+    auto const symbolEnd = description.indexOf('\'', symbolStart + 1);
+    auto const symbol = (symbolStart >= 0) && (symbolEnd > symbolStart + 1) ? description.mid(symbolStart + 1, symbolEnd - symbolStart - 1) : QString();
+    if (!symbol.isEmpty() && !symbol.contains(QRegularExpression("[(),]")))
+    {
+        Lint::Suppression suppression{Lint::SUPPRESS_SYMBOL, QString::number(number), {symbol}};
+        addSuppression("Suppress message " + QString::number(number) + " for '" + symbol + "'", Lint::suppressionOption(suppression));
+    }
+    if (!fileName.isEmpty())
+    {
+        Lint::Suppression suppression{Lint::SUPPRESS_FILE, QString::number(number), {fileName}};
+        addSuppression("Suppress message " + QString::number(number) + " in " + fileName, Lint::suppressionOption(suppression));
+    }
+
+    m_m_lintTreeMenu->popup(m_ui->m_lintTree->viewport()->mapToGlobal(position));
+}
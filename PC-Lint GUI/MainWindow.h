@@ -30,7 +30,14 @@
 #include <QLoggingCategory>
 #include <QApplication>
 #include <QScreen>
-#include <QStandardItemModel>
+#include <QComboBox>
+#include <QTabBar>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QDockWidget>
+#include <QSortFilterProxyModel>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
 
 #include "ProgressWindow.h"
 #include "Preferences.h"
@@ -39,7 +46,21 @@
 #include "CodeEditor.h"
 #include "Highlighter.h"
 #include "About.h"
-
+#include "TreeModel.h"
+#include "StatisticsWindow.h"
+#include "Snapshot.h"
+#include "DiffWindow.h"
+#include "FileWatcher.h"
+#include "MessageHelpWindow.h"
+#include "SuppressionWindow.h"
+#include "CompileCommands.h"
+#include "IncludeGraph.h"
+#include "Trace.h"
+#include "ResultsFile.h"
+#include "Workspace.h"
+
+// Results of the last session, kept in the application data directory
+const QString SESSION_FILE_NAME = "last-session.snapshot";
 
 class LintSortFilterProxyModel : public QSortFilterProxyModel
 {
@@ -51,32 +72,49 @@ public:
         m_toggleWarning = toggleWarning;
         m_toggleInformation = toggleInformation;
     }
+    void setSuppressions(std::shared_ptr<const Lint::SuppressionFilter> suppressions)
+    {
+        m_suppressions = std::move(suppressions);
+        invalidateFilter();
+    }
     bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const noexcept override
     {
-        // Taken from StackOverflow
-        QStandardItemModel* source = static_cast<QStandardItemModel*>(sourceModel());
-        QModelIndex modelIndex = source->index(sourceRow, Lint::LINT_TABLE_DESCRIPTION_COLUMN, sourceParent);
-        QStandardItem* item = source->itemFromIndex(modelIndex);
+        QModelIndex modelIndex = sourceModel()->index(sourceRow, Lint::LINT_TABLE_DESCRIPTION_COLUMN, sourceParent);
+        auto const messageType = static_cast<Lint::Message>(modelIndex.data(Lint::LINT_ROLE_MESSAGE_TYPE).toInt());
 
-        auto const messageType = item->data(Qt::UserRole).value<QString>();
+        // Suppressions being tried out
+        if (m_suppressions && (messageType != Lint::MESSAGE_UNKNOWN))
+        {
+            auto const number = sourceModel()->index(sourceRow, Lint::LINT_TABLE_NUMBER_COLUMN, sourceParent).data().toInt();
+            if (m_suppressions->suppresses(number, modelIndex.data(Lint::LINT_ROLE_FILE_PATH).toString(), modelIndex.data().toString()))
+            {
+                return false;
+            }
+        }
 
         // Filter messages as needed
         bool filter = true;
-        if (!m_toggleInformation && (messageType == Lint::Type::TYPE_INFORMATION))
+        if (!m_toggleInformation && (messageType == Lint::MESSAGE_INFORMATION))
         {
             filter = false;
         }
-        else if (!m_toggleError && (messageType == Lint::Type::TYPE_ERROR))
+        else if (!m_toggleError && (messageType == Lint::MESSAGE_ERROR))
         {
             filter = false;
         }
-        else if (!m_toggleWarning && (messageType == Lint::Type::TYPE_WARNING))
+        else if (!m_toggleWarning && (messageType == Lint::MESSAGE_WARNING))
         {
             filter = false;
         }
 
         return filter;
     }
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override
+    {
+        // The source model sorts on typed keys (off the GUI thread for large results)
+        // so the proxy itself always stays in source order
+        sourceModel()->sort(column, order);
+    }
     LintSortFilterProxyModel() : m_toggleError(false), m_toggleWarning(false), m_toggleInformation(false)
     {
 
@@ -85,6 +123,7 @@ private:
     bool m_toggleError;
     bool m_toggleWarning;
     bool m_toggleInformation;
+    std::shared_ptr<const Lint::SuppressionFilter> m_suppressions;
 
 };
 
@@ -105,6 +144,12 @@ class MainWindow : public QMainWindow
 public:
     explicit MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
+    // Load the settings and the last session's results once the window is up
+    // startupTimer was started when the process started
+    void startSession(const QElapsedTimer& startupTimer) noexcept;
+
+protected:
+    void closeEvent(QCloseEvent* event) override;
 
 public slots:
     void slotLintComplete(const Lint::Status& lintStatus, const QString& errorMessage) noexcept;
@@ -112,6 +157,8 @@ public slots:
 
     void slotAddTreeParent(const Lint::LintMessage& parentMessage) noexcept;
     void slotAddTreeChild(const Lint::LintMessage& childMessage) noexcept;
+    void slotFilesChanged(const QStringList& files) noexcept;
+    void slotRelintComplete(const Lint::Status& lintStatus, const QString& errorMessage) noexcept;
 
 
 private slots:
@@ -124,6 +171,19 @@ private slots:
     //void on_m_lintTree_itemClicked(QTreeWidgetItem *item, int column);
 
     void on_m_lintTree_clicked(const QModelIndex &index);
+    void on_actionSaveSnapshot_triggered();
+    void on_actionComparePreviousRun_triggered();
+    void on_actionCompareSnapshot_triggered();
+    void on_actionBaselineFromResults_triggered();
+    void on_actionBaselineFromSnapshot_triggered();
+    void on_actionClearBaseline_triggered();
+    void on_actionSuppressions_triggered();
+    void on_actionImportCompileCommands_triggered();
+    void on_actionExportTrace_triggered();
+    void on_actionExportResults_triggered();
+    void on_actionOpenResults_triggered();
+    void on_actionLintWorkspace_triggered();
+    void slotSuppressionsChanged(std::shared_ptr<const Lint::SuppressionFilter> filter) noexcept;
 
 public:
     void startLint(QString title);
@@ -137,12 +197,22 @@ private:
     std::unique_ptr<QAction> m_actionError;
     std::unique_ptr<QAction> m_actionWarning;
     std::unique_ptr<QAction> m_actionInformation;
+    std::unique_ptr<QWidget> m_editorContainer;
+    std::unique_ptr<QTabBar> m_editorTabs;
+    std::unique_ptr<QWidget> m_lintTreeContainer;
+    std::unique_ptr<QToolBar> m_groupByToolbar;
+    std::unique_ptr<QComboBox> m_groupByComboBox;
+    std::unique_ptr<QDockWidget> m_statisticsDock;
+    std::unique_ptr<Lint::StatisticsWindow> m_statistics;
+    std::unique_ptr<QDockWidget> m_messageHelpDock;
+    std::unique_ptr<Lint::MessageHelpWindow> m_messageHelp;
     bool m_toggleError;
     bool m_toggleWarning;
     bool m_toggleInformation;
     QString m_lastProjectLoaded;
+    // Created the first time it's needed, building the dialog isn't free
     std::unique_ptr<Preferences> m_preferences;
-    std::unique_ptr<Lint::Highlighter> m_highlighter;
+    Preferences& preferences() noexcept;
 
     std::unique_ptr<QMenu> m_m_lintTreeMenu;
 
@@ -160,10 +230,94 @@ private:
     std::unique_ptr<Lint::PCLintPlus> m_lint;
     std::unique_ptr<ProgressWindow> m_progressWindow;
 
-    auto createTreeNodes(const Lint::LintMessage& message) noexcept;
-    QStandardItemModel m_treeModel;
-    QStandardItem* m_parent;
+    void updateMessageCount(const Lint::LintMessage& message, int count = 1) noexcept;
+    void openFile(const QString& file, int line) noexcept;
+    void showTab(const QString& file) noexcept;
+    void closeTab(int index) noexcept;
+    void prefetchNeighbours(const QModelIndex& index) noexcept;
+    Lint::Snapshot currentRun() const noexcept;
+    void showDiff(const Lint::Snapshot& previous) noexcept;
+    Lint::TreeModel m_treeModel;
     LintSortFilterProxyModel m_proxyModel;
 
+    // Results of the run before the current one
+    Lint::Snapshot m_previousRun;
+    std::unique_ptr<Lint::DiffWindow> m_diffWindow;
+    // Known messages hidden from new runs
+    std::shared_ptr<const Lint::Baseline> m_baseline;
+    void setBaseline(const Lint::LintMessages& messages) noexcept;
+
+    // Suppression options being edited and applied to the results
+    std::unique_ptr<Lint::SuppressionWindow> m_suppressionWindow;
+    std::shared_ptr<const Lint::SuppressionFilter> m_suppressions;
+    void showSuppressions() noexcept;
+    void showLintTreeMenu(const QPoint& position) noexcept;
+
+    // Source files and results of the last lint are watched for changes
+    std::unique_ptr<Lint::FileWatcher> m_fileWatcher;
+    // Canonical paths of the source files in the lint file
+    QSet<QString> m_lintSourceFiles;
+    // Background lint of the source files that changed since the last lint
+    std::unique_ptr<Lint::PCLintPlus> m_relint;
+    bool m_relintRunning;
+    QStringList m_relintFiles;
+    QSet<QString> m_relintQueue;
+    Lint::LintMessages m_relintMessages;
+    void startRelint() noexcept;
+    void mergeRelint() noexcept;
+    void watchResults() noexcept;
+    void resetMessageCount() noexcept;
+
+    // Which modules include each header so a header edit re-lints only its dependents
+    std::shared_ptr<Lint::IncludeGraph> m_includeGraph;
+    QFutureWatcher<std::shared_ptr<Lint::IncludeGraph>> m_includeGraphWatcher;
+    int m_includeGraphGeneration;
+    int m_includeGraphRequest;
+    void buildIncludeGraph() noexcept;
+    void includeGraphBuilt() noexcept;
+
+    // Everything loaded away from the GUI thread at startup
+    struct StartupState
+    {
+        Lint::Settings settings;
+        Lint::Snapshot session;
+        bool restored;
+        qint64 settingsTime;
+        qint64 sessionTime;
+    };
+    static StartupState loadStartupState() noexcept;
+    QElapsedTimer m_startupTimer;
+    QFutureWatcher<StartupState> m_startupWatcher;
+    void startupLoaded() noexcept;
+    void showMessages(const Lint::LintMessages& messages) noexcept;
+    // Results changed since the last session was restored or saved
+    bool m_sessionChanged;
+    // Session being written after the window was closed
+    QFuture<void> m_sessionWriter;
+
+    // Lint files being generated from a compilation database
+    QFutureWatcher<Lint::CompileCommandsImport> m_importWatcher;
+    void importComplete() noexcept;
+
+    // Saved lint output being read
+    QFutureWatcher<Lint::ResultsFile> m_resultsWatcher;
+    QElapsedTimer m_resultsTimer;
+    void resultsOpened() noexcept;
+    // Drop what belongs to the results about to be replaced
+    void replaceResults() noexcept;
+
+    // Projects of a workspace linted side by side, their strings are pooled
+    std::shared_ptr<Lint::StringPool> m_strings;
+    std::unique_ptr<Lint::LintScheduler> m_scheduler;
+    std::unique_ptr<QComboBox> m_projectComboBox;
+    QAction* m_projectAction;
+    void lintWorkspace(const Lint::WorkspaceProjects& projects) noexcept;
+    void projectStarted(int project, int threads) noexcept;
+    void projectComplete(int project) noexcept;
+    void workspaceComplete() noexcept;
+    void showProject(int project) noexcept;
+    // System load since the last lint for adaptive mode
+    Lint::LoadMonitor m_loadMonitor;
+
 
 };
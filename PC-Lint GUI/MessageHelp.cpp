@@ -0,0 +1,176 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "MessageHelp.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace Lint
+{
+
+// Generated by Messages/compile_messages.py
+extern const int MESSAGE_HELP_COUNT;
+extern const int MESSAGE_HELP_MAX_NUMBER;
+extern const int MESSAGE_HELP_WORD_COUNT;
+extern const std::int16_t MESSAGE_HELP_SLOTS[];
+extern const std::uint16_t MESSAGE_HELP_NUMBERS[];
+extern const std::uint32_t MESSAGE_HELP_OFFSETS[];
+extern const char MESSAGE_HELP_TEXT[];
+extern const std::uint32_t MESSAGE_HELP_WORD_OFFSETS[];
+extern const char MESSAGE_HELP_WORD_TEXT[];
+extern const std::uint32_t MESSAGE_HELP_POSTING_OFFSETS[];
+extern const std::uint16_t MESSAGE_HELP_POSTINGS[];
+
+namespace
+{
+
+int helpEntry(int number) noexcept
+{
+    if ((number < 0) || (number > MESSAGE_HELP_MAX_NUMBER))
+    {
+        return -1;
+    }
+    return MESSAGE_HELP_SLOTS[number];
+}
+
+// Same words as the generator: lower case ASCII letters, digits and underscores
+std::vector<QByteArray> queryWords(QStringView query) noexcept
+{
+    std::vector<QByteArray> words;
+    QByteArray word;
+    for (auto const character : query)
+    {
+        auto const lower = character.toLower().unicode();
+        if (((lower >= 'a') && (lower <= 'z')) || ((lower >= '0') && (lower <= '9')) || (lower == '_'))
+        {
+            word.append(static_cast<char>(lower));
+        }
+        else if (!word.isEmpty())
+        {
+            words.push_back(word);
+            word.clear();
+        }
+    }
+    if (!word.isEmpty())
+    {
+        words.push_back(word);
+    }
+    return words;
+}
+
+int compareWord(int word, const QByteArray& prefix) noexcept
+{
+    auto const begin = MESSAGE_HELP_WORD_OFFSETS[word];
+    auto const length = static_cast<int>(MESSAGE_HELP_WORD_OFFSETS[word + 1] - begin);
+    auto const compare = std::memcmp(MESSAGE_HELP_WORD_TEXT + begin, prefix.constData(), static_cast<size_t>(std::min(length, prefix.size())));
+    if (compare != 0)
+    {
+        return compare;
+    }
+    return (length < prefix.size()) ? -1 : 0;
+}
+
+};
+
+int messageHelpCount() noexcept
+{
+    return MESSAGE_HELP_COUNT;
+}
+
+bool hasMessageHelp(int number) noexcept
+{
+    return helpEntry(number) >= 0;
+}
+
+QString messageHelp(int number) noexcept
+{
+    auto const entry = helpEntry(number);
+    if (entry < 0)
+    {
+        return QString();
+    }
+
+    auto const begin = MESSAGE_HELP_OFFSETS[entry];
+    return QString::fromUtf8(MESSAGE_HELP_TEXT + begin, static_cast<int>(MESSAGE_HELP_OFFSETS[entry + 1] - begin));
+}
+
+std::vector<int> searchMessageHelp(QStringView query) noexcept
+{
+    auto const words = queryWords(query);
+    if (words.empty())
+    {
+        return {};
+    }
+
+    // Entries every word so far has matched
+    std::vector<char> matched(static_cast<size_t>(MESSAGE_HELP_COUNT), 1);
+    std::vector<char> wordMatched(static_cast<size_t>(MESSAGE_HELP_COUNT));
+    for (auto const& word : words)
+    {
+        std::fill(wordMatched.begin(), wordMatched.end(), 0);
+
+        // Words starting with the query word are next to each other in the sorted table
+        int first = 0;
+        int count = MESSAGE_HELP_WORD_COUNT;
+        while (count > 0)
+        {
+            auto const step = count / 2;
+            if (compareWord(first + step, word) < 0)
+            {
+                first += step + 1;
+                count -= step + 1;
+            }
+            else
+            {
+                count = step;
+            }
+        }
+        for (int helpWord = first; (helpWord < MESSAGE_HELP_WORD_COUNT) && (compareWord(helpWord, word) == 0); helpWord++)
+        {
+            for (auto posting = MESSAGE_HELP_POSTING_OFFSETS[helpWord]; posting < MESSAGE_HELP_POSTING_OFFSETS[helpWord + 1]; posting++)
+            {
+                wordMatched[MESSAGE_HELP_POSTINGS[posting]] = 1;
+            }
+        }
+
+        // The message itself when the word is its number
+        bool isNumber = false;
+        auto const entry = helpEntry(word.toInt(&isNumber));
+        if (isNumber && (entry >= 0))
+        {
+            wordMatched[static_cast<size_t>(entry)] = 1;
+        }
+
+        for (size_t entry = 0; entry < matched.size(); entry++)
+        {
+            matched[entry] &= wordMatched[entry];
+        }
+    }
+
+    // Entries are in message number order
+    std::vector<int> numbers;
+    for (size_t entry = 0; entry < matched.size(); entry++)
+    {
+        if (matched[entry])
+        {
+            numbers.push_back(MESSAGE_HELP_NUMBERS[entry]);
+        }
+    }
+    return numbers;
+}
+
+};
@@ -0,0 +1,44 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QString>
+#include <QStringView>
+#include <vector>
+
+namespace Lint
+{
+
+// Help for the messages in Messages/pc-lint.xml
+// The XML is compiled into tables at build time by Messages/compile_messages.py
+// so nothing is parsed at runtime
+
+// Number of messages with help
+int messageHelpCount() noexcept;
+
+// Whether there is help for the message number
+bool hasMessageHelp(int number) noexcept;
+
+// Help text of the message number, empty if there is none
+QString messageHelp(int number) noexcept;
+
+// Message numbers whose help contains every word of the query, in ascending order
+// Each query word matches help words it is a prefix of, case insensitive
+// A query that is a message number also matches that message
+std::vector<int> searchMessageHelp(QStringView query) noexcept;
+
+};
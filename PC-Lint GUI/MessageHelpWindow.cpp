@@ -0,0 +1,117 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "MessageHelpWindow.h"
+#include "MessageHelp.h"
+#include <QVBoxLayout>
+#include <QFontDatabase>
+#include <algorithm>
+
+namespace Lint
+{
+
+MessageHelpWindow::MessageHelpWindow(QWidget* parent) :
+    QWidget(parent),
+    m_search(std::make_unique<QLineEdit>()),
+    m_results(std::make_unique<QListWidget>()),
+    m_title(std::make_unique<QLabel>()),
+    m_help(std::make_unique<QPlainTextEdit>()),
+    m_number(-1)
+{
+    m_search->setPlaceholderText("Search " + QString::number(messageHelpCount()) + " messages");
+    m_search->setClearButtonEnabled(true);
+
+    // Results only take space while searching
+    m_results->setMaximumHeight(150);
+    m_results->hide();
+
+    // The help has code examples laid out with spaces
+    m_help->setReadOnly(true);
+    m_help->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    m_help->setLineWrapMode(QPlainTextEdit::NoWrap);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addWidget(m_search.get());
+    layout->addWidget(m_results.get());
+    layout->addWidget(m_title.get());
+    layout->addWidget(m_help.get());
+
+    QObject::connect(m_search.get(), &QLineEdit::textChanged, this, &MessageHelpWindow::slotSearch);
+    QObject::connect(m_results.get(), &QListWidget::currentItemChanged, this, &MessageHelpWindow::slotResultSelected);
+}
+
+void MessageHelpWindow::showMessage(int number) noexcept
+{
+    if (number == m_number)
+    {
+        return;
+    }
+    m_number = number;
+
+    if (hasMessageHelp(number))
+    {
+        m_title->setText("Message " + QString::number(number));
+        m_help->setPlainText(messageHelp(number));
+    }
+    else
+    {
+        m_title->setText("No help for message " + QString::number(number));
+        m_help->clear();
+    }
+}
+
+void MessageHelpWindow::slotSearch(const QString& query) noexcept
+{
+    m_results->clear();
+    if (query.trimmed().isEmpty())
+    {
+        m_results->hide();
+        return;
+    }
+
+    auto const numbers = searchMessageHelp(query);
+    auto const shown = std::min(static_cast<int>(numbers.size()), MESSAGE_HELP_MAX_RESULTS);
+    for (int result = 0; result < shown; result++)
+    {
+        // First line of the help as a summary
+        auto const number = numbers[result];
+        auto const summary = messageHelp(number).section('\n', 0, 0);
+        auto* item = new QListWidgetItem(QString::number(number) + ": " + summary, m_results.get());
+        item->setData(Qt::UserRole, number);
+    }
+    if (static_cast<int>(numbers.size()) > shown)
+    {
+        auto* item = new QListWidgetItem(QString::number(numbers.size() - shown) + " more, refine the search", m_results.get());
+        item->setFlags(Qt::NoItemFlags);
+    }
+    if (numbers.empty())
+    {
+        auto* item = new QListWidgetItem("No messages found", m_results.get());
+        item->setFlags(Qt::NoItemFlags);
+    }
+    m_results->show();
+}
+
+void MessageHelpWindow::slotResultSelected(QListWidgetItem* item) noexcept
+{
+    if (item && item->data(Qt::UserRole).isValid())
+    {
+        showMessage(item->data(Qt::UserRole).toInt());
+    }
+}
+
+};
@@ -0,0 +1,54 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QWidget>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QLabel>
+#include <QPlainTextEdit>
+#include <memory>
+
+namespace Lint
+{
+
+// Most search results listed at once
+constexpr int MESSAGE_HELP_MAX_RESULTS = 200;
+
+// Explanation of a message number with a search over all of the help
+class MessageHelpWindow : public QWidget
+{
+    Q_OBJECT
+public:
+    MessageHelpWindow(QWidget* parent = nullptr);
+
+    // Show the help of a message number
+    void showMessage(int number) noexcept;
+
+private slots:
+    void slotSearch(const QString& query) noexcept;
+    void slotResultSelected(QListWidgetItem* item) noexcept;
+
+private:
+    std::unique_ptr<QLineEdit> m_search;
+    std::unique_ptr<QListWidget> m_results;
+    std::unique_ptr<QLabel> m_title;
+    std::unique_ptr<QPlainTextEdit> m_help;
+    int m_number;
+};
+
+};
@@ -0,0 +1,11 @@
+# Compiles the message help in pc-lint.xml into C++ tables (see MessageHelp.h)
+win32: MESSAGES_PYTHON = python
+else: MESSAGES_PYTHON = python3
+
+MESSAGES_XML = $$PWD/pc-lint.xml
+messages.input = MESSAGES_XML
+messages.output = ${QMAKE_FILE_BASE}_help.cpp
+messages.commands = $$MESSAGES_PYTHON $$shell_quote($$PWD/compile_messages.py) ${QMAKE_FILE_IN} ${QMAKE_FILE_OUT}
+messages.depends = $$PWD/compile_messages.py
+messages.variable_out = SOURCES
+QMAKE_EXTRA_COMPILERS += messages
@@ -0,0 +1,135 @@
+# PC-Lint GUI
+# Copyright (C) 2021  Ayymooose
+
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+# Compiles the message descriptions in pc-lint.xml into C++ tables
+# so the help is available without parsing XML at runtime
+#
+# Usage: compile_messages.py pc-lint.xml output.cpp
+#
+# Tables (see MessageHelp.cpp):
+#   MESSAGE_HELP_SLOTS      message number -> entry, -1 if there is no help
+#   MESSAGE_HELP_NUMBERS    entry -> message number
+#   MESSAGE_HELP_OFFSETS    entry -> start of its text in MESSAGE_HELP_TEXT (count + 1 entries)
+#   MESSAGE_HELP_TEXT       UTF-8 help text of every entry back to back
+#   MESSAGE_HELP_WORD_*     sorted words of the help text (lower case ASCII)
+#   MESSAGE_HELP_POSTING_*  word -> ascending entries the word appears in
+
+import re
+import sys
+import xml.etree.ElementTree as ElementTree
+
+# Must match the runtime tokenizer in MessageHelp.cpp
+WORD = re.compile(r'[a-z0-9_]+')
+MIN_WORD_LENGTH = 2
+VALUES_PER_LINE = 16
+
+
+def literal(data):
+    # Octal escapes are fixed width so they can't swallow the next character
+    out = []
+    for byte in data:
+        char = chr(byte)
+        if char == '"' or char == '\\' or char == '?':
+            # Escaping '?' keeps trigraph warnings quiet
+            out.append('\\' + char)
+        elif char == '\n':
+            out.append('\\n')
+        elif 32 <= byte < 127:
+            out.append(char)
+        else:
+            out.append('\\%03o' % byte)
+    return '"' + ''.join(out) + '"'
+
+
+def array(out, type_name, name, values):
+    out.append('extern const %s %s[] =\n{\n' % (type_name, name))
+    for start in range(0, len(values), VALUES_PER_LINE):
+        out.append('    ' + ', '.join(str(value) for value in values[start:start + VALUES_PER_LINE]) + ',\n')
+    out.append('};\n\n')
+
+
+def blob(out, name, strings):
+    out.append('extern const char %s[] =\n' % name)
+    for string in strings:
+        out.append('    %s\n' % literal(string))
+    if not strings:
+        out.append('    ""\n')
+    out.append(';\n\n')
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.stderr.write('Usage: compile_messages.py pc-lint.xml output.cpp\n')
+        return 1
+
+    messages = []
+    for message in ElementTree.parse(sys.argv[1]).getroot().iter('m'):
+        description = message.find('c')
+        text = description.text if (description is not None) and description.text else ''
+        messages.append((int(message.get('id')), text.strip()))
+    messages.sort()
+
+    numbers = [number for number, _ in messages]
+    if len(numbers) != len(set(numbers)):
+        sys.stderr.write('Duplicate message numbers in %s\n' % sys.argv[1])
+        return 1
+
+    maxNumber = numbers[-1] if numbers else 0
+    slots = [-1] * (maxNumber + 1)
+    texts = []
+    offsets = [0]
+    postings = {}
+    for entry, (number, text) in enumerate(messages):
+        slots[number] = entry
+        encoded = text.encode('utf-8')
+        texts.append(encoded)
+        offsets.append(offsets[-1] + len(encoded))
+        for word in set(WORD.findall(text.lower())):
+            if len(word) >= MIN_WORD_LENGTH:
+                postings.setdefault(word, []).append(entry)
+
+    words = sorted(postings)
+    wordOffsets = [0]
+    postingOffsets = [0]
+    allPostings = []
+    for word in words:
+        wordOffsets.append(wordOffsets[-1] + len(word))
+        allPostings.extend(postings[word])
+        postingOffsets.append(len(allPostings))
+
+    out = ['// Generated from pc-lint.xml by compile_messages.py, do not edit\n\n',
+           '#include <cstdint>\n\n',
+           'namespace Lint\n{\n\n',
+           'extern const int MESSAGE_HELP_COUNT = %d;\n' % len(messages),
+           'extern const int MESSAGE_HELP_MAX_NUMBER = %d;\n' % maxNumber,
+           'extern const int MESSAGE_HELP_WORD_COUNT = %d;\n\n' % len(words)]
+    array(out, 'std::int16_t', 'MESSAGE_HELP_SLOTS', slots)
+    array(out, 'std::uint16_t', 'MESSAGE_HELP_NUMBERS', numbers)
+    array(out, 'std::uint32_t', 'MESSAGE_HELP_OFFSETS', offsets)
+    blob(out, 'MESSAGE_HELP_TEXT', texts)
+    array(out, 'std::uint32_t', 'MESSAGE_HELP_WORD_OFFSETS', wordOffsets)
+    blob(out, 'MESSAGE_HELP_WORD_TEXT', [word.encode('ascii') for word in words])
+    array(out, 'std::uint32_t', 'MESSAGE_HELP_POSTING_OFFSETS', postingOffsets)
+    array(out, 'std::uint16_t', 'MESSAGE_HELP_POSTINGS', allPostings)
+    out.append('};\n')
+
+    with open(sys.argv[2], 'w', newline='\n') as output:
+        output.write(''.join(out))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
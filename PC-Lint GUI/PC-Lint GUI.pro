@@ -7,30 +7,83 @@ DEFINES += QT_DEPRECATED_WARNINGS
 
 QMAKE_CXXFLAGS += -Wunused -Wpointer-arith -Wlogical-op
 
-QT += xml widgets concurrent
+QT += xml widgets concurrent network
+
+# Process memory for the progress window
+win32: LIBS += -lpsapi
+
+include(Messages/Messages.pri)
 
 SOURCES += \
     About.cpp \
     CodeEditor.cpp \
+    CompileCommands.cpp \
+    DiffWindow.cpp \
+    Distributed.cpp \
+    DocumentCache.cpp \
+    Export.cpp \
+    FileWatcher.cpp \
+    Headless.cpp \
     Highlighter.cpp \
+    IncludeGraph.cpp \
+    Lexer.cpp \
+    LintFile.cpp \
     Log.cpp \
     MainWindow.cpp \
+    MessageHelp.cpp \
+    MessageHelpWindow.cpp \
     PCLintPlus.cpp \
     Preferences.cpp \
     ProgressWindow.cpp \
+    ResultsFile.cpp \
+    Snapshot.cpp \
+    SourceDiscovery.cpp \
+    Statistics.cpp \
+    StatisticsWindow.cpp \
+    StringPool.cpp \
+    SuppressionWindow.cpp \
+    Suppressions.cpp \
+    SystemInfo.cpp \
+    Trace.cpp \
+    TreeModel.cpp \
+    Workspace.cpp \
     Main.cpp
 
 HEADERS += \
     About.h \
     CodeEditor.h \
+    CompileCommands.h \
     Compiler.h \
+    DiffWindow.h \
+    Distributed.h \
+    DocumentCache.h \
+    Export.h \
+    FileWatcher.h \
+    Headless.h \
     Highlighter.h \
+    IncludeGraph.h \
     Jenkins.h \
+    Lexer.h \
+    LintFile.h \
     Log.h \
     MainWindow.h \
+    MessageHelp.h \
+    MessageHelpWindow.h \
     PCLintPlus.h \
     Preferences.h \
     ProgressWindow.h \
+    ResultsFile.h \
+    Snapshot.h \
+    SourceDiscovery.h \
+    Statistics.h \
+    StatisticsWindow.h \
+    StringPool.h \
+    SuppressionWindow.h \
+    Suppressions.h \
+    SystemInfo.h \
+    Trace.h \
+    TreeModel.h \
+    Workspace.h \
     atomicops.h \
     readerwriterqueue.h
 
@@ -16,6 +16,8 @@
 
 #include "PCLintPlus.h"
 #include "Log.h"
+#include "Snapshot.h"
+#include "Trace.h"
 
 namespace Lint
 {
@@ -23,8 +25,16 @@ namespace Lint
 
 PCLintPlus::PCLintPlus() :
     m_hardwareThreads(1),
+    m_throttle(true),
     m_status(STATUS_UNKNOWN),
     m_lintSourceFiles(0),
+    m_suppressedMessages(0),
+    m_wholeProgramMessages(0),
+    m_failedShards(0),
+    m_stdOutBytes(0),
+    m_parsedMessages(0),
+    m_stitchBytes(0),
+    m_uniqueMessages(0),
     m_finished(false)
 {
 
@@ -34,8 +44,16 @@ PCLintPlus::PCLintPlus(const QString& lintExecutable, const QString& lintFile) :
     m_lintExecutable(lintExecutable),
     m_lintFile(lintFile),
     m_hardwareThreads(1),
+    m_throttle(true),
     m_status(STATUS_UNKNOWN),
     m_lintSourceFiles(0),
+    m_suppressedMessages(0),
+    m_wholeProgramMessages(0),
+    m_failedShards(0),
+    m_stdOutBytes(0),
+    m_parsedMessages(0),
+    m_stitchBytes(0),
+    m_uniqueMessages(0),
     m_finished(false)
 {
 
@@ -43,8 +61,17 @@ PCLintPlus::PCLintPlus(const QString& lintExecutable, const QString& lintFile) :
 
 void PCLintPlus::slotAbortLint(bool abort) noexcept
 {
-    m_process->closeReadChannel(QProcess::StandardOutput);
-    m_process->closeReadChannel(QProcess::StandardError);
+    // Nothing was started
+    if (!m_process && !m_distributed)
+    {
+        return;
+    }
+
+    if (m_process)
+    {
+        m_process->closeReadChannel(QProcess::StandardOutput);
+        m_process->closeReadChannel(QProcess::StandardError);
+    }
     {
         std::scoped_lock lock(m_mutex);
         m_finished = true;
@@ -55,7 +82,31 @@ void PCLintPlus::slotAbortLint(bool abort) noexcept
     }
     m_conditionVariable.notify_one();
     m_future.waitForFinished();
-    m_process->close();
+    if (m_process)
+    {
+        m_process->close();
+    }
+    else
+    {
+        m_distributed->abort();
+    }
+}
+
+void PCLintPlus::setBaseline(std::shared_ptr<const Baseline> baseline) noexcept
+{
+    m_baseline = std::move(baseline);
+}
+
+int PCLintPlus::suppressedMessages() const noexcept
+{
+    return m_suppressedMessages;
+}
+
+LintMetrics PCLintPlus::metrics() const noexcept
+{
+    return LintMetrics{m_stdOutBytes, m_parsedMessages,
+                       m_dataQueue ? static_cast<qint64>(m_dataQueue->size_approx()) : 0,
+                       m_stitchBytes, m_uniqueMessages};
 }
 
 void PCLintPlus::setLintFile(const QString& lintFile) noexcept
@@ -75,119 +126,148 @@ QString PCLintPlus::errorMessage() const noexcept
     return m_errorMessage;
 }
 
-void PCLintPlus::setHardwareThreads(const int threads) noexcept
+QStringList PCLintPlus::sourceFiles() const noexcept
 {
-    Q_ASSERT(threads > 0);
-    m_hardwareThreads = threads;
+    return m_sourceFiles;
 }
 
-bool PCLintPlus::parseLintFile() noexcept
+const ParsedLintFile& PCLintPlus::parsedLintFile() const noexcept
 {
-    Q_ASSERT(m_lintFile.size());
+    return m_parsedLintFile;
+}
 
-    m_arguments.clear();
+void PCLintPlus::setSourceFiles(const QStringList& files) noexcept
+{
+    m_lintOnly = files;
+}
 
-    // -max_threads must be the first argument to the lint
-    m_arguments << (QString("-max_threads=%1").arg(m_hardwareThreads));
+void PCLintPlus::setWorkers(const QStringList& workers, const QString& token) noexcept
+{
+    m_workers = workers;
+    m_workerToken = token;
+}
 
-    // For testing, does 1 pass only
-    //m_arguments << ("-unit_check");
+void PCLintPlus::setThrottle(bool throttle) noexcept
+{
+    m_throttle = throttle;
+}
+
+void PCLintPlus::setHardwareThreads(const int threads) noexcept
+{
+    Q_ASSERT(threads > 0);
+    m_hardwareThreads = threads;
+}
+
+QStringList lintOutputOptions() noexcept
+{
+    QStringList options;
 
     // Extra arguments to produce XML output
     // Enable verbosity and module information displayed so we know progress
-    m_arguments << ("+vm");
+    options << ("+vm");
     // Control the message height and force file information per message
-    m_arguments << ("-hFs1"); // was b
+    options << ("-hFs1"); // was b
     // No line breaks in output
-    m_arguments << ("-width(0)");
+    options << ("-width(0)");
 
     // XML specific arguments
     // Put open/closing <doc> tags in document
-    m_arguments << ("+xml(doc)");
+    options << ("+xml(doc)");
     // Use minimal element names for faster output
-    m_arguments << ("-format=<m><f>%f</f><l>%l</l><t>%t</t><n>%n</n><d>%m</d></m>");
+    options << ("-format=<m><f>%f</f><l>%l</l><t>%t</t><n>%n</n><d>%m</d></m>");
     // Surpress specific walk messages
-    m_arguments << ("-format_specific= ");
+    options << ("-format_specific= ");
+    return options;
+}
 
+bool PCLintPlus::parseLintFile() noexcept
+{
+    Q_ASSERT(m_lintFile.size());
 
-    // TODO: Test with various lint files
+    m_arguments.clear();
+
+    // -max_threads must be the first argument to the lint
+    m_arguments << (QString("-max_threads=%1").arg(m_hardwareThreads));
+
+    // For testing, does 1 pass only
+    //m_arguments << ("-unit_check");
 
-    // Add the lint file
-    m_arguments << (m_lintFile);
+    m_arguments << lintOutputOptions();
 
-    // For PC-Lint GUI we expect the source files will be present in the lint file
-    // Currently nested lint files are not supported
+    // For PC-Lint GUI we expect the source files will be present in the lint file or the lint files it includes
     m_lintSourceFiles = processLintSourceFiles();
 
+    // Add the lint file, or a copy of it that only lints some of its files
+    if (!m_lintOnly.isEmpty() && (m_lintSourceFiles > 0))
+    {
+        if (!writeSubsetLintFile())
+        {
+            return false;
+        }
+        m_arguments << m_subsetLintFile->fileName();
+    }
+    else
+    {
+        m_arguments << (m_lintFile);
+    }
+
     return m_lintSourceFiles > 0;
 }
 
-int PCLintPlus::processLintSourceFiles() noexcept
+bool PCLintPlus::writeSubsetLintFile() noexcept
 {
-    Q_ASSERT(m_lintFile.size());
-
-    // Check if file parsed exists and add to set
-    // Read the lint file and check for and source files
-    int sourceFiles = 0;
-
-    QFile lintFile(m_lintFile);
-    lintFile.open(QIODevice::ReadOnly);
-    if (!lintFile.isOpen())
+    // Relative paths in the options still work as the lint runs from the lint file's directory
+    m_subsetLintFile = std::make_unique<QTemporaryFile>(QDir::tempPath() + "/PC-Lint GUI-XXXXXX.lnt");
+    if (!m_subsetLintFile->open())
     {
-        qCritical() << "Failed to open lint file:" << m_lintFile;
-        return sourceFiles;
+        m_status = STATUS_PROCESS_ERROR;
+        m_errorMessage = "Unable to create temporary lint file: " + m_subsetLintFile->errorString();
+        qCritical() << m_errorMessage;
+        return false;
     }
-    QTextStream file(&lintFile);
-    while (!file.atEnd())
-    {
-        auto const line = file.readLine().trimmed();
 
-        // Ignore files that are commented out with //
-        if (line.startsWith("//"))
-        {
-            continue;
-        }
+    const QSet<QString> lintOnly(m_lintOnly.begin(), m_lintOnly.end());
+    int modules = 0;
+    m_subsetLintFile->write(subsetLintFile(lintOnly, modules));
+    m_subsetLintFile->flush();
 
-        // TODO: Ignore all files within /* */ blocks
-        // If a line starts with /*, mark it as ignored and continue until we reach a */
-        // TODO: Can we have nested /* */ blocks?
+    m_lintSourceFiles = modules;
+    qInfo() << "Linting" << modules << "of" << m_sourceFiles.size() << "source files with" << m_subsetLintFile->fileName();
+    return true;
+}
 
-        // .c, .cc, .cpp, .c++, .cp, .cxx
-        if (line.contains(".c"))
+QByteArray PCLintPlus::subsetLintFile(const QSet<QString>& modules, int& count) const noexcept
+{
+    // Every option with nested lint files inlined, keeping the modules asked for where they were
+    // so they stay inside their -env_push scopes
+    QByteArray lintFile;
+    QTextStream output(&lintFile);
+    count = 0;
+    for (auto const& option : m_parsedLintFile.options)
+    {
+        if (option.kind == LINT_TOKEN_MODULE)
         {
-            QString sourceFile = line;
-
-            // Check if the file is wrapped in quotes
-            if (line.endsWith('\"') && line.startsWith('\"'))
-            {
-                // Strip quotes
-                sourceFile = line.mid(1, line.length()-1-1);
-            }
-
-            // Check if the absolute file exists
-            if (QFileInfo(sourceFile).exists())
-            {
-                qDebug() << "Absolute file:" << sourceFile;
-                sourceFiles++;
-            }
-            else
+            if (!modules.contains(option.path))
             {
-                // Otherwise it must be a relative file then
-                auto const lintWorkingDirectory = QFileInfo(m_lintFile).canonicalPath();
-                auto const relativePath = lintWorkingDirectory + QDir::separator() + sourceFile;
-                auto const canonPath = QFileInfo(relativePath).canonicalFilePath();
-
-                if (QFileInfo(canonPath).exists())
-                {
-                    qDebug() << "Relative file:" << sourceFile;
-                    sourceFiles++;
-                }
+                continue;
             }
+            count++;
         }
-
+        output << option.text << '\n';
     }
-    lintFile.close();
+    output.flush();
+    return lintFile;
+}
+
+int PCLintPlus::processLintSourceFiles() noexcept
+{
+    Q_ASSERT(m_lintFile.size());
+
+    // Modules of the lint file and every lint file nested in it
+    m_parsedLintFile = parseLintFile(m_lintFile);
+    m_sourceFiles = m_parsedLintFile.modules;
 
+    auto const sourceFiles = m_sourceFiles.size();
     if (sourceFiles > 0)
     {
         qDebug() << "Found" << sourceFiles << "source files to lint";
@@ -196,6 +276,10 @@ int PCLintPlus::processLintSourceFiles() noexcept
     {
         m_status = STATUS_PROCESS_ERROR;
         m_errorMessage = "No source files found in lint file";
+        if (!m_parsedLintFile.errors.isEmpty())
+        {
+            m_errorMessage += ":\n\n" + m_parsedLintFile.errors.mid(0, 10).join('\n');
+        }
         qDebug() << m_errorMessage;
     }
     return sourceFiles;
@@ -215,10 +299,6 @@ void PCLintPlus::lint() noexcept
     auto const workingDirectory = QFileInfo(m_lintFile).canonicalPath();
     qDebug() << "Setting working directory to:" << workingDirectory;
 
-    m_process = std::make_unique<QProcess>();
-
-    m_process->setWorkingDirectory(workingDirectory);
-
     // stderr has the module (file lint) progress
     // sttout has the actual data
     QString cmdString = R"(")" + m_lintExecutable + R"(")";
@@ -227,6 +307,13 @@ void PCLintPlus::lint() noexcept
     m_status = STATUS_UNKNOWN;
     m_finished = false;
     m_messageSet.clear();
+    m_suppressedMessages = 0;
+    m_wholeProgramMessages = 0;
+    m_failedShards = 0;
+    m_stdOutBytes = 0;
+    m_parsedMessages = 0;
+    m_stitchBytes = 0;
+    m_uniqueMessages = 0;
     m_stdOut.clear();
     m_lintedFiles.clear();
 
@@ -274,6 +361,17 @@ void PCLintPlus::lint() noexcept
     // Start consumer thread here
     m_future = QtConcurrent::run(this, &PCLintPlus::consumerThread);
 
+    if (!m_workers.isEmpty())
+    {
+        m_process.reset();
+        lintDistributed(workingDirectory);
+        return;
+    }
+
+    m_distributed.reset();
+    m_process = std::make_unique<QProcess>();
+    m_process->setWorkingDirectory(workingDirectory);
+
     QObject::connect(m_process.get(), &QProcess::started, this, [this]()
     {
         qDebug() << __FUNCTION__ << "lint process started";
@@ -291,31 +389,7 @@ void PCLintPlus::lint() noexcept
     [this](int exitCode, QProcess::ExitStatus exitStatus)
     {
         qDebug() << "Lint process finished with exit code:" << QString::number(exitCode) << "and exit status:" << exitStatus;
-        qInfo() << "Linted:" << m_lintSourceFiles << '/' << m_lintedFiles.size() << "source files";
-
-        // Wait for consumer thread to finish
-        slotAbortLint(false);
-
-        if (m_status & (STATUS_PROCESS_ERROR | STATUS_PROCESS_TIMEOUT | STATUS_LICENSE_ERROR))
-        {
-            Q_ASSERT(!m_errorMessage.isEmpty());
-            emit signalLintComplete(m_status, m_errorMessage);
-        }
-        else
-        {
-            if (m_status != STATUS_ABORT)
-            {
-                if (m_lintSourceFiles == m_lintedFiles.size())
-                {
-                    m_status = STATUS_COMPLETE;
-                }
-                else
-                {
-                    m_status = STATUS_PARTIAL_COMPLETE;
-                }
-            }
-            emit signalLintComplete(m_status, m_errorMessage);
-        }
+        lintFinished();
     });
 
     QObject::connect(m_process.get(), &QProcess::errorOccurred, this, [&](const QProcess::ProcessError& error)
@@ -330,10 +404,12 @@ void PCLintPlus::lint() noexcept
     QObject::connect(m_process.get(), &QProcess::readyReadStandardOutput, this, [this]()
     {
         // TODO: Set timer here to expire if lint per file takes too long
+        TraceScope trace("readyReadStandardOutput");
         try
         {
             // On large projects, there's a good chance we'll get a bad_alloc thrown
             auto readStdOut = m_process->readAllStandardOutput();
+            m_stdOutBytes += readStdOut.size();
             m_stdOutFile.write(readStdOut);
             m_stdOutFile.flush();
 
@@ -352,43 +428,132 @@ void PCLintPlus::lint() noexcept
 
     QObject::connect(m_process.get(), &QProcess::readyReadStandardError, this,[this]()
     {
-        auto stdErrData = m_process->readAllStandardError();
-
-        m_stdErrFile.write(stdErrData);
-        m_stdErrFile.flush();
+        processStdErr(m_process->readAllStandardError());
+    });
+}
 
-        // Check if license is valid
-        // PC-Lint Plus version is always the first line included in stderr
-        if (stdErrData.contains(DATA_LICENCE_ERROR_STRING))
+void PCLintPlus::lintDistributed(const QString& workingDirectory) noexcept
+{
+    // Each shard gets the lint file with only its own modules
+    QStringList modules = m_sourceFiles;
+    if (!m_lintOnly.isEmpty())
+    {
+        const QSet<QString> lintOnly(m_lintOnly.begin(), m_lintOnly.end());
+        modules.erase(std::remove_if(modules.begin(), modules.end(), [&lintOnly](const QString& module)
         {
-            m_status = STATUS_LICENSE_ERROR;
+            return !lintOnly.contains(module);
+        }), modules.end());
+    }
+    modules.removeDuplicates();
 
-            qCritical() << "Lint failed with license error:\n" << stdErrData;
-            m_errorMessage = stdErrData;
+    // Workers add their own options, -max_threads and lint file
+    std::vector<ShardJob> jobs;
+    for (auto const& shard : splitShards(modules, m_workers.size() * WORKER_SHARDS_PER_WORKER))
+    {
+        int count = 0;
+        QByteArray lintFile = subsetLintFile(QSet<QString>(shard.begin(), shard.end()), count);
+        jobs.push_back({static_cast<qint32>(jobs.size()), workingDirectory, std::move(lintFile), shard, m_hardwareThreads});
+    }
 
-            slotAbortLint(false);
-            return;
+    m_distributed = std::make_unique<DistributedLint>();
+    QObject::connect(m_distributed.get(), &DistributedLint::signalOutput, this, [this](const QByteArray& modules)
+    {
+        // Whole modules only, output of different workers never interleaves within a module
+        m_stdOutBytes += modules.size();
+        m_dataQueue->enqueue(modules);
+        m_conditionVariable.notify_one();
+    });
+    QObject::connect(m_distributed.get(), &DistributedLint::signalProgress, this, &PCLintPlus::processStdErr);
+    QObject::connect(m_distributed.get(), &DistributedLint::signalShardFailed, this, [this](qint32 id, const QString& errorMessage)
+    {
+        qCritical() << "Shard" << id << "wasn't linted:" << errorMessage;
+        m_failedShards++;
+    });
+    QObject::connect(m_distributed.get(), &DistributedLint::signalFinished, this, [this](const QString& errorMessage)
+    {
+        // Aborts and license errors already have their status
+        if (!errorMessage.isEmpty() && (m_status == STATUS_UNKNOWN))
+        {
+            m_status = STATUS_PROCESS_ERROR;
+            m_errorMessage = errorMessage;
         }
+        lintFinished();
+    });
 
-        auto const sourceFiles = processSourceFiles(stdErrData);
-        for (auto const& sourceFile : sourceFiles)
-        {
+    qInfo() << "Linting" << modules.size() << "source files in" << jobs.size() << "shards on" << m_workers.size() << "workers";
+    emit signalUpdateProgressMax(m_lintSourceFiles);
+    m_distributed->start(m_workers, m_workerToken, std::move(jobs));
+}
 
-            // TODO: We can lint the same file multiple times so the message printed here
-            // will only fire for the first ever lint of a file
-            if (m_lintedFiles.find(sourceFile) == m_lintedFiles.end())
-            {
-                m_lintedFiles.insert(sourceFile);
+void PCLintPlus::lintFinished() noexcept
+{
+    qInfo() << "Linted:" << m_lintSourceFiles << '/' << m_lintedFiles.size() << "source files";
 
-                qInfo() << "Linted:" << sourceFile;
+    // Wait for consumer thread to finish
+    slotAbortLint(false);
 
-                // Update progress
-                emit signalUpdateProgress();
+    if (m_wholeProgramMessages > 0)
+    {
+        qInfo() << "Dropped" << m_wholeProgramMessages << "whole-program messages, they are unreliable when linting on workers";
+    }
+
+    if (m_status & (STATUS_PROCESS_ERROR | STATUS_PROCESS_TIMEOUT | STATUS_LICENSE_ERROR))
+    {
+        Q_ASSERT(!m_errorMessage.isEmpty());
+        emit signalLintComplete(m_status, m_errorMessage);
+    }
+    else
+    {
+        if (m_status != STATUS_ABORT)
+        {
+            if ((m_lintSourceFiles == m_lintedFiles.size()) && (m_failedShards == 0))
+            {
+                m_status = STATUS_COMPLETE;
+            }
+            else
+            {
+                m_status = STATUS_PARTIAL_COMPLETE;
             }
+        }
+        emit signalLintComplete(m_status, m_errorMessage);
+    }
+}
+
+void PCLintPlus::processStdErr(const QByteArray& stdErrData) noexcept
+{
+    m_stdErrFile.write(stdErrData);
+    m_stdErrFile.flush();
+
+    // Check if license is valid
+    // PC-Lint Plus version is always the first line included in stderr
+    if (stdErrData.contains(DATA_LICENCE_ERROR_STRING))
+    {
+        m_status = STATUS_LICENSE_ERROR;
+
+        qCritical() << "Lint failed with license error:\n" << stdErrData;
+        m_errorMessage = stdErrData;
+
+        slotAbortLint(false);
+        return;
+    }
+
+    auto const sourceFiles = processSourceFiles(stdErrData);
+    for (auto const& sourceFile : sourceFiles)
+    {
+
+        // TODO: We can lint the same file multiple times so the message printed here
+        // will only fire for the first ever lint of a file
+        if (m_lintedFiles.find(sourceFile) == m_lintedFiles.end())
+        {
+            m_lintedFiles.insert(sourceFile);
+
+            qInfo() << "Linted:" << sourceFile;
 
+            // Update progress
+            emit signalUpdateProgress();
         }
 
-    });
+    }
 }
 
 void PCLintPlus::consumerThread() noexcept
@@ -406,6 +571,8 @@ void PCLintPlus::consumerThread() noexcept
             break;
         }
 
+        // Covers everything done with the chunk, the stages below nest inside it
+        TraceScope trace("consumerThread dequeue");
         QByteArray lintChunk;
         bool success = m_dataQueue->try_dequeue(lintChunk);
         if (!success)
@@ -441,7 +608,7 @@ void PCLintPlus::consumerThread() noexcept
     {
         try
         {
-
+            TraceScope trace("consumerThread dequeue");
             QByteArray lintChunk;
             m_dataQueue->try_dequeue(lintChunk);
 
@@ -480,10 +647,13 @@ void PCLintPlus::consumerThread() noexcept
 
 LintMessages PCLintPlus::parseLintMessages(const QByteArray& data)
 {
+    TraceScope trace("parseLintMessages");
     // Ordering of messages is now important (was QSet)
     QXmlStreamReader lintXML(data);
     LintMessages lintMessages;
     LintMessage message;
+    // Whether the current message and its supplementals are dropped
+    bool dropped = false;
 
     // Start XML parsing
     // Parse the XML until we reach end of it
@@ -544,18 +714,54 @@ LintMessages PCLintPlus::parseLintMessages(const QByteArray& data)
 
         if ((lintXML.name() == Xml::XML_ELEMENT_MESSAGE) && (token == QXmlStreamReader::EndElement))
         {
+            m_parsedMessages++;
+
             // Lint can spit out duplicate messages for different files
             // So we must remove them otherwise we'd consume a huge chunk of memory
-
-            if (m_messageSet.find(message) == m_messageSet.end())
+            // Supplementals follow whatever happened to their top-level message
+            bool skip = false;
+            if (message.type != Type::TYPE_SUPPLEMENTAL)
+            {
+                dropped = m_messageSet.contains(message);
+                if (!dropped)
+                {
+                    m_messageSet.insert(message);
+                    m_uniqueMessages = m_messageSet.size();
+
+                    // Workers each lint a shard of the modules so whole-program messages can't be trusted
+                    if (!m_workers.isEmpty() && isWholeProgramMessage(message.number))
+                    {
+                        dropped = true;
+                        m_wholeProgramMessages++;
+                    }
+                    else
+                    {
+                        // Drop known messages before they cost anything further down the pipeline
+                        // Checked after the duplicates so each one is only counted once
+                        dropped = m_baseline && m_baseline->contains(message);
+                        if (dropped)
+                        {
+                            m_suppressedMessages++;
+                        }
+                    }
+                }
+                skip = dropped;
+            }
+            else
             {
                 // Don't add supplementals first
-                if (!((lintMessages.size() == 0) && (message.type == Type::TYPE_SUPPLEMENTAL)))
+                skip = dropped || (lintMessages.size() == 0) || m_messageSet.contains(message);
+                if (!skip)
                 {
                     m_messageSet.insert(message);
-                    lintMessages.emplace_back(std::move(message));
+                    m_uniqueMessages = m_messageSet.size();
                 }
             }
+
+            if (!skip)
+            {
+                lintMessages.emplace_back(std::move(message));
+            }
         }
     }
 
@@ -574,6 +780,7 @@ LintMessages PCLintPlus::parseLintMessages(const QByteArray& data)
 
 QString PCLintPlus::addFullFilePath(QStringView file) const noexcept
 {
+    TraceScope trace("addFullFilePath");
     // Check if the file exists (absolute path given)
     if (QFileInfo(file.toString()).exists())
     {
@@ -621,7 +828,10 @@ void PCLintPlus::processModules(std::vector<QByteArray> modules)
 
              // Otherwise add the children under a new node
              emit signalAddTreeParent(messageTop);
-             QThread::msleep(1);
+             if (m_throttle)
+             {
+                 QThread::msleep(1);
+             }
 
              // Otherwise grab the rest of the group
              for (auto cit = messageGroup.cbegin()+1; cit != messageGroup.cend(); ++cit)
@@ -631,7 +841,10 @@ void PCLintPlus::processModules(std::vector<QByteArray> modules)
                  message.file = addFullFilePath(message.file);
 
                  emit signalAddTreeChild(message);
-                 QThread::msleep(1);
+                 if (m_throttle)
+                 {
+                     QThread::msleep(1);
+                 }
              }
          }
     }
@@ -646,6 +859,7 @@ QString PCLintPlus::getLintFile() const noexcept
 // So that supplemental messages are tied together with error/info/warnings
 LintMessageGroup PCLintPlus::groupLintMessages(LintMessages&& lintMessages) noexcept
 {
+    TraceScope trace("groupLintMessages");
     // Spit out a LintMessageGroup
     LintMessageGroup messageGroup;
 
@@ -737,9 +951,11 @@ std::vector<QString> PCLintPlus::processSourceFiles(const QByteArray& data) noex
 // Process a chunk of data if possible?
 std::vector<QByteArray> PCLintPlus::stitchModule(const QByteArray& data)
 {
+    TraceScope trace("stitchModule");
     std::vector<QByteArray> modules;
 
     m_stdOut.append(data);
+    m_stitchBytes = m_stdOut.size();
 
     for (;;)
     {
@@ -764,6 +980,7 @@ std::vector<QByteArray> PCLintPlus::stitchModule(const QByteArray& data)
 
         // Remove this from our array to lower memory usage
         m_stdOut.remove(firstIndex, secondIndex-firstIndex);
+        m_stitchBytes = m_stdOut.size();
 
         // Each module chunk will need a pair of <doc>/<doc> tags
         // wrapped around them for the XML stream reader to work
@@ -24,6 +24,8 @@
 #include <QProcess>
 #include <QXmlStreamReader>
 #include <QFileInfo>
+#include <QTemporaryFile>
+#include <QStringList>
 #include <QRegularExpression>
 #include <QThread>
 #include <QTreeWidget>
@@ -41,6 +43,8 @@
 #include <condition_variable>
 #include "atomicops.h"
 #include "readerwriterqueue.h"
+#include "LintFile.h"
+#include "Distributed.h"
 
 namespace Lint
 {
@@ -96,9 +100,56 @@ enum Message
     MESSAGE_WARNING,
     MESSAGE_INFORMATION,
     MESSAGE_SUPPLEMENTAL,
+    MESSAGE_NOTE,
     MESSAGE_UNKNOWN
 };
 
+// Convert a PC-Lint Plus message type to its enum
+inline Message messageType(const QString& type) noexcept
+{
+    if (type == Type::TYPE_ERROR)
+    {
+        return MESSAGE_ERROR;
+    }
+    else if (type == Type::TYPE_WARNING)
+    {
+        return MESSAGE_WARNING;
+    }
+    else if (type == Type::TYPE_INFORMATION)
+    {
+        return MESSAGE_INFORMATION;
+    }
+    else if (type == Type::TYPE_SUPPLEMENTAL)
+    {
+        return MESSAGE_SUPPLEMENTAL;
+    }
+    else if (type == Type::TYPE_NOTE)
+    {
+        return MESSAGE_NOTE;
+    }
+    return MESSAGE_UNKNOWN;
+}
+
+// Convert a message type enum back to its PC-Lint Plus name
+inline QString messageTypeName(Message type) noexcept
+{
+    switch (type)
+    {
+    case MESSAGE_ERROR:
+        return Type::TYPE_ERROR;
+    case MESSAGE_WARNING:
+        return Type::TYPE_WARNING;
+    case MESSAGE_INFORMATION:
+        return Type::TYPE_INFORMATION;
+    case MESSAGE_SUPPLEMENTAL:
+        return Type::TYPE_SUPPLEMENTAL;
+    case MESSAGE_NOTE:
+        return Type::TYPE_NOTE;
+    default:
+        return QString();
+    }
+}
+
 constexpr int LINT_TABLE_FILE_COLUMN = 0;
 constexpr int LINT_TABLE_NUMBER_COLUMN = 1;
 constexpr int LINT_TABLE_DESCRIPTION_COLUMN = 2;
@@ -125,6 +176,21 @@ using LintMessageGroup = std::vector<LintMessages>;
 
 using namespace moodycamel;
 
+// Counters of a running lint, safe to read from the GUI thread
+struct LintMetrics
+{
+    qint64 stdOutBytes;    // Read from lint's stdout
+    qint64 parsedMessages; // Parsed from the XML, duplicates included
+    qint64 queueDepth;     // stdout chunks waiting for the consumer thread
+    qint64 stitchBytes;    // Output waiting for the rest of its module
+    qint64 uniqueMessages; // Messages in the duplicate set
+};
+
+class Baseline;
+
+// Options every lint run needs so its output can be parsed, without -max_threads and the lint file
+QStringList lintOutputOptions() noexcept;
+
 class PCLintPlus : public QObject
 {
     Q_OBJECT
@@ -140,6 +206,25 @@ public:
     void setWorkingDirectory(const QString& directory) noexcept;
 
     void setHardwareThreads(const int threads) noexcept;
+    // Pause briefly after each message so a GUI receiving them stays responsive (on by default)
+    void setThrottle(bool throttle) noexcept;
+    // Lint on these workers ("host:port") instead of a local process (empty to lint locally)
+    // The token has to match the one the workers were started with
+    void setWorkers(const QStringList& workers, const QString& token) noexcept;
+
+    // Messages in the baseline are dropped while parsing (nullptr to report everything)
+    void setBaseline(std::shared_ptr<const Baseline> baseline) noexcept;
+    // Number of messages dropped by the baseline during the last lint
+    int suppressedMessages() const noexcept;
+    // Where the data is in the pipeline right now
+    LintMetrics metrics() const noexcept;
+
+    // Source files found in the lint file (canonical paths)
+    QStringList sourceFiles() const noexcept;
+    // Everything read from the lint file by the last lint
+    const ParsedLintFile& parsedLintFile() const noexcept;
+    // Only lint these files from the lint file (empty to lint all of them)
+    void setSourceFiles(const QStringList& files) noexcept;
 
     QString errorMessage() const noexcept;
 
@@ -181,6 +266,7 @@ private:
     QString m_errorMessage;
 
     int m_hardwareThreads;
+    bool m_throttle;
     QSet<QString> m_lintedFiles;
 
     // stderr has the module (file lint) progress
@@ -192,19 +278,42 @@ private:
     QFile m_stdErrFile;
     QFile m_remainingFile;
     int m_lintSourceFiles;
+    QStringList m_sourceFiles;
+    ParsedLintFile m_parsedLintFile;
+    QStringList m_lintOnly;
+    std::unique_ptr<QTemporaryFile> m_subsetLintFile;
 
     QByteArray m_stdOut;
 
     std::unique_ptr<QProcess> m_process;
+    QStringList m_workers;
+    QString m_workerToken;
+    std::unique_ptr<DistributedLint> m_distributed;
 
 
     void emitLintComplete() noexcept;
+    bool writeSubsetLintFile() noexcept;
+    QByteArray subsetLintFile(const QSet<QString>& modules, int& count) const noexcept;
+    void lintDistributed(const QString& workingDirectory) noexcept;
+    void lintFinished() noexcept;
+    void processStdErr(const QByteArray& stdErrData) noexcept;
     void consumerThread() noexcept;
     void processModules(std::vector<QByteArray> modules);
     QString addFullFilePath(QStringView file) const noexcept;
 
     LintMessagesSet m_messageSet;
 
+    std::shared_ptr<const Baseline> m_baseline;
+    std::atomic<int> m_suppressedMessages;
+    std::atomic<int> m_wholeProgramMessages;
+    int m_failedShards;
+
+    // Metrics written by the thread that owns the data
+    std::atomic<qint64> m_stdOutBytes;
+    std::atomic<qint64> m_parsedMessages;
+    std::atomic<qint64> m_stitchBytes;
+    std::atomic<qint64> m_uniqueMessages;
+
     std::atomic<bool> m_finished;
     std::unique_ptr<ReaderWriterQueue<QByteArray>> m_dataQueue;
     std::mutex m_mutex;
@@ -18,10 +18,33 @@
 #include "ui_Preferences.h"
 #include "Log.h"
 #include "MainWindow.h"
+#include "Trace.h"
 
 QString Preferences::m_lastDirectory = "";
 
-Preferences::Preferences(QWidget *parent) :
+Lint::Settings Lint::readSettings() noexcept
+{
+    QSettings settings(Lint::SETTINGS_APPLICATION_NAME,QSettings::IniFormat);
+    settings.beginGroup(Lint::SETTINGS_GROUP_NAME);
+    Settings saved{settings.value(Lint::SETTINGS_MAX_THREADS).toInt(),
+                   settings.value(Lint::SETTINGS_LINT_EXECUTABLE_PATH).toString(),
+                   settings.value(Lint::SETTINGS_LINT_FILE_PATH).toString(),
+                   settings.value(Lint::SETTINGS_LAST_DIRECTORY).toString(),
+                   settings.value(Lint::SETTINGS_TRACE, false).toBool(),
+                   settings.value(Lint::SETTINGS_ADAPTIVE, false).toBool(),
+                   settings.value(Lint::SETTINGS_WORKERS).toStringList(),
+                   settings.value(Lint::SETTINGS_WORKER_TOKEN).toString()};
+    settings.endGroup();
+
+    // Listing drives can be slow with network drives mapped
+    if (saved.lastDirectory.isEmpty())
+    {
+        saved.lastDirectory = QDir::drives().first().path();
+    }
+    return saved;
+}
+
+Preferences::Preferences(const Lint::Settings& settings, QWidget *parent) :
     QDialog(parent),
     m_ui(new Ui::Preferences)
 {
@@ -38,18 +61,15 @@ Preferences::Preferences(QWidget *parent) :
         m_ui->lintUsingThreadsComboBox->addItem(QString::number(i));
     }
 
+    // The load decides the threads in adaptive mode
+    QObject::connect(m_ui->adaptiveCheckBox, &QCheckBox::toggled, m_ui->lintUsingThreadsComboBox, &QComboBox::setDisabled);
+
     // TODO: Add default editor to launch log
 
     //m_ui->preferencesTree->setColumnCount(1);
 
     // Load settings
-    loadSettings();
-
-    // If the last directory opened is nothing then set it to the first available drive
-    if (m_lastDirectory.isEmpty())
-    {
-        m_lastDirectory = QDir::drives().first().path();
-    }
+    loadSettings(settings);
 }
 
 Preferences::~Preferences()
@@ -72,6 +92,37 @@ int Preferences::getLintHardwareThreads() const noexcept
     return m_ui->lintUsingThreadsComboBox->currentText().toUInt();
 }
 
+bool Preferences::getAdaptiveConcurrency() const noexcept
+{
+    return m_ui->adaptiveCheckBox->isChecked();
+}
+
+QStringList Preferences::getWorkers() const noexcept
+{
+    QStringList workers = m_ui->workersLineEdit->text().split(',', Qt::SkipEmptyParts);
+    for (auto& worker : workers)
+    {
+        worker = worker.trimmed();
+    }
+    workers.removeAll({});
+    return workers;
+}
+
+QString Preferences::getWorkerToken() const noexcept
+{
+    return m_ui->workerTokenLineEdit->text();
+}
+
+void Preferences::setLintFilePath(const QString& lintFile) noexcept
+{
+    m_ui->lintFileLineEdit->setText(lintFile);
+
+    QSettings settings(Lint::SETTINGS_APPLICATION_NAME,QSettings::IniFormat);
+    settings.beginGroup(Lint::SETTINGS_GROUP_NAME);
+    settings.setValue(Lint::SETTINGS_LINT_FILE_PATH, lintFile);
+    settings.endGroup();
+}
+
 void Preferences::on_lintPathFileOpen_clicked()
 {
     QFileDialog dialogue(this);
@@ -105,29 +156,40 @@ void Preferences::on_buttonSave_clicked()
     settings.setValue(Lint::SETTINGS_LINT_EXECUTABLE_PATH, m_ui->lintPathExeLineEdit->text());
     settings.setValue(Lint::SETTINGS_LINT_FILE_PATH, m_ui->lintFileLineEdit->text());
     settings.setValue(Lint::SETTINGS_LAST_DIRECTORY, m_lastDirectory);
+    settings.setValue(Lint::SETTINGS_TRACE, m_ui->traceCheckBox->isChecked());
+    settings.setValue(Lint::SETTINGS_ADAPTIVE, m_ui->adaptiveCheckBox->isChecked());
+    settings.setValue(Lint::SETTINGS_WORKERS, getWorkers());
+    settings.setValue(Lint::SETTINGS_WORKER_TOKEN, getWorkerToken());
     settings.endGroup();
 
+    Lint::Trace::setEnabled(m_ui->traceCheckBox->isChecked());
+
     close();
 }
 
-void Preferences::loadSettings() noexcept
+void Preferences::loadSettings(const Lint::Settings& settings) noexcept
 {
-    QSettings settings(Lint::SETTINGS_APPLICATION_NAME,QSettings::IniFormat);
-    settings.beginGroup(Lint::SETTINGS_GROUP_NAME);
     // Set default threads to 1 if not selected
-    auto const lintThreads = std::max(settings.value(Lint::SETTINGS_MAX_THREADS).toInt()-1,0);
+    auto const lintThreads = std::max(settings.maxThreads-1,0);
     m_ui->lintUsingThreadsComboBox->setCurrentIndex(lintThreads);
-    m_ui->lintPathExeLineEdit->setText(settings.value(Lint::SETTINGS_LINT_EXECUTABLE_PATH).toString());
-    m_ui->lintFileLineEdit->setText(settings.value(Lint::SETTINGS_LINT_FILE_PATH).toString());
-    m_lastDirectory = settings.value(Lint::SETTINGS_LAST_DIRECTORY).toString();
-    settings.endGroup();
+    m_ui->lintPathExeLineEdit->setText(settings.lintExecutable);
+    m_ui->lintFileLineEdit->setText(settings.lintFile);
+    m_ui->traceCheckBox->setChecked(settings.trace || Lint::Trace::isEnabled());
+    m_ui->adaptiveCheckBox->setChecked(settings.adaptive);
+    m_ui->workersLineEdit->setText(settings.workers.join(", "));
+    m_ui->workerTokenLineEdit->setText(settings.workerToken);
+    // Already filled in at startup and kept up to date by the file dialogs since
+    if (m_lastDirectory.isEmpty())
+    {
+        m_lastDirectory = settings.lastDirectory;
+    }
 }
 
 // Cancel clicked
 void Preferences::on_buttonCancel_clicked()
 {
     close();
-    loadSettings();
+    loadSettings(Lint::readSettings());
 }
 
 // TODO: Reload events on X, doesn't close dialog if reject() overriden for some reason
@@ -135,6 +197,6 @@ void Preferences::on_buttonCancel_clicked()
 /*void Preferences::reject()
 {
     close();
-    loadSettings();
+    loadSettings(Lint::readSettings());
 }
 */
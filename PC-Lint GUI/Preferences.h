@@ -34,6 +34,26 @@ const QString SETTINGS_MAX_THREADS = "MaxThreads";
 const QString SETTINGS_LINT_EXECUTABLE_PATH = "LintExecutablePath";
 const QString SETTINGS_LINT_FILE_PATH = "LintFilePath";
 const QString SETTINGS_LAST_DIRECTORY = "LastDirectory";
+const QString SETTINGS_TRACE = "Trace";
+const QString SETTINGS_ADAPTIVE = "AdaptiveConcurrency";
+const QString SETTINGS_WORKERS = "Workers";
+const QString SETTINGS_WORKER_TOKEN = "WorkerToken";
+
+// Saved settings without the dialog around them
+struct Settings
+{
+    int maxThreads;
+    QString lintExecutable;
+    QString lintFile;
+    QString lastDirectory; // First drive if nothing was saved
+    bool trace;            // Record a pipeline trace
+    bool adaptive;         // Threads and processes follow the system load instead of maxThreads
+    QStringList workers;   // Lint workers ("host:port"), empty to lint locally
+    QString workerToken;   // Shared with the workers, they turn away coordinators without it
+};
+
+// Read the saved settings, safe to call from any thread
+Settings readSettings() noexcept;
 };
 
 namespace Ui
@@ -46,11 +66,19 @@ class Preferences : public QDialog
     Q_OBJECT
 
 public:
-    explicit Preferences(QWidget *parent = nullptr);
+    // Filled in from settings that have already been read
+    explicit Preferences(const Lint::Settings& settings, QWidget *parent = nullptr);
     ~Preferences();
     QString getLintExecutablePath() const noexcept;
     QString getLintFilePath() const noexcept;
     int getLintHardwareThreads() const noexcept;
+    // Pick threads and concurrent lints from the system load
+    bool getAdaptiveConcurrency() const noexcept;
+    // Lint workers ("host:port") to spread the lint over, empty to lint locally
+    QStringList getWorkers() const noexcept;
+    QString getWorkerToken() const noexcept;
+    // Use a different lint file and save it straight away
+    void setLintFilePath(const QString& lintFile) noexcept;
     static QString m_lastDirectory;
     //void reject() override;
 
@@ -62,5 +90,5 @@ private slots:
 
 private:
     Ui::Preferences* m_ui;
-    void loadSettings() noexcept;
+    void loadSettings(const Lint::Settings& settings) noexcept;
 };
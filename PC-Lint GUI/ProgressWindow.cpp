@@ -18,6 +18,9 @@
 #include "ui_ProgressWindow.h"
 #include "PCLintPlus.h"
 #include "Jenkins.h"
+#include "SystemInfo.h"
+#include <QLocale>
+#include <algorithm>
 
 ProgressWindow::ProgressWindow(QWidget *parent) :
     QDialog(parent),
@@ -29,7 +32,9 @@ ProgressWindow::ProgressWindow(QWidget *parent) :
     m_currentFileProgress(0),
     m_aborted(false),
     m_timer(std::make_unique<QTimer>()),
-    m_parent(static_cast<MainWindow*>(parent))
+    m_parent(static_cast<MainWindow*>(parent)),
+    m_lastSample{{0, 0, 0, 0, 0}, 0},
+    m_metricsTimer(std::make_unique<QTimer>())
 {
     setWindowFlags(Qt::Window | Qt::FramelessWindowHint);
 
@@ -39,6 +44,61 @@ ProgressWindow::ProgressWindow(QWidget *parent) :
 
     QObject::connect(m_timer.get(), &QTimer::timeout, this, &ProgressWindow::slotUpdateTime);
     m_ui->eta->setText("Calculating...");
+
+    QObject::connect(m_metricsTimer.get(), &QTimer::timeout, this, &ProgressWindow::updateMetrics);
+}
+
+void ProgressWindow::setMetricsSource(std::function<PipelineSample()> source) noexcept
+{
+    m_metricsSource = std::move(source);
+    m_lastSample = m_metricsSource();
+    m_sampleTimer.start();
+    m_metricsTimer->start(PROGRESS_METRICS_INTERVAL);
+}
+
+void ProgressWindow::updateMetrics() noexcept
+{
+    auto const sample = m_metricsSource();
+    auto const& lint = sample.lint;
+    auto const& last = m_lastSample.lint;
+
+    // Rates over the time actually passed, timers aren't exact
+    auto const seconds = static_cast<double>(std::max<qint64>(m_sampleTimer.restart(), 1)) / 1000.0;
+    auto const rate = [seconds](qint64 now, qint64 before)
+    {
+        return static_cast<qint64>(static_cast<double>(now - before) / seconds);
+    };
+
+    const QLocale locale;
+    m_ui->stdOutRate->setText(locale.formattedDataSize(rate(lint.stdOutBytes, last.stdOutBytes)) + "/s (" +
+                              locale.formattedDataSize(lint.stdOutBytes) + ")");
+    m_ui->messageRate->setText(QString::number(rate(lint.parsedMessages, last.parsedMessages)) + "/s (" +
+                               QString::number(lint.parsedMessages) + ")");
+    m_ui->queueDepth->setText(QString::number(lint.queueDepth));
+    m_ui->stitchBuffer->setText(locale.formattedDataSize(lint.stitchBytes));
+    m_ui->uniqueMessages->setText(QString::number(lint.uniqueMessages));
+    m_ui->modelRows->setText(QString::number(sample.modelRows) + " (" + QString::number(rate(sample.modelRows, m_lastSample.modelRows)) + "/s)");
+
+    auto const residentMemory = Lint::processResidentMemory();
+    m_ui->residentMemory->setText((residentMemory < 0) ? QString("N/A") : locale.formattedDataSize(residentMemory));
+
+    // Whoever has work piling up in front of it is the one holding things up
+    auto const rowBacklog = lint.uniqueMessages - sample.modelRows;
+    auto const lastRowBacklog = last.uniqueMessages - m_lastSample.modelRows;
+    if ((lint.queueDepth >= PROGRESS_QUEUE_BACKLOG) && (lint.queueDepth >= last.queueDepth))
+    {
+        m_ui->bottleneck->setText("Parser (lint output is queueing up)");
+    }
+    else if ((rowBacklog >= PROGRESS_ROW_BACKLOG) && (rowBacklog >= lastRowBacklog))
+    {
+        m_ui->bottleneck->setText("GUI (messages are waiting for the results)");
+    }
+    else
+    {
+        m_ui->bottleneck->setText("PC-Lint");
+    }
+
+    m_lastSample = sample;
 }
 
 void ProgressWindow::slotUpdateProgress() noexcept
@@ -80,6 +140,7 @@ void ProgressWindow::slotLintComplete(const Lint::Status& lintStatus, const QStr
     // TODO: Crash here sometimes on exec?!
     // Close this window first to prevent the main window
     // from minimising on close for some reason
+    m_metricsTimer->stop();
     close();
 
     emit signalLintComplete(lintStatus, errorMessage);
@@ -27,6 +27,8 @@
 #include <QDebug>
 #include <QTimer>
 #include <QThread>
+#include <QElapsedTimer>
+#include <functional>
 
 
 namespace Lint
@@ -36,6 +38,20 @@ class LintManager;
 
 class MainWindow;
 
+// How often the pipeline metrics are sampled (ms)
+constexpr int PROGRESS_METRICS_INTERVAL = 1000;
+// Queued stdout chunks before the parser counts as falling behind
+constexpr qint64 PROGRESS_QUEUE_BACKLOG = 8;
+// Parsed messages not in the results yet before the GUI counts as falling behind
+constexpr qint64 PROGRESS_ROW_BACKLOG = 1000;
+
+// Where the lint's data is, sampled once per interval
+struct PipelineSample
+{
+    Lint::LintMetrics lint;
+    int modelRows; // Messages in the results
+};
+
 namespace Ui
 {
 class ProgressWindow;
@@ -49,6 +65,8 @@ public:
     explicit ProgressWindow(QWidget *parent = nullptr);
     ~ProgressWindow();
     void setTitle(const QString& title) noexcept;
+    // Start sampling the pipeline metrics from here
+    void setMetricsSource(std::function<PipelineSample()> source) noexcept;
 
 public slots:
     void slotUpdateProgress() noexcept;
@@ -74,4 +92,10 @@ private:
     bool m_aborted;
     std::unique_ptr<QTimer> m_timer;
     QMainWindow* m_parent;
+
+    void updateMetrics() noexcept;
+    std::function<PipelineSample()> m_metricsSource;
+    PipelineSample m_lastSample;
+    QElapsedTimer m_sampleTimer;
+    std::unique_ptr<QTimer> m_metricsTimer;
 };
@@ -0,0 +1,285 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "ResultsFile.h"
+#include "Snapshot.h"
+#include "Trace.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QVector>
+#include <QXmlStreamReader>
+#include <QtConcurrent>
+#include <QDebug>
+#include <algorithm>
+
+namespace Lint
+{
+
+namespace
+{
+    constexpr std::string_view MESSAGE_OPEN = "<m>";
+    constexpr std::string_view MODULE_STRING = DATA_MODULE_STRING;
+
+    // Messages of one piece or why it couldn't be parsed
+    struct ParsedPiece
+    {
+        LintMessages messages;
+        QString error;
+    };
+
+    struct ParsePiece
+    {
+        using result_type = ParsedPiece;
+
+        std::string_view data;
+
+        ParsedPiece operator()(const ResultsPiece& piece) const noexcept
+        {
+            ParsedPiece parsed;
+            parseResultsPiece(data.substr(static_cast<size_t>(piece.begin), static_cast<size_t>(piece.end - piece.begin)),
+                              parsed.messages, parsed.error);
+            return parsed;
+        }
+    };
+};
+
+std::vector<ResultsPiece> splitResults(std::string_view data, qint64 pieceSize) noexcept
+{
+    std::vector<ResultsPiece> pieces;
+    auto const size = static_cast<qint64>(data.size());
+
+    qint64 begin = 0;
+    while (begin < size)
+    {
+        auto end = begin + pieceSize;
+        if (end >= size)
+        {
+            pieces.push_back({begin, size});
+            break;
+        }
+
+        // Modules never share messages so they are the natural place to split
+        // Without module lines (no -v option) any message will do, the groups are put back together when merging
+        // Only look one piece ahead for a module line, otherwise every piece would search the rest of the file
+        auto const window = data.substr(static_cast<size_t>(end), static_cast<size_t>(pieceSize) + MODULE_STRING.size());
+        auto boundary = window.find(MODULE_STRING);
+        if (boundary != std::string_view::npos)
+        {
+            boundary += static_cast<size_t>(end);
+        }
+        else
+        {
+            // Messages are close together, this only searches far at the end of the file
+            boundary = data.find(MESSAGE_OPEN, static_cast<size_t>(end));
+        }
+        end = (boundary == std::string_view::npos) ? size : static_cast<qint64>(boundary);
+
+        pieces.push_back({begin, end});
+        begin = end;
+    }
+
+    return pieces;
+}
+
+bool parseResultsPiece(std::string_view piece, LintMessages& messages, QString& error) noexcept
+{
+    TraceScope trace("parseResultsPiece");
+
+    // Each piece needs a root element of its own for the XML reader
+    // Several runs appended to one file have a <doc> each, they are dropped like a stitched module's
+    QByteArray xml(piece.data(), static_cast<int>(piece.size()));
+    xml.replace(Xml::XML_TAG_DOC_OPEN, "");
+    xml.replace(Xml::XML_TAG_DOC_CLOSED, "");
+    xml.prepend(Xml::XML_TAG_DOC_OPEN);
+    xml.append(Xml::XML_TAG_DOC_CLOSED);
+
+    QXmlStreamReader lintXML(xml);
+    LintMessage message{};
+
+    while (!lintXML.atEnd() && !lintXML.hasError())
+    {
+        auto const token = lintXML.readNext();
+        if (token == QXmlStreamReader::StartElement)
+        {
+            if (lintXML.name() == Xml::XML_ELEMENT_MESSAGE)
+            {
+                message = LintMessage{};
+            }
+            else if (lintXML.name() == Xml::XML_ELEMENT_FILE)
+            {
+                message.file = QDir::toNativeSeparators(lintXML.readElementText());
+            }
+            else if (lintXML.name() == Xml::XML_ELEMENT_LINE)
+            {
+                message.line = lintXML.readElementText().toInt();
+            }
+            else if (lintXML.name() == Xml::XML_ELEMENT_MESSAGE_TYPE)
+            {
+                message.type = lintXML.readElementText();
+            }
+            else if (lintXML.name() == Xml::XML_ELEMENT_MESSAGE_NUMBER)
+            {
+                message.number = lintXML.readElementText().toInt();
+            }
+            else if (lintXML.name() == Xml::XML_ELEMENT_DESCRIPTION)
+            {
+                message.description = lintXML.readElementText();
+            }
+        }
+        else if ((token == QXmlStreamReader::EndElement) && (lintXML.name() == Xml::XML_ELEMENT_MESSAGE))
+        {
+            messages.emplace_back(std::move(message));
+        }
+    }
+
+    if (lintXML.hasError())
+    {
+        error = QString("%1 (line %2, column %3)").arg(lintXML.errorString()).arg(lintXML.lineNumber()).arg(lintXML.columnNumber());
+        return false;
+    }
+    return true;
+}
+
+ResultsFile readResultsFile(const QString& file, std::shared_ptr<const Baseline> baseline, qint64 pieceSize, qint64 windowSize) noexcept
+{
+    TraceScope trace("readResultsFile");
+    ResultsFile results{};
+
+    QFile input(file);
+    if (!input.open(QIODevice::ReadOnly))
+    {
+        results.error = input.errorString();
+        return results;
+    }
+
+    // Pieces are merged in file order so supplementals stay behind their message
+    // Lint reports a header's messages again for every module including it, only the first is kept
+    auto const directory = QFileInfo(file).absoluteDir();
+    QHash<QString, QString> paths;
+    auto const resolve = [&directory, &paths](const QString& path)
+    {
+        auto resolved = paths.find(path);
+        if (resolved == paths.end())
+        {
+            auto const relative = !path.isEmpty() && QFileInfo(path).isRelative() && directory.exists(path);
+            resolved = paths.insert(path, relative ? QFileInfo(directory.filePath(path)).canonicalFilePath() : path);
+        }
+        return resolved.value();
+    };
+
+    LintMessagesSet seen;
+    bool keep = false;
+    auto const merge = [&](LintMessages& messages)
+    {
+        for (auto& message : messages)
+        {
+            results.parsedMessages++;
+
+            // Supplementals follow whatever happened to their message
+            if (message.type != Type::TYPE_SUPPLEMENTAL)
+            {
+                message.file = resolve(message.file);
+                keep = !(baseline && baseline->contains(message));
+                if (keep)
+                {
+                    auto const unique = seen.size();
+                    seen.insert(message);
+                    keep = (seen.size() != unique);
+                }
+            }
+            else
+            {
+                message.file = resolve(message.file);
+            }
+
+            if (keep)
+            {
+                results.messages.emplace_back(std::move(message));
+            }
+        }
+    };
+
+    auto const fail = [&results, &file](const QString& error)
+    {
+        results.error = "Unable to read " + QDir::toNativeSeparators(file) + ": " + error;
+        results.messages.clear();
+        return results;
+    };
+
+    // Mapped so the file is never copied, a window at a time so any size fits in memory
+    // The last piece of a window may be cut off, the next window starts with it
+    auto const size = input.size();
+    qint64 offset = 0;
+    while (offset < size)
+    {
+        auto const length = std::min(windowSize, size - offset);
+        auto* const mapped = input.map(offset, length);
+        if (!mapped)
+        {
+            return fail("Unable to map " + QString::number(length) + " bytes at " + QString::number(offset) + ": " + input.errorString());
+        }
+        std::string_view data(reinterpret_cast<const char*>(mapped), static_cast<size_t>(length));
+        auto const last = (offset + length == size);
+
+        // Only what's inside the document is split, a capture cut short by a crash has no </doc>
+        size_t begin = 0;
+        if (offset == 0)
+        {
+            begin = data.find(Xml::XML_TAG_DOC_OPEN);
+            begin = (begin == std::string_view::npos) ? 0 : begin + std::char_traits<char>::length(Xml::XML_TAG_DOC_OPEN);
+        }
+        auto end = last ? data.rfind(Xml::XML_TAG_DOC_CLOSED) : std::string_view::npos;
+        if ((end == std::string_view::npos) || (end < begin))
+        {
+            end = data.size();
+        }
+        data = data.substr(begin, end - begin);
+
+        auto split = splitResults(data, pieceSize);
+        auto next = size;
+        if (!last)
+        {
+            if (split.size() < 2)
+            {
+                input.unmap(mapped);
+                return fail("No module or message starts within " + QString::number(windowSize) + " bytes at " + QString::number(offset));
+            }
+            next = offset + static_cast<qint64>(begin) + split.back().begin;
+            split.pop_back();
+        }
+
+        results.pieces += static_cast<int>(split.size());
+        auto parsed = QtConcurrent::blockingMapped<QVector<ParsedPiece>>(QVector<ResultsPiece>(split.begin(), split.end()), ParsePiece{data});
+        input.unmap(mapped);
+
+        for (auto& piece : parsed)
+        {
+            if (!piece.error.isEmpty())
+            {
+                return fail(piece.error);
+            }
+            merge(piece.messages);
+        }
+        offset = next;
+    }
+
+    qInfo() << "Read" << results.parsedMessages << "messages from" << file << "in" << results.pieces << "pieces," << results.messages.size() << "kept";
+    return results;
+}
+
+};
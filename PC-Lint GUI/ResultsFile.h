@@ -0,0 +1,64 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QString>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "PCLintPlus.h"
+
+namespace Lint
+{
+
+class Baseline;
+
+// Saved output is parsed in pieces of about this size, one piece per worker at a time
+constexpr qint64 RESULTS_PIECE_SIZE = 16 << 20;
+// At most this much of the file is mapped at once so large captures fit a 32-bit address space
+constexpr qint64 RESULTS_WINDOW_SIZE = 256 << 20;
+
+// Part of a saved lint output that can be parsed on its own
+struct ResultsPiece
+{
+    qint64 begin; // Offset of the first byte
+    qint64 end;   // Offset one past the last byte
+};
+
+// Messages read from a saved lint output
+struct ResultsFile
+{
+    LintMessages messages; // Lint order, duplicates and baseline messages removed
+    qint64 parsedMessages; // Everything in the file
+    int pieces;            // Pieces parsed in parallel
+    QString error;         // Empty if it worked
+};
+
+// Split the contents of a <doc> into pieces of about pieceSize
+// Pieces end where a module starts, or at a message if the output has no module lines
+std::vector<ResultsPiece> splitResults(std::string_view data, qint64 pieceSize) noexcept;
+
+// Messages of one piece in the order lint wrote them, false with error set if the XML is broken
+bool parseResultsPiece(std::string_view piece, LintMessages& messages, QString& error) noexcept;
+
+// Read a file written by PC-Lint Plus with the XML -format
+// The file is mapped a window at a time, each window split at module boundaries and the pieces parsed on all cores
+// Relative paths are taken from the directory of the file if they exist there
+ResultsFile readResultsFile(const QString& file, std::shared_ptr<const Baseline> baseline,
+                            qint64 pieceSize = RESULTS_PIECE_SIZE, qint64 windowSize = RESULTS_WINDOW_SIZE) noexcept;
+
+};
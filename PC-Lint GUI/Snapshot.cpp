@@ -0,0 +1,254 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Snapshot.h"
+#include <QDataStream>
+#include <QDir>
+#include <QHash>
+#include <algorithm>
+
+namespace Lint
+{
+
+namespace
+{
+    // 64-bit FNV-1a
+    constexpr Fingerprint FNV_OFFSET = 14695981039346656037ULL;
+    constexpr Fingerprint FNV_PRIME = 1099511628211ULL;
+
+    inline void hashData(Fingerprint& hash, const QChar* data, int size) noexcept
+    {
+        for (int i = 0; i < size; i++)
+        {
+            hash ^= data[i].unicode();
+            hash *= FNV_PRIME;
+        }
+    }
+
+    // Drive letters count as absolute on every platform so snapshots from Windows compare anywhere
+    bool isAbsolutePath(const QString& path) noexcept
+    {
+        return path.startsWith('/') || ((path.size() > 2) && path[0].isLetter() && (path[1] == ':') && (path[2] == '/'));
+    }
+
+    // Clean '/' separated path, case folded where the file system ignores case
+    QString normalizedPath(const QString& path) noexcept
+    {
+        // PC-Lint Plus mixes '/' and '\\' in the same path
+        auto normalized = QDir::cleanPath(QString(path).replace('\\', '/'));
+#ifdef Q_OS_WIN
+        normalized = normalized.toCaseFolded();
+#endif
+        return normalized;
+    }
+
+    // Path relative to root, paths outside root stay absolute
+    QString relativePath(const QString& file, const QString& root) noexcept
+    {
+        auto const base = normalizedPath(root);
+        auto path = QString(file).replace('\\', '/');
+        if (!base.isEmpty() && !isAbsolutePath(path))
+        {
+            path = base + '/' + path;
+        }
+        path = normalizedPath(path);
+
+        if (!base.isEmpty() && path.startsWith(base + '/'))
+        {
+            path.remove(0, base.size() + 1);
+        }
+        return path;
+    }
+};
+
+Fingerprint fingerprint(const QString& file, int number, const QString& description, const QString& root) noexcept
+{
+    auto const path = relativePath(file, root);
+
+    Fingerprint hash = FNV_OFFSET;
+    hashData(hash, path.constData(), path.size());
+    hash ^= static_cast<quint32>(number);
+    hash *= FNV_PRIME;
+    hashData(hash, description.constData(), description.size());
+    return hash;
+}
+
+void Snapshot::append(const LintMessage& message)
+{
+    m_messages.emplace_back(message);
+}
+
+void Snapshot::clear() noexcept
+{
+    m_messages.clear();
+}
+
+bool Snapshot::isEmpty() const noexcept
+{
+    return m_messages.empty();
+}
+
+const LintMessages& Snapshot::messages() const noexcept
+{
+    return m_messages;
+}
+
+bool Snapshot::save(const QString& file) const noexcept
+{
+    QFile snapshotFile(file);
+    if (!snapshotFile.open(QIODevice::WriteOnly))
+    {
+        qCritical() << "Failed to save snapshot:" << file << snapshotFile.errorString();
+        return false;
+    }
+
+    QDataStream stream(&snapshotFile);
+    stream << SNAPSHOT_MAGIC << SNAPSHOT_VERSION << static_cast<quint32>(m_messages.size());
+    for (auto const& message : m_messages)
+    {
+        stream << message.file << static_cast<qint32>(message.line) << message.type
+               << static_cast<qint32>(message.number) << message.description;
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+bool Snapshot::load(const QString& file) noexcept
+{
+    QFile snapshotFile(file);
+    if (!snapshotFile.open(QIODevice::ReadOnly))
+    {
+        qCritical() << "Failed to load snapshot:" << file << snapshotFile.errorString();
+        return false;
+    }
+
+    QDataStream stream(&snapshotFile);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 count = 0;
+    stream >> magic >> version >> count;
+    if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION)
+    {
+        qCritical() << "Not a snapshot file:" << file;
+        return false;
+    }
+
+    LintMessages messages;
+    messages.reserve(count);
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++)
+    {
+        LintMessage message;
+        qint32 line = 0;
+        qint32 number = 0;
+        stream >> message.file >> line >> message.type >> number >> message.description;
+        message.line = line;
+        message.number = number;
+        messages.emplace_back(std::move(message));
+    }
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        qCritical() << "Snapshot file is corrupt:" << file;
+        return false;
+    }
+
+    m_messages = std::move(messages);
+    return true;
+}
+
+Baseline::Baseline(const LintMessages& messages, const QString& root) :
+    m_root(root)
+{
+    m_fingerprints.reserve(messages.size());
+    for (auto const& message : messages)
+    {
+        if (message.type != Type::TYPE_SUPPLEMENTAL)
+        {
+            m_fingerprints.emplace_back(fingerprint(message, m_root));
+        }
+    }
+
+    std::sort(m_fingerprints.begin(), m_fingerprints.end());
+    m_fingerprints.erase(std::unique(m_fingerprints.begin(), m_fingerprints.end()), m_fingerprints.end());
+    m_fingerprints.shrink_to_fit();
+}
+
+bool Baseline::contains(const LintMessage& message) const noexcept
+{
+    return std::binary_search(m_fingerprints.cbegin(), m_fingerprints.cend(), fingerprint(message, m_root));
+}
+
+int Baseline::size() const noexcept
+{
+    return static_cast<int>(m_fingerprints.size());
+}
+
+RunDiff diffRuns(const LintMessages& previous, const LintMessages& current, const QString& root) noexcept
+{
+    RunDiff diff;
+
+    // Count every fingerprint of the previous run
+    QHash<Fingerprint, int> remaining;
+    remaining.reserve(static_cast<int>(previous.size()));
+    for (auto const& message : previous)
+    {
+        if (message.type != Type::TYPE_SUPPLEMENTAL)
+        {
+            remaining[fingerprint(message, root)]++;
+        }
+    }
+
+    // Match the current run against it
+    for (int i = 0; i < static_cast<int>(current.size()); i++)
+    {
+        auto const& message = current[i];
+        if (message.type == Type::TYPE_SUPPLEMENTAL)
+        {
+            continue;
+        }
+
+        auto it = remaining.find(fingerprint(message, root));
+        if (it != remaining.end() && it.value() > 0)
+        {
+            it.value()--;
+            diff.buckets[DIFF_UNCHANGED].emplace_back(i);
+        }
+        else
+        {
+            diff.buckets[DIFF_NEW].emplace_back(i);
+        }
+    }
+
+    // Whatever is left over in the previous run has been fixed
+    for (int i = 0; i < static_cast<int>(previous.size()); i++)
+    {
+        auto const& message = previous[i];
+        if (message.type == Type::TYPE_SUPPLEMENTAL)
+        {
+            continue;
+        }
+
+        auto it = remaining.find(fingerprint(message, root));
+        if (it != remaining.end() && it.value() > 0)
+        {
+            it.value()--;
+            diff.buckets[DIFF_FIXED].emplace_back(i);
+        }
+    }
+
+    return diff;
+}
+
+};
@@ -0,0 +1,100 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QString>
+#include <array>
+#include <vector>
+#include "PCLintPlus.h"
+
+namespace Lint
+{
+
+// Snapshot file identification
+constexpr quint32 SNAPSHOT_MAGIC = 0x50434C53; // "PCLS"
+constexpr quint32 SNAPSHOT_VERSION = 1;
+
+using Fingerprint = quint64;
+
+// Identify a message independently of its line number
+// so the same message still matches after code above it has been edited
+// Paths are taken relative to root (the lint file's directory) so raw lint paths, resolved paths
+// and runs from other checkouts match while same-named files in different directories don't
+Fingerprint fingerprint(const QString& file, int number, const QString& description, const QString& root) noexcept;
+
+inline Fingerprint fingerprint(const LintMessage& message, const QString& root) noexcept
+{
+    return fingerprint(message.file, message.number, message.description, root);
+}
+
+// The messages of a lint run that can be saved and compared against later
+class Snapshot
+{
+public:
+    void append(const LintMessage& message);
+    void clear() noexcept;
+    bool isEmpty() const noexcept;
+    const LintMessages& messages() const noexcept;
+
+    bool save(const QString& file) const noexcept;
+    bool load(const QString& file) noexcept;
+
+private:
+    LintMessages m_messages;
+};
+
+// Compact set of message fingerprints from a previous run
+// Messages found in the baseline are known and are dropped as soon as they are parsed
+class Baseline
+{
+public:
+    // root is the lint file's directory the messages' paths are relative to
+    Baseline(const LintMessages& messages, const QString& root);
+
+    bool contains(const LintMessage& message) const noexcept;
+    int size() const noexcept;
+
+private:
+    QString m_root;
+    // Sorted and unique
+    std::vector<Fingerprint> m_fingerprints;
+};
+
+enum DiffBucket
+{
+    // In the current run only
+    DIFF_NEW,
+    // In the previous run only
+    DIFF_FIXED,
+    // In both runs
+    DIFF_UNCHANGED,
+    DIFF_BUCKET_COUNT
+};
+
+// Result of comparing two runs
+// DIFF_FIXED indexes the previous run, the other buckets index the current run
+struct RunDiff
+{
+    std::array<std::vector<int>, DIFF_BUCKET_COUNT> buckets;
+};
+
+// Compare two runs by fingerprint
+// Identical messages are matched one to one so duplicates are counted correctly
+// Supplemental messages are ignored
+RunDiff diffRuns(const LintMessages& previous, const LintMessages& current, const QString& root) noexcept;
+
+};
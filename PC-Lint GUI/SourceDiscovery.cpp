@@ -0,0 +1,248 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "SourceDiscovery.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QHash>
+#include <QRegularExpression>
+#include <QElapsedTimer>
+#include <QtConcurrent>
+#include <QDebug>
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <mutex>
+
+namespace Lint
+{
+
+namespace
+{
+    // Names in one directory as last listed
+    struct DirectoryListing
+    {
+        QDateTime lastModified;
+        QStringList files;
+        QStringList directories;
+    };
+
+    using Listing = std::shared_ptr<const DirectoryListing>;
+
+    // Listing of a directory, from the snapshot while the directory is unchanged
+    Listing listDirectory(const QString& directory) noexcept
+    {
+        static std::mutex mutex;
+        static QHash<QString, Listing> snapshot;
+
+        auto const lastModified = QFileInfo(directory).lastModified();
+        {
+            std::scoped_lock lock(mutex);
+            auto const cached = snapshot.constFind(directory);
+            if ((cached != snapshot.constEnd()) && ((*cached)->lastModified == lastModified))
+            {
+                return *cached;
+            }
+        }
+
+        auto listing = std::make_shared<DirectoryListing>();
+        listing->lastModified = lastModified;
+        QDirIterator iterator(directory, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
+        while (iterator.hasNext())
+        {
+            iterator.next();
+            auto const fileInfo = iterator.fileInfo();
+            if (fileInfo.isDir())
+            {
+                // Links could loop back up the tree
+                if (!fileInfo.isSymLink())
+                {
+                    listing->directories << fileInfo.fileName();
+                }
+            }
+            else
+            {
+                listing->files << fileInfo.fileName();
+            }
+        }
+
+        std::scoped_lock lock(mutex);
+        snapshot.insert(directory, listing);
+        return listing;
+    }
+
+    // Lists one directory of a walk, given relative to the base of the walk
+    struct ListDirectory
+    {
+        using result_type = Listing;
+
+        QString base;
+
+        Listing operator()(const QString& relative) const noexcept
+        {
+            return listDirectory(base + relative);
+        }
+    };
+
+    // Canonical path of a discovered file, empty for a broken link
+    struct CanonicalPath
+    {
+        using result_type = QString;
+
+        QString operator()(const QString& file) const noexcept
+        {
+            return QFileInfo(file).canonicalFilePath();
+        }
+    };
+
+    // Files under a directory relative to it, down to a depth (1 is the directory itself)
+    QStringList walk(const QString& base, int maxDepth) noexcept
+    {
+        QStringList files;
+        QStringList level{QString()};
+        const ListDirectory listDirectory{base.endsWith('/') ? base : (base + '/')};
+        for (int depth = 1; !level.isEmpty(); depth++)
+        {
+            auto const listings = QtConcurrent::blockingMapped<QList<Listing>>(level, listDirectory);
+
+            QStringList nextLevel;
+            for (int directory = 0; directory < level.size(); directory++)
+            {
+                auto const& relative = level[directory];
+                for (auto const& file : listings[directory]->files)
+                {
+                    files << (relative + file);
+                }
+                if (depth < maxDepth)
+                {
+                    for (auto const& subdirectory : listings[directory]->directories)
+                    {
+                        nextLevel << (relative + subdirectory + '/');
+                    }
+                }
+            }
+            level = std::move(nextLevel);
+        }
+        return files;
+    }
+
+    // Regular expression for wildcard path segments
+    // * and ? don't match across directories, a ** segment matches any number of directories
+    QString wildcardExpression(const QStringList& segments) noexcept
+    {
+        QString expression;
+        for (int segment = 0; segment < segments.size(); segment++)
+        {
+            if (segments[segment] == "**")
+            {
+                expression += (segment + 1 < segments.size()) ? "(.*/)?" : ".*";
+                continue;
+            }
+
+            auto part = QRegularExpression::escape(segments[segment]);
+            part.replace("\\*", "[^/]*");
+            part.replace("\\?", "[^/]");
+            expression += part;
+            if (segment + 1 < segments.size())
+            {
+                expression += '/';
+            }
+        }
+        return expression;
+    }
+};
+
+bool isModulePattern(const QString& module) noexcept
+{
+    return module.contains('*') || module.contains('?');
+}
+
+QStringList discoverSources(const QString& module, const SourceDiscoveryOptions& options) noexcept
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // Split into the directory the walk starts from and what has to match under it
+    auto const segments = QDir::cleanPath(QDir::fromNativeSeparators(module)).split('/');
+    auto const firstPattern = std::find_if(segments.cbegin(), segments.cend(), isModulePattern);
+    auto base = QStringList(segments.cbegin(), firstPattern).join('/');
+    const QStringList rest(firstPattern, segments.cend());
+
+    // Names or relative paths to keep and how deep to look for them
+    QString expression;
+    bool matchName = true;
+    int maxDepth = options.recursive ? INT_MAX : 1;
+    if (rest.isEmpty())
+    {
+        QStringList extensions;
+        for (auto const& extension : options.extensions)
+        {
+            extensions << QRegularExpression::escape(extension);
+        }
+        expression = ".*\\.(" + extensions.join('|') + ")";
+    }
+    else if ((rest.size() == 1) && (rest.front() != "**"))
+    {
+        expression = wildcardExpression(rest);
+    }
+    else
+    {
+        matchName = false;
+        expression = wildcardExpression(rest);
+        maxDepth = rest.contains("**") ? INT_MAX : rest.size();
+    }
+
+    if (base.isEmpty())
+    {
+        base = "/";
+    }
+    if (!QFileInfo(base).isDir())
+    {
+        return {};
+    }
+
+#ifdef Q_OS_WIN
+    const QRegularExpression match("^" + expression + "$", QRegularExpression::CaseInsensitiveOption);
+#else
+    const QRegularExpression match("^" + expression + "$");
+#endif
+
+    auto const prefix = base.endsWith('/') ? base : (base + '/');
+    QStringList matches;
+    auto const files = walk(base, maxDepth);
+    for (auto const& file : files)
+    {
+        auto const name = matchName ? file.mid(file.lastIndexOf('/') + 1) : file;
+        if (match.match(name).hasMatch())
+        {
+            matches << (prefix + file);
+        }
+    }
+
+    // Modules are looked up by canonical path everywhere else, a link or a different case must not make another file
+    auto sources = QtConcurrent::blockingMapped<QStringList>(matches, CanonicalPath{});
+    // Broken links have no canonical path
+    sources.removeAll(QString());
+    sources.sort();
+    sources.removeDuplicates();
+
+    qDebug() << "Discovered" << sources.size() << "of" << files.size() << "files for" << module << "in" << timer.elapsed() << "ms";
+    return sources;
+}
+
+};
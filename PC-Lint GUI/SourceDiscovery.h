@@ -0,0 +1,44 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+namespace Lint
+{
+
+// Extensions of the files a directory module stands for (PC-Lint's defaults)
+const QStringList SOURCE_DEFAULT_EXTENSIONS = {"c", "cpp", "cxx"};
+
+// How module wildcards and directories are expanded
+struct SourceDiscoveryOptions
+{
+    bool recursive;         // Look in subdirectories too (-subdir)
+    QStringList extensions; // Without the dot, for directory modules
+};
+
+// Whether a module name has wildcards in it
+bool isModulePattern(const QString& module) noexcept;
+
+// Canonical paths of the files a module wildcard (src/*.c, src/**/*.c) or directory stands for, sorted
+// The module must be an absolute path
+// Directories are walked level by level with every level listed in parallel and listings are kept
+// between calls, a directory is only listed again once its modification time changes
+QStringList discoverSources(const QString& module, const SourceDiscoveryOptions& options) noexcept;
+
+};
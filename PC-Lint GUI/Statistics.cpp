@@ -0,0 +1,181 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Statistics.h"
+
+namespace Lint
+{
+
+Statistics::Statistics() :
+    m_messages(0)
+{
+
+}
+
+bool Statistics::addMessage(const LintMessage& message) noexcept
+{
+    if (message.type == Type::TYPE_SUPPLEMENTAL)
+    {
+        return false;
+    }
+
+    m_messages++;
+    m_numbers[message.number]++;
+
+    auto it = m_files.find(message.file);
+    auto const newFile = (it == m_files.end());
+    if (newFile)
+    {
+        auto const directory = QDir::toNativeSeparators(QFileInfo(message.file).path());
+        it = m_files.insert(message.file, FileStatistics{0, 0, directory});
+    }
+    it->messages++;
+
+    auto& directory = m_directories[it->directory];
+    directory.messages++;
+
+    return newFile;
+}
+
+void Statistics::removeMessage(const LintMessage& message) noexcept
+{
+    if (message.type == Type::TYPE_SUPPLEMENTAL)
+    {
+        return;
+    }
+
+    auto const file = m_files.find(message.file);
+    if (file == m_files.end())
+    {
+        return;
+    }
+
+    m_messages--;
+
+    auto const number = m_numbers.find(message.number);
+    if (number != m_numbers.end() && --number.value() == 0)
+    {
+        m_numbers.erase(number);
+    }
+
+    auto const directory = m_directories.find(file->directory);
+    if (directory != m_directories.end())
+    {
+        directory->messages--;
+        if (file->messages == 1)
+        {
+            directory->lines -= file->lines;
+        }
+        if (directory->messages == 0)
+        {
+            m_directories.erase(directory);
+        }
+    }
+
+    // The lines are counted again if the file comes back
+    if (--file->messages == 0)
+    {
+        m_files.erase(file);
+    }
+}
+
+void Statistics::setFileLines(const QString& file, int lines) noexcept
+{
+    auto it = m_files.find(file);
+    if (it == m_files.end())
+    {
+        return;
+    }
+
+    m_directories[it->directory].lines += lines - it->lines;
+    it->lines = lines;
+}
+
+void Statistics::clear() noexcept
+{
+    m_messages = 0;
+    m_numbers.clear();
+    m_files.clear();
+    m_directories.clear();
+}
+
+int Statistics::messages() const noexcept
+{
+    return m_messages;
+}
+
+StatisticsEntries Statistics::topNumbers(int count) const noexcept
+{
+    StatisticsEntries entries;
+    entries.reserve(m_numbers.size());
+    for (auto it = m_numbers.cbegin(); it != m_numbers.cend(); ++it)
+    {
+        entries.emplace_back(StatisticsEntry{QString::number(it.key()), it.value(), 0, 0.0});
+    }
+
+    auto const top = entries.begin() + std::min<size_t>(count, entries.size());
+    std::partial_sort(entries.begin(), top, entries.end(), [](const StatisticsEntry& entry1, const StatisticsEntry& entry2)
+    {
+        return entry1.messages > entry2.messages;
+    });
+    entries.erase(top, entries.end());
+    return entries;
+}
+
+StatisticsEntries Statistics::densestFiles(int count) const noexcept
+{
+    StatisticsEntries entries;
+    entries.reserve(m_files.size());
+    for (auto it = m_files.cbegin(); it != m_files.cend(); ++it)
+    {
+        // Density is unknown until the lines have been counted
+        if (it->lines > 0)
+        {
+            entries.emplace_back(StatisticsEntry{it.key(), it->messages, it->lines, density(it->messages, it->lines)});
+        }
+    }
+
+    auto const top = entries.begin() + std::min<size_t>(count, entries.size());
+    std::partial_sort(entries.begin(), top, entries.end(), [](const StatisticsEntry& entry1, const StatisticsEntry& entry2)
+    {
+        return entry1.density > entry2.density;
+    });
+    entries.erase(top, entries.end());
+    return entries;
+}
+
+StatisticsEntries Statistics::directories() const noexcept
+{
+    StatisticsEntries entries;
+    entries.reserve(m_directories.size());
+    for (auto it = m_directories.cbegin(); it != m_directories.cend(); ++it)
+    {
+        entries.emplace_back(StatisticsEntry{it.key(), it->messages, it->lines, density(it->messages, it->lines)});
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const StatisticsEntry& entry1, const StatisticsEntry& entry2)
+    {
+        return entry1.messages > entry2.messages;
+    });
+    return entries;
+}
+
+double Statistics::density(int messages, int lines) noexcept
+{
+    return (lines > 0) ? (messages * 1000.0 / lines) : 0.0;
+}
+
+};
@@ -0,0 +1,83 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QString>
+#include <QHash>
+#include <vector>
+#include "PCLintPlus.h"
+
+namespace Lint
+{
+
+// A single row of a statistics view
+struct StatisticsEntry
+{
+    QString name;   // Message number, file or directory
+    int messages;   // Number of messages
+    int lines;      // Source lines (0 if unknown)
+    double density; // Messages per 1000 lines (0 if unknown)
+};
+
+using StatisticsEntries = std::vector<StatisticsEntry>;
+
+// Run statistics updated incrementally as messages are ingested
+// Supplemental messages are not counted
+class Statistics
+{
+public:
+    Statistics();
+
+    // Count a message, returns true if its file has not been seen before
+    bool addMessage(const LintMessage& message) noexcept;
+    // Uncount a message, a file or directory left with no messages is dropped
+    void removeMessage(const LintMessage& message) noexcept;
+    // Set the number of source lines in a file once known
+    void setFileLines(const QString& file, int lines) noexcept;
+    void clear() noexcept;
+
+    int messages() const noexcept;
+    // Most frequent message numbers
+    StatisticsEntries topNumbers(int count) const noexcept;
+    // Files with the most messages per 1000 lines
+    StatisticsEntries densestFiles(int count) const noexcept;
+    // All directories with messages
+    StatisticsEntries directories() const noexcept;
+
+private:
+    struct FileStatistics
+    {
+        int messages;
+        int lines;
+        QString directory;
+    };
+
+    struct DirectoryStatistics
+    {
+        int messages;
+        int lines;
+    };
+
+    static double density(int messages, int lines) noexcept;
+
+    int m_messages;
+    QHash<int, int> m_numbers;
+    QHash<QString, FileStatistics> m_files;
+    QHash<QString, DirectoryStatistics> m_directories;
+};
+
+};
@@ -0,0 +1,343 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "StatisticsWindow.h"
+#include <QVBoxLayout>
+#include <QHeaderView>
+#include <QPainter>
+#include <QHelpEvent>
+#include <QToolTip>
+#include <QtConcurrent>
+#include <limits>
+
+namespace Lint
+{
+
+TreemapWidget::TreemapWidget(QWidget* parent) :
+    QWidget(parent),
+    m_maxDensity(0.0)
+{
+    setMinimumSize(200, 150);
+}
+
+void TreemapWidget::setEntries(StatisticsEntries entries) noexcept
+{
+    if (static_cast<int>(entries.size()) > STATISTICS_TREEMAP_MAX)
+    {
+        entries.resize(STATISTICS_TREEMAP_MAX);
+    }
+
+    m_entries = std::move(entries);
+    m_maxDensity = 0.0;
+    for (auto const& entry : m_entries)
+    {
+        m_maxDensity = std::max(m_maxDensity, entry.density);
+    }
+
+    updateLayout();
+    update();
+}
+
+// Squarified treemap layout
+// Entries are sorted largest first and laid out in rows along the shorter side
+void TreemapWidget::updateLayout() noexcept
+{
+    m_rects.clear();
+
+    double total = 0.0;
+    for (auto const& entry : m_entries)
+    {
+        total += entry.messages;
+    }
+    if (total <= 0.0 || width() <= 0 || height() <= 0)
+    {
+        return;
+    }
+
+    QRectF rect(this->rect());
+    auto const scale = (rect.width() * rect.height()) / total;
+
+    size_t start = 0;
+    while (start < m_entries.size())
+    {
+        auto const side = std::min(rect.width(), rect.height());
+        auto const horizontal = (rect.width() >= rect.height());
+
+        // Grow the row while the worst aspect ratio keeps improving
+        double rowArea = 0.0;
+        double rowMin = std::numeric_limits<double>::max();
+        double rowMax = 0.0;
+        double best = std::numeric_limits<double>::max();
+        size_t end = start;
+        while (end < m_entries.size())
+        {
+            auto const area = m_entries[end].messages * scale;
+            auto const sum = rowArea + area;
+            auto const minimum = std::min(rowMin, area);
+            auto const maximum = std::max(rowMax, area);
+            auto const ratio = std::max((side * side * maximum) / (sum * sum), (sum * sum) / (side * side * minimum));
+            if (end > start && ratio > best)
+            {
+                break;
+            }
+            best = ratio;
+            rowArea = sum;
+            rowMin = minimum;
+            rowMax = maximum;
+            end++;
+        }
+
+        auto const thickness = rowArea / side;
+        double offset = 0.0;
+        for (auto i = start; i < end; i++)
+        {
+            auto const length = (m_entries[i].messages * scale) / thickness;
+            if (horizontal)
+            {
+                m_rects.emplace_back(rect.left(), rect.top() + offset, thickness, length);
+            }
+            else
+            {
+                m_rects.emplace_back(rect.left() + offset, rect.top(), length, thickness);
+            }
+            offset += length;
+        }
+
+        if (horizontal)
+        {
+            rect.setLeft(rect.left() + thickness);
+        }
+        else
+        {
+            rect.setTop(rect.top() + thickness);
+        }
+        start = end;
+    }
+}
+
+void TreemapWidget::paintEvent(QPaintEvent*) noexcept
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().window());
+
+    for (size_t i = 0; i < m_rects.size(); i++)
+    {
+        auto const& entry = m_entries[i];
+        auto const& area = m_rects[i];
+
+        // Green (low density) to red (high density)
+        auto const ratio = (m_maxDensity > 0.0) ? (entry.density / m_maxDensity) : 0.0;
+        painter.fillRect(area, QColor::fromHsv(static_cast<int>(120 * (1.0 - ratio)), 160, 230));
+        painter.setPen(Qt::white);
+        painter.drawRect(area);
+
+        // Only label areas big enough to read
+        if (area.width() > 60 && area.height() > 20)
+        {
+            painter.setPen(Qt::black);
+            auto const name = entry.name.section(QDir::separator(), -1);
+            painter.drawText(area.adjusted(4, 2, -4, -2), Qt::AlignLeft | Qt::AlignTop | Qt::TextWordWrap,
+                             name + '\n' + QString::number(entry.messages));
+        }
+    }
+}
+
+void TreemapWidget::resizeEvent(QResizeEvent* event) noexcept
+{
+    QWidget::resizeEvent(event);
+    updateLayout();
+}
+
+bool TreemapWidget::event(QEvent* event) noexcept
+{
+    if (event->type() == QEvent::ToolTip)
+    {
+        auto* helpEvent = static_cast<QHelpEvent*>(event);
+        for (size_t i = 0; i < m_rects.size(); i++)
+        {
+            if (m_rects[i].contains(helpEvent->pos()))
+            {
+                auto const& entry = m_entries[i];
+                QToolTip::showText(helpEvent->globalPos(), QString("%1\n%2 messages\n%3 lines\n%4 messages per KLOC").arg(
+                                       entry.name,
+                                       QString::number(entry.messages),
+                                       entry.lines ? QString::number(entry.lines) : QString("?"),
+                                       QString::number(entry.density, 'f', 2)));
+                return true;
+            }
+        }
+        QToolTip::hideText();
+        event->ignore();
+        return true;
+    }
+    return QWidget::event(event);
+}
+
+StatisticsWindow::StatisticsWindow(QWidget* parent) :
+    QWidget(parent),
+    m_tabs(std::make_unique<QTabWidget>()),
+    m_topNumbers(std::make_unique<QTableWidget>()),
+    m_densestFiles(std::make_unique<QTableWidget>()),
+    m_treemap(std::make_unique<TreemapWidget>()),
+    m_dirty(false),
+    m_generation(0)
+{
+    m_topNumbers->setColumnCount(2);
+    m_topNumbers->setHorizontalHeaderLabels(QStringList() << "Number" << "Messages");
+    m_densestFiles->setColumnCount(4);
+    m_densestFiles->setHorizontalHeaderLabels(QStringList() << "File" << "Messages" << "Lines" << "Per KLOC");
+
+    for (auto* table : {m_topNumbers.get(), m_densestFiles.get()})
+    {
+        table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        table->setSelectionBehavior(QAbstractItemView::SelectRows);
+        table->verticalHeader()->setVisible(false);
+        table->horizontalHeader()->setStretchLastSection(true);
+    }
+    m_densestFiles->setColumnWidth(0, 300);
+
+    m_tabs->addTab(m_topNumbers.get(), "Top messages");
+    m_tabs->addTab(m_densestFiles.get(), "File density");
+    m_tabs->addTab(m_treemap.get(), "Directory treemap");
+
+    auto* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addWidget(m_tabs.get());
+
+    QObject::connect(&m_refreshTimer, &QTimer::timeout, this, &StatisticsWindow::slotRefresh);
+    m_refreshTimer.start(STATISTICS_REFRESH_INTERVAL);
+}
+
+StatisticsWindow::~StatisticsWindow()
+{
+    // Line counters post back to this object
+    for (auto& counter : m_lineCounters)
+    {
+        counter.waitForFinished();
+    }
+}
+
+void StatisticsWindow::addMessage(const LintMessage& message) noexcept
+{
+    if (m_statistics.addMessage(message))
+    {
+        countLines(message.file);
+    }
+    m_dirty = true;
+}
+
+void StatisticsWindow::removeMessage(const LintMessage& message) noexcept
+{
+    m_statistics.removeMessage(message);
+    m_dirty = true;
+}
+
+void StatisticsWindow::clear() noexcept
+{
+    // Ignore line counts still in flight from the last lint
+    m_generation++;
+    m_statistics.clear();
+    m_dirty = true;
+    slotRefresh();
+}
+
+void StatisticsWindow::showEvent(QShowEvent* event) noexcept
+{
+    QWidget::showEvent(event);
+    slotRefresh();
+}
+
+// Count the lines of a newly seen file on a worker
+void StatisticsWindow::countLines(const QString& file) noexcept
+{
+    if (file.isEmpty())
+    {
+        return;
+    }
+
+    // Finished counters don't need to be kept for the destructor
+    // The pool runs them in order so the finished ones are at the front
+    while (!m_lineCounters.isEmpty() && m_lineCounters.front().isFinished())
+    {
+        m_lineCounters.removeFirst();
+    }
+
+    auto const generation = m_generation;
+    m_lineCounters.append(QtConcurrent::run([this, file, generation]()
+    {
+        auto const lines = fileLines(file);
+        QMetaObject::invokeMethod(this, [this, file, lines, generation]()
+        {
+            if (generation == m_generation)
+            {
+                m_statistics.setFileLines(file, lines);
+                m_dirty = true;
+            }
+        }, Qt::QueuedConnection);
+    }));
+}
+
+int StatisticsWindow::fileLines(const QString& file) noexcept
+{
+    QFile source(file);
+    if (!source.open(QIODevice::ReadOnly))
+    {
+        return 0;
+    }
+
+    int lines = 1;
+    char buffer[64 * 1024];
+    qint64 bytes;
+    while ((bytes = source.read(buffer, sizeof(buffer))) > 0)
+    {
+        lines += static_cast<int>(std::count(buffer, buffer + bytes, '\n'));
+    }
+    return lines;
+}
+
+void StatisticsWindow::slotRefresh() noexcept
+{
+    // Nothing to do if nothing changed or nobody is looking
+    if (!m_dirty || !isVisible())
+    {
+        return;
+    }
+    m_dirty = false;
+
+    auto const numbers = m_statistics.topNumbers(STATISTICS_TOP_COUNT);
+    m_topNumbers->setRowCount(static_cast<int>(numbers.size()));
+    for (int row = 0; row < static_cast<int>(numbers.size()); row++)
+    {
+        m_topNumbers->setItem(row, 0, new QTableWidgetItem(numbers[row].name));
+        m_topNumbers->setItem(row, 1, new QTableWidgetItem(QString::number(numbers[row].messages)));
+    }
+
+    auto const files = m_statistics.densestFiles(STATISTICS_TOP_COUNT);
+    m_densestFiles->setRowCount(static_cast<int>(files.size()));
+    for (int row = 0; row < static_cast<int>(files.size()); row++)
+    {
+        auto* fileItem = new QTableWidgetItem(QFileInfo(files[row].name).fileName());
+        fileItem->setToolTip(files[row].name);
+        m_densestFiles->setItem(row, 0, fileItem);
+        m_densestFiles->setItem(row, 1, new QTableWidgetItem(QString::number(files[row].messages)));
+        m_densestFiles->setItem(row, 2, new QTableWidgetItem(QString::number(files[row].lines)));
+        m_densestFiles->setItem(row, 3, new QTableWidgetItem(QString::number(files[row].density, 'f', 2)));
+    }
+
+    m_treemap->setEntries(m_statistics.directories());
+}
+
+};
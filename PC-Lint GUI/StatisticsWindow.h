@@ -0,0 +1,95 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QWidget>
+#include <QTabWidget>
+#include <QTableWidget>
+#include <QTimer>
+#include <QFuture>
+#include <memory>
+#include <vector>
+#include "Statistics.h"
+
+namespace Lint
+{
+
+// Number of rows shown in the top N views
+constexpr int STATISTICS_TOP_COUNT = 25;
+// Maximum number of directories drawn in the treemap
+constexpr int STATISTICS_TREEMAP_MAX = 200;
+// How often the views are refreshed during a lint (ms)
+constexpr int STATISTICS_REFRESH_INTERVAL = 1000;
+
+// Directory treemap
+// Area is the number of messages, colour is the message density (green to red)
+class TreemapWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    TreemapWidget(QWidget* parent = nullptr);
+    void setEntries(StatisticsEntries entries) noexcept;
+
+protected:
+    void paintEvent(QPaintEvent* event) noexcept override;
+    void resizeEvent(QResizeEvent* event) noexcept override;
+    bool event(QEvent* event) noexcept override;
+
+private:
+    void updateLayout() noexcept;
+
+    StatisticsEntries m_entries;
+    std::vector<QRectF> m_rects;
+    double m_maxDensity;
+};
+
+class StatisticsWindow : public QWidget
+{
+    Q_OBJECT
+public:
+    StatisticsWindow(QWidget* parent = nullptr);
+    ~StatisticsWindow();
+
+    // Called for every ingested message
+    void addMessage(const LintMessage& message) noexcept;
+    // Called for every message dropped from the results
+    void removeMessage(const LintMessage& message) noexcept;
+    void clear() noexcept;
+
+protected:
+    void showEvent(QShowEvent* event) noexcept override;
+
+private slots:
+    void slotRefresh() noexcept;
+
+private:
+    void countLines(const QString& file) noexcept;
+    static int fileLines(const QString& file) noexcept;
+
+    std::unique_ptr<QTabWidget> m_tabs;
+    std::unique_ptr<QTableWidget> m_topNumbers;
+    std::unique_ptr<QTableWidget> m_densestFiles;
+    std::unique_ptr<TreemapWidget> m_treemap;
+    QTimer m_refreshTimer;
+
+    Statistics m_statistics;
+    bool m_dirty;
+    int m_generation;
+    QList<QFuture<void>> m_lineCounters;
+};
+
+};
@@ -0,0 +1,60 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "StringPool.h"
+
+namespace Lint
+{
+
+QString StringPool::intern(const QString& text) noexcept
+{
+    std::lock_guard lock(m_mutex);
+    auto pooled = m_strings.constFind(text);
+    if (pooled == m_strings.cend())
+    {
+        m_bytes += text.size() * static_cast<qint64>(sizeof(QChar));
+        pooled = m_strings.insert(text);
+    }
+    return *pooled;
+}
+
+void StringPool::intern(LintMessage& message) noexcept
+{
+    message.file = intern(message.file);
+    message.type = intern(message.type);
+    message.description = intern(message.description);
+}
+
+void StringPool::clear() noexcept
+{
+    std::lock_guard lock(m_mutex);
+    m_strings.clear();
+    m_bytes = 0;
+}
+
+int StringPool::size() const noexcept
+{
+    std::lock_guard lock(m_mutex);
+    return m_strings.size();
+}
+
+qint64 StringPool::bytes() const noexcept
+{
+    std::lock_guard lock(m_mutex);
+    return m_bytes;
+}
+
+};
@@ -0,0 +1,49 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QSet>
+#include <QString>
+#include <mutex>
+#include "PCLintPlus.h"
+
+namespace Lint
+{
+
+// Hands out one shared copy of every string it has seen
+// Results of several projects linting the same code keep a single copy of each path and description
+class StringPool
+{
+public:
+    // The pooled copy of text, safe to call from any thread
+    QString intern(const QString& text) noexcept;
+    // Pool the strings of a message
+    void intern(LintMessage& message) noexcept;
+    // Forget every string, copies already handed out stay valid
+    void clear() noexcept;
+    // Distinct strings pooled
+    int size() const noexcept;
+    // Bytes held by the pooled strings
+    qint64 bytes() const noexcept;
+
+private:
+    mutable std::mutex m_mutex;
+    QSet<QString> m_strings;
+    qint64 m_bytes = 0;
+};
+
+};
@@ -0,0 +1,206 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "SuppressionWindow.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QSignalBlocker>
+#include <QDebug>
+#include <algorithm>
+
+namespace Lint
+{
+
+namespace
+{
+
+const QColor INVALID_SUPPRESSION_COLOUR = QColor(255, 200, 200);
+
+};
+
+SuppressionWindow::SuppressionWindow(QWidget* parent) :
+    QDialog(parent),
+    m_lintFileLabel(std::make_unique<QLabel>()),
+    m_table(std::make_unique<QTableWidget>(0, 1)),
+    m_status(std::make_unique<QLabel>()),
+    m_add(std::make_unique<QPushButton>("Add")),
+    m_remove(std::make_unique<QPushButton>("Remove")),
+    m_save(std::make_unique<QPushButton>("Write to lint file")),
+    m_modified(false),
+    m_hidden(0)
+{
+    setWindowTitle("Suppressions");
+    setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint);
+    resize(600, 400);
+
+    m_table->setHorizontalHeaderLabels(QStringList() << "Option (-e#, -esym(#, symbol), -efile(#, file))");
+    m_table->horizontalHeader()->setStretchLastSection(true);
+    m_table->verticalHeader()->setVisible(false);
+    m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
+
+    auto* buttons = new QHBoxLayout();
+    buttons->addWidget(m_add.get());
+    buttons->addWidget(m_remove.get());
+    buttons->addStretch();
+    buttons->addWidget(m_save.get());
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addWidget(m_lintFileLabel.get());
+    layout->addWidget(m_table.get());
+    layout->addWidget(m_status.get());
+    layout->addLayout(buttons);
+
+    QObject::connect(m_table.get(), &QTableWidget::itemChanged, this, &SuppressionWindow::slotItemChanged);
+    QObject::connect(m_add.get(), &QPushButton::clicked, this, &SuppressionWindow::slotAdd);
+    QObject::connect(m_remove.get(), &QPushButton::clicked, this, &SuppressionWindow::slotRemove);
+    QObject::connect(m_save.get(), &QPushButton::clicked, this, &SuppressionWindow::slotSave);
+}
+
+void SuppressionWindow::setLintFile(const QString& lintFile) noexcept
+{
+    m_lintFile = lintFile;
+    m_lintFileLabel->setText(lintFile);
+    m_table->setRowCount(0);
+    m_modified = false;
+
+    if (!m_file.load(lintFile))
+    {
+        qCritical() << "Unable to read suppressions from" << lintFile << m_file.errorString();
+        m_lintFileLabel->setText(lintFile + " (" + m_file.errorString() + ")");
+    }
+
+    for (auto const& entry : m_file.entries())
+    {
+        addRow(entry.option, entry.line);
+    }
+    updateFilter();
+}
+
+void SuppressionWindow::addSuppression(const QString& option) noexcept
+{
+    addRow(option, -1);
+    m_table->scrollToBottom();
+    m_modified = true;
+    updateFilter();
+}
+
+void SuppressionWindow::setHiddenCount(int hidden) noexcept
+{
+    m_hidden = hidden;
+    m_status->setText(QString("%1 messages hidden%2").arg(QString::number(m_hidden),
+                      m_modified ? ", not written to the lint file yet" : ""));
+}
+
+void SuppressionWindow::addRow(const QString& option, int line) noexcept
+{
+    const QSignalBlocker blocker(m_table.get());
+    auto const row = m_table->rowCount();
+    m_table->insertRow(row);
+
+    auto* item = new QTableWidgetItem(option);
+    item->setData(Qt::UserRole, line);
+    Suppression suppression;
+    if (!parseSuppression(option, suppression))
+    {
+        item->setBackground(INVALID_SUPPRESSION_COLOUR);
+    }
+    m_table->setItem(row, 0, item);
+}
+
+void SuppressionWindow::slotItemChanged(QTableWidgetItem* item) noexcept
+{
+    const QSignalBlocker blocker(m_table.get());
+    Suppression suppression;
+    item->setBackground(parseSuppression(item->text(), suppression) ? QBrush() : QBrush(INVALID_SUPPRESSION_COLOUR));
+    m_modified = true;
+    updateFilter();
+}
+
+void SuppressionWindow::slotAdd() noexcept
+{
+    addRow(QString(), -1);
+    m_table->scrollToBottom();
+    m_table->editItem(m_table->item(m_table->rowCount() - 1, 0));
+}
+
+void SuppressionWindow::slotRemove() noexcept
+{
+    auto const selected = m_table->selectionModel()->selectedRows();
+    if (selected.isEmpty())
+    {
+        return;
+    }
+
+    // Bottom up so the rows still to remove don't move
+    std::vector<int> rows;
+    for (auto const& index : selected)
+    {
+        rows.push_back(index.row());
+    }
+    std::sort(rows.rbegin(), rows.rend());
+    for (auto const row : rows)
+    {
+        m_table->removeRow(row);
+    }
+
+    m_modified = true;
+    updateFilter();
+}
+
+void SuppressionWindow::slotSave() noexcept
+{
+    std::vector<SuppressionFile::Entry> entries;
+    Suppression suppression;
+    for (int row = 0; row < m_table->rowCount(); row++)
+    {
+        auto const* item = m_table->item(row, 0);
+        if (!parseSuppression(item->text(), suppression))
+        {
+            QMessageBox::warning(this, "Suppressions", "'" + item->text() + "' is not a suppression option");
+            m_table->setCurrentItem(m_table->item(row, 0));
+            return;
+        }
+        entries.push_back(SuppressionFile::Entry{item->text().trimmed(), item->data(Qt::UserRole).toInt()});
+    }
+
+    if (!m_file.save(entries))
+    {
+        QMessageBox::critical(this, "Suppressions", "Unable to write the lint file: " + m_file.errorString());
+        return;
+    }
+
+    // Rows now point at their lines in the lint file
+    setLintFile(m_lintFile);
+    m_status->setText(m_status->text() + ", removed suppressions come back on the next lint");
+}
+
+void SuppressionWindow::updateFilter() noexcept
+{
+    std::vector<Suppression> suppressions;
+    Suppression suppression;
+    for (int row = 0; row < m_table->rowCount(); row++)
+    {
+        if (parseSuppression(m_table->item(row, 0)->text(), suppression))
+        {
+            suppressions.push_back(suppression);
+        }
+    }
+    emit signalSuppressionsChanged(std::make_shared<const SuppressionFilter>(suppressions));
+}
+
+};
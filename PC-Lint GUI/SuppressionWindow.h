@@ -0,0 +1,70 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QDialog>
+#include <QTableWidget>
+#include <QLabel>
+#include <QPushButton>
+#include <memory>
+#include "Suppressions.h"
+
+namespace Lint
+{
+
+// Edits the suppression options of a lint file
+// Every change is compiled into a filter straight away so its effect on the current results shows
+// without linting again, writing the options to the lint file is a separate step
+class SuppressionWindow : public QDialog
+{
+    Q_OBJECT
+public:
+    SuppressionWindow(QWidget* parent = nullptr);
+
+    // Load the suppressions of a lint file, dropping any unsaved ones
+    void setLintFile(const QString& lintFile) noexcept;
+    // Add a new suppression option
+    void addSuppression(const QString& option) noexcept;
+    // Number of current results the suppressions hide
+    void setHiddenCount(int hidden) noexcept;
+
+signals:
+    void signalSuppressionsChanged(std::shared_ptr<const SuppressionFilter> filter);
+
+private slots:
+    void slotItemChanged(QTableWidgetItem* item) noexcept;
+    void slotAdd() noexcept;
+    void slotRemove() noexcept;
+    void slotSave() noexcept;
+
+private:
+    void addRow(const QString& option, int line) noexcept;
+    void updateFilter() noexcept;
+
+    std::unique_ptr<QLabel> m_lintFileLabel;
+    std::unique_ptr<QTableWidget> m_table;
+    std::unique_ptr<QLabel> m_status;
+    std::unique_ptr<QPushButton> m_add;
+    std::unique_ptr<QPushButton> m_remove;
+    std::unique_ptr<QPushButton> m_save;
+    QString m_lintFile;
+    SuppressionFile m_file;
+    bool m_modified;
+    int m_hidden;
+};
+
+};
@@ -0,0 +1,373 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Suppressions.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QDir>
+#include <QHash>
+#include <QDebug>
+
+namespace Lint
+{
+
+namespace
+{
+
+const QString SUPPRESSION_COMMENT = "// Suppressions added by PC-Lint GUI";
+
+// Glob match of a message number pattern
+bool matchNumber(QStringView pattern, QStringView number) noexcept
+{
+    int patternIndex = 0;
+    int numberIndex = 0;
+    int starIndex = -1;
+    int starMatch = 0;
+    while (numberIndex < number.size())
+    {
+        if ((patternIndex < pattern.size()) && ((pattern[patternIndex] == '?') || (pattern[patternIndex] == number[numberIndex])))
+        {
+            patternIndex++;
+            numberIndex++;
+        }
+        else if ((patternIndex < pattern.size()) && (pattern[patternIndex] == '*'))
+        {
+            starIndex = patternIndex++;
+            starMatch = numberIndex;
+        }
+        else if (starIndex >= 0)
+        {
+            patternIndex = starIndex + 1;
+            numberIndex = ++starMatch;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    while ((patternIndex < pattern.size()) && (pattern[patternIndex] == '*'))
+    {
+        patternIndex++;
+    }
+    return patternIndex == pattern.size();
+}
+
+// Option of a lint file line, without its comment
+QString lineOption(const QString& line) noexcept
+{
+    auto const comment = line.indexOf("//");
+    return ((comment >= 0) ? line.left(comment) : line).trimmed();
+}
+
+};
+
+bool parseSuppression(const QString& option, Suppression& suppression) noexcept
+{
+    static const QRegularExpression message(R"(^-e([0-9?*]+)$)");
+    static const QRegularExpression named(R"(^-e(sym|file)\(\s*([0-9?*]+)\s*,(.+)\)$)");
+
+    auto const text = option.trimmed();
+    auto match = message.match(text);
+    if (match.hasMatch())
+    {
+        suppression = Suppression{SUPPRESS_MESSAGE, match.captured(1), {}};
+        return true;
+    }
+
+    match = named.match(text);
+    if (!match.hasMatch())
+    {
+        return false;
+    }
+
+    QStringList names;
+    for (auto name : match.captured(3).split(','))
+    {
+        name = name.trimmed();
+        if ((name.size() >= 2) && name.startsWith('"') && name.endsWith('"'))
+        {
+            name = name.mid(1, name.size() - 2);
+        }
+        if (name.isEmpty())
+        {
+            return false;
+        }
+        names << name;
+    }
+
+    auto const kind = (match.captured(1) == "sym") ? SUPPRESS_SYMBOL : SUPPRESS_FILE;
+    suppression = Suppression{kind, match.captured(2), names};
+    return true;
+}
+
+QString suppressionOption(const Suppression& suppression) noexcept
+{
+    switch (suppression.kind)
+    {
+    case SUPPRESS_MESSAGE:
+        return "-e" + suppression.numbers;
+    case SUPPRESS_SYMBOL:
+        return "-esym(" + suppression.numbers + ", " + suppression.names.join(", ") + ")";
+    case SUPPRESS_FILE:
+    {
+        // Files with spaces need quoting
+        QStringList files;
+        for (auto const& file : suppression.names)
+        {
+            files << (file.contains(' ') ? ('"' + file + '"') : file);
+        }
+        return "-efile(" + suppression.numbers + ", " + files.join(", ") + ")";
+    }
+    }
+    return QString();
+}
+
+SuppressionFilter::SuppressionFilter(const std::vector<Suppression>& suppressions)
+{
+    for (auto const& suppression : suppressions)
+    {
+        auto const numbers = compileNumbers(suppression.numbers);
+        if (suppression.kind == SUPPRESS_MESSAGE)
+        {
+            m_messages |= numbers;
+            continue;
+        }
+
+        Rule rule{numbers, {}, false};
+        for (auto const& name : suppression.names)
+        {
+            auto const pattern = QDir::fromNativeSeparators(name);
+            rule.names.push_back(compileName(pattern));
+            rule.fullPath |= (suppression.kind == SUPPRESS_FILE) && pattern.contains('/');
+        }
+        if (suppression.kind == SUPPRESS_FILE)
+        {
+            for (auto& name : rule.names)
+            {
+                name.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+            }
+        }
+
+        m_named |= numbers;
+        ((suppression.kind == SUPPRESS_SYMBOL) ? m_symbols : m_files).push_back(std::move(rule));
+    }
+}
+
+SuppressionFilter::Numbers SuppressionFilter::compileNumbers(const QString& pattern) noexcept
+{
+    Numbers numbers;
+    if (!pattern.contains('?') && !pattern.contains('*'))
+    {
+        auto const number = pattern.toInt();
+        if ((number >= 0) && (number < SUPPRESSION_NUMBER_LIMIT))
+        {
+            numbers.set(static_cast<size_t>(number));
+        }
+        return numbers;
+    }
+
+    for (int number = 0; number < SUPPRESSION_NUMBER_LIMIT; number++)
+    {
+        if (matchNumber(pattern, QString::number(number)))
+        {
+            numbers.set(static_cast<size_t>(number));
+        }
+    }
+    return numbers;
+}
+
+QRegularExpression SuppressionFilter::compileName(const QString& pattern) noexcept
+{
+    auto expression = QRegularExpression::escape(pattern);
+    expression.replace("\\*", ".*");
+    expression.replace("\\?", ".");
+    return QRegularExpression("^" + expression + "$");
+}
+
+bool SuppressionFilter::suppresses(int number, const QString& file, const QString& description) const noexcept
+{
+    if ((number < 0) || (number >= SUPPRESSION_NUMBER_LIMIT))
+    {
+        return false;
+    }
+    if (m_messages.test(static_cast<size_t>(number)))
+    {
+        return true;
+    }
+    if (!m_named.test(static_cast<size_t>(number)))
+    {
+        return false;
+    }
+
+    // Symbols are the quoted parts of the description
+    for (int start = description.indexOf('\''); start >= 0; )
+    {
+        auto const end = description.indexOf('\'', start + 1);
+        if (end < 0)
+        {
+            break;
+        }
+
+        auto const symbol = description.mid(start + 1, end - start - 1);
+        for (auto const& rule : m_symbols)
+        {
+            if (rule.numbers.test(static_cast<size_t>(number)))
+            {
+                for (auto const& name : rule.names)
+                {
+                    if (name.match(symbol).hasMatch())
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+        start = description.indexOf('\'', end + 1);
+    }
+
+    if (!m_files.empty())
+    {
+        auto const path = QDir::fromNativeSeparators(file);
+        auto const fileName = path.mid(path.lastIndexOf('/') + 1);
+        for (auto const& rule : m_files)
+        {
+            if (rule.numbers.test(static_cast<size_t>(number)))
+            {
+                for (auto const& name : rule.names)
+                {
+                    if (name.match(rule.fullPath ? path : fileName).hasMatch())
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+bool SuppressionFilter::isEmpty() const noexcept
+{
+    return m_messages.none() && m_named.none();
+}
+
+bool SuppressionFile::load(const QString& lintFile) noexcept
+{
+    m_lintFile = lintFile;
+    m_lines.clear();
+    m_entries.clear();
+
+    QFile file(lintFile);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        m_errorString = file.errorString();
+        return false;
+    }
+
+    QTextStream stream(&file);
+    Suppression suppression;
+    while (!stream.atEnd())
+    {
+        auto const line = stream.readLine();
+        auto const option = lineOption(line);
+        if (parseSuppression(option, suppression))
+        {
+            m_entries.push_back(Entry{option, m_lines.size()});
+        }
+        m_lines << line;
+    }
+
+    qDebug() << "Found" << m_entries.size() << "suppressions in" << lintFile;
+    return true;
+}
+
+bool SuppressionFile::save(const std::vector<Entry>& entries) noexcept
+{
+    QHash<int, QString> kept;
+    QStringList added;
+    for (auto const& entry : entries)
+    {
+        if (entry.line >= 0)
+        {
+            kept.insert(entry.line, entry.option);
+        }
+        else
+        {
+            added << entry.option;
+        }
+    }
+
+    // Suppression lines are in line order
+    QStringList lines;
+    int suppression = 0;
+    for (int line = 0; line < m_lines.size(); line++)
+    {
+        if ((suppression < static_cast<int>(m_entries.size())) && (m_entries[suppression].line == line))
+        {
+            auto const option = kept.find(line);
+            if (option != kept.end())
+            {
+                // Unchanged lines keep their comment
+                lines << ((*option == m_entries[suppression].option) ? m_lines[line] : *option);
+            }
+            suppression++;
+        }
+        else
+        {
+            lines << m_lines[line];
+        }
+    }
+    if (!added.isEmpty() && !m_lines.contains(SUPPRESSION_COMMENT))
+    {
+        lines << SUPPRESSION_COMMENT;
+    }
+    lines << added;
+
+    QSaveFile file(m_lintFile);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        m_errorString = file.errorString();
+        return false;
+    }
+    QTextStream stream(&file);
+    for (auto const& line : lines)
+    {
+        stream << line << '\n';
+    }
+    stream.flush();
+    if (!file.commit())
+    {
+        m_errorString = file.errorString();
+        return false;
+    }
+
+    qInfo() << "Wrote" << entries.size() << "suppressions to" << m_lintFile;
+    return load(m_lintFile);
+}
+
+const std::vector<SuppressionFile::Entry>& SuppressionFile::entries() const noexcept
+{
+    return m_entries;
+}
+
+const QString& SuppressionFile::errorString() const noexcept
+{
+    return m_errorString;
+}
+
+};
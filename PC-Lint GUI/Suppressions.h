@@ -0,0 +1,109 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QRegularExpression>
+#include <bitset>
+#include <vector>
+
+namespace Lint
+{
+
+// Message numbers are below this
+constexpr int SUPPRESSION_NUMBER_LIMIT = 10000;
+
+enum SuppressionKind
+{
+    SUPPRESS_MESSAGE, // -e#
+    SUPPRESS_SYMBOL,  // -esym(#, symbol[, symbol]...)
+    SUPPRESS_FILE     // -efile(#, file[, file]...)
+};
+
+// Message suppression option as written in a lint file
+struct Suppression
+{
+    SuppressionKind kind;
+    QString numbers;   // Message number, '?' and '*' are wildcards
+    QStringList names; // Symbols or files, '?' and '*' are wildcards
+};
+
+// Parse a single -e, -esym or -efile option
+bool parseSuppression(const QString& option, Suppression& suppression) noexcept;
+// Option text of a suppression
+QString suppressionOption(const Suppression& suppression) noexcept;
+
+// Suppressions compiled for matching messages
+// Message numbers become bitsets and names become anchored regular expressions
+// -esym matches the quoted symbols in the message description
+// -efile matches the file of the message (its name, or full path if the pattern has a directory)
+class SuppressionFilter
+{
+public:
+    explicit SuppressionFilter(const std::vector<Suppression>& suppressions);
+
+    bool suppresses(int number, const QString& file, const QString& description) const noexcept;
+    bool isEmpty() const noexcept;
+
+private:
+    using Numbers = std::bitset<SUPPRESSION_NUMBER_LIMIT>;
+
+    struct Rule
+    {
+        Numbers numbers;
+        std::vector<QRegularExpression> names;
+        bool fullPath;
+    };
+
+    static Numbers compileNumbers(const QString& pattern) noexcept;
+    static QRegularExpression compileName(const QString& pattern) noexcept;
+
+    Numbers m_messages;
+    // Numbers any name rule applies to so most messages are rejected with one bit test
+    Numbers m_named;
+    std::vector<Rule> m_symbols;
+    std::vector<Rule> m_files;
+};
+
+// Suppression options kept in a lint file
+// Only lines holding nothing but one suppression (and maybe a comment) are picked up
+// so saving never touches any other option
+class SuppressionFile
+{
+public:
+    struct Entry
+    {
+        QString option;
+        int line; // Line in the lint file, -1 if not written yet
+    };
+
+    bool load(const QString& lintFile) noexcept;
+    // Write the entries back: edited lines are replaced, missing lines removed and new entries appended
+    bool save(const std::vector<Entry>& entries) noexcept;
+
+    const std::vector<Entry>& entries() const noexcept;
+    const QString& errorString() const noexcept;
+
+private:
+    QString m_lintFile;
+    QStringList m_lines;
+    std::vector<Entry> m_entries;
+    QString m_errorString;
+};
+
+};
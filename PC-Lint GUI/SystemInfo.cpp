@@ -0,0 +1,258 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "SystemInfo.h"
+#include <QFile>
+#include <QList>
+#include <algorithm>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <unistd.h>
+#endif
+
+namespace Lint
+{
+
+qint64 processResidentMemory() noexcept
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return static_cast<qint64>(counters.WorkingSetSize);
+    }
+    return -1;
+#elif defined(Q_OS_LINUX)
+    // Second field is the resident set in pages
+    QFile statm("/proc/self/statm");
+    if (!statm.open(QIODevice::ReadOnly))
+    {
+        return -1;
+    }
+    auto const fields = statm.readAll().split(' ');
+    bool ok = false;
+    auto const pages = fields.value(1).toLongLong(&ok);
+    return ok ? (pages * sysconf(_SC_PAGESIZE)) : -1;
+#else
+    return -1;
+#endif
+}
+
+namespace
+{
+#if defined(Q_OS_LINUX)
+    // /proc files report a size of 0 so they are read until the end rather than by size
+    QByteArray readProcFile(const char* file) noexcept
+    {
+        QFile proc(file);
+        if (!proc.open(QIODevice::ReadOnly))
+        {
+            return QByteArray();
+        }
+        return proc.readAll();
+    }
+#endif
+
+    // Value of a "name value" line (meminfo has a kB suffix, vmstat doesn't)
+    bool procValue(const QByteArray& data, const QByteArray& name, qint64& value) noexcept
+    {
+        int from = 0;
+        for (;;)
+        {
+            auto const line = data.indexOf(name, from);
+            if (line < 0)
+            {
+                return false;
+            }
+            from = line + name.size();
+            if (((line == 0) || (data[line - 1] == '\n')) && (from < data.size()) && ((data[from] == ' ') || (data[from] == ':')))
+            {
+                break;
+            }
+        }
+
+        // "MemTotal:       16305208 kB" or "pswpin 0"
+        auto const end = data.indexOf('\n', from);
+        auto field = data.mid(from, (end < 0) ? -1 : end - from).trimmed();
+        if (field.startsWith(':'))
+        {
+            field = field.mid(1).trimmed();
+        }
+        bool ok = false;
+        value = field.split(' ').front().toLongLong(&ok);
+        return ok;
+    }
+};
+
+bool parseProcStat(const QByteArray& stat, CpuTimes& times) noexcept
+{
+    // cpu  user nice system idle iowait irq softirq steal guest guest_nice
+    if (!stat.startsWith("cpu "))
+    {
+        return false;
+    }
+    auto const end = stat.indexOf('\n');
+    auto const fields = stat.left(end).simplified().split(' ');
+    if (fields.size() < 5)
+    {
+        return false;
+    }
+
+    // Guest time is already counted in user and nice
+    quint64 values[8] = {};
+    for (int field = 1; (field < fields.size()) && (field <= 8); field++)
+    {
+        bool ok = false;
+        values[field - 1] = fields[field].toULongLong(&ok);
+        if (!ok)
+        {
+            return false;
+        }
+    }
+
+    auto const idle = values[3];
+    times.ioWait = values[4];
+    times.total = 0;
+    for (auto const value : values)
+    {
+        times.total += value;
+    }
+    times.busy = times.total - idle - times.ioWait;
+    return true;
+}
+
+bool parseMemInfo(const QByteArray& meminfo, MemoryInfo& memory) noexcept
+{
+    qint64 total = 0;
+    qint64 available = 0;
+    if (!procValue(meminfo, "MemTotal", total) || !procValue(meminfo, "MemAvailable", available))
+    {
+        return false;
+    }
+    memory.total = total * 1024;
+    memory.available = available * 1024;
+    return true;
+}
+
+qint64 parseSwappedPages(const QByteArray& vmstat) noexcept
+{
+    qint64 in = 0;
+    qint64 out = 0;
+    if (!procValue(vmstat, "pswpin", in) || !procValue(vmstat, "pswpout", out))
+    {
+        return -1;
+    }
+    return in + out;
+}
+
+LoadMonitor::LoadMonitor() noexcept :
+    m_cpu{0, 0, 0},
+    m_swappedPages(readSwappedPages())
+{
+    readCpu(m_cpu);
+}
+
+SystemLoad LoadMonitor::sample() noexcept
+{
+    SystemLoad load{0.0, 0.0, 1.0, 0};
+
+    CpuTimes cpu;
+    if (readCpu(cpu))
+    {
+        auto const total = cpu.total - m_cpu.total;
+        if (total > 0)
+        {
+            load.cpuBusy = static_cast<double>(cpu.busy - m_cpu.busy) / total;
+            load.ioWait = static_cast<double>(cpu.ioWait - m_cpu.ioWait) / total;
+        }
+        m_cpu = cpu;
+    }
+
+    MemoryInfo memory;
+    if (readMemory(memory) && (memory.total > 0))
+    {
+        load.memoryAvailable = static_cast<double>(memory.available) / memory.total;
+    }
+
+    auto const swappedPages = readSwappedPages();
+    if ((swappedPages >= 0) && (m_swappedPages >= 0))
+    {
+        load.swappedPages = std::max<qint64>(0, swappedPages - m_swappedPages);
+    }
+    m_swappedPages = swappedPages;
+    return load;
+}
+
+bool LoadMonitor::readCpu(CpuTimes& times) const noexcept
+{
+#if defined(Q_OS_WIN)
+    FILETIME idle;
+    FILETIME kernel;
+    FILETIME user;
+    if (!GetSystemTimes(&idle, &kernel, &user))
+    {
+        return false;
+    }
+    auto const value = [](const FILETIME& time)
+    {
+        return (static_cast<quint64>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+    // Kernel time includes the idle time
+    times.total = value(kernel) + value(user);
+    times.busy = times.total - value(idle);
+    times.ioWait = 0;
+    return true;
+#elif defined(Q_OS_LINUX)
+    return parseProcStat(readProcFile("/proc/stat"), times);
+#else
+    Q_UNUSED(times)
+    return false;
+#endif
+}
+
+bool LoadMonitor::readMemory(MemoryInfo& memory) const noexcept
+{
+#if defined(Q_OS_WIN)
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (!GlobalMemoryStatusEx(&status))
+    {
+        return false;
+    }
+    memory.total = static_cast<qint64>(status.ullTotalPhys);
+    memory.available = static_cast<qint64>(status.ullAvailPhys);
+    return true;
+#elif defined(Q_OS_LINUX)
+    return parseMemInfo(readProcFile("/proc/meminfo"), memory);
+#else
+    Q_UNUSED(memory)
+    return false;
+#endif
+}
+
+qint64 LoadMonitor::readSwappedPages() const noexcept
+{
+#if defined(Q_OS_LINUX)
+    return parseSwappedPages(readProcFile("/proc/vmstat"));
+#else
+    return -1;
+#endif
+}
+
+};
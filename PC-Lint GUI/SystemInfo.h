@@ -0,0 +1,77 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QByteArray>
+#include <QtGlobal>
+
+namespace Lint
+{
+
+// Resident memory of this process in bytes, -1 where it can't be found out
+qint64 processResidentMemory() noexcept;
+
+// CPU time counters since boot, only the differences between two samples mean anything
+struct CpuTimes
+{
+    quint64 busy;   // Running anything
+    quint64 ioWait; // Idle while waiting on I/O
+    quint64 total;
+};
+
+// Physical memory in bytes
+struct MemoryInfo
+{
+    qint64 total;
+    qint64 available; // Free plus what can be reclaimed without swapping
+};
+
+// How loaded the machine was between two samples
+struct SystemLoad
+{
+    double cpuBusy;         // 0 to 1
+    double ioWait;          // 0 to 1
+    double memoryAvailable; // 0 to 1
+    qint64 swappedPages;    // Pages swapped in or out
+};
+
+// Aggregate "cpu" line of /proc/stat
+bool parseProcStat(const QByteArray& stat, CpuTimes& times) noexcept;
+// MemTotal and MemAvailable of /proc/meminfo
+bool parseMemInfo(const QByteArray& meminfo, MemoryInfo& memory) noexcept;
+// pswpin + pswpout of /proc/vmstat, -1 if they aren't there
+qint64 parseSwappedPages(const QByteArray& vmstat) noexcept;
+
+// Samples the load of the whole machine
+// On Windows the CPU and memory come from the system, I/O wait and swapping are always 0
+class LoadMonitor
+{
+public:
+    LoadMonitor() noexcept;
+    // Load since the last sample (since the monitor was made for the first one)
+    SystemLoad sample() noexcept;
+
+private:
+    bool readCpu(CpuTimes& times) const noexcept;
+    bool readMemory(MemoryInfo& memory) const noexcept;
+    qint64 readSwappedPages() const noexcept;
+
+    CpuTimes m_cpu;
+    qint64 m_swappedPages;
+};
+
+};
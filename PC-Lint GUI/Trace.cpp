@@ -0,0 +1,209 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Trace.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QSaveFile>
+#include <QThread>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Lint
+{
+
+namespace Trace
+{
+    std::atomic<bool> g_enabled{false};
+};
+
+namespace
+{
+    struct TraceSpan
+    {
+        const char* name;
+        qint64 start;
+        qint64 duration;
+    };
+
+    // Ring buffer of one thread
+    // The mutex is only ever contended while exporting
+    struct TraceBuffer
+    {
+        int threadId;
+        QString threadName;
+        std::mutex mutex;
+        std::vector<TraceSpan> spans;
+        quint64 next = 0;
+    };
+
+    // Buffers outlive their threads so short lived worker threads still show up
+    std::mutex g_buffersMutex;
+    std::vector<std::shared_ptr<TraceBuffer>> g_buffers;
+    thread_local TraceBuffer* t_buffer = nullptr;
+
+    auto const g_epoch = std::chrono::steady_clock::now();
+
+    TraceBuffer& threadBuffer() noexcept
+    {
+        if (!t_buffer)
+        {
+            auto buffer = std::make_shared<TraceBuffer>();
+            buffer->spans.resize(TRACE_BUFFER_SPANS);
+
+            auto const* thread = QThread::currentThread();
+            auto const isGuiThread = QCoreApplication::instance() && (thread == QCoreApplication::instance()->thread());
+            buffer->threadName = isGuiThread ? QString("GUI") : thread->objectName();
+
+            std::lock_guard lock(g_buffersMutex);
+            buffer->threadId = static_cast<int>(g_buffers.size()) + 1;
+            if (buffer->threadName.isEmpty())
+            {
+                buffer->threadName = "Thread " + QString::number(buffer->threadId);
+            }
+            t_buffer = buffer.get();
+            g_buffers.push_back(std::move(buffer));
+        }
+        return *t_buffer;
+    }
+
+    // Microseconds with nanosecond precision as trace events want
+    QByteArray microseconds(qint64 nanoseconds) noexcept
+    {
+        return QByteArray::number(static_cast<double>(nanoseconds) / 1000.0, 'f', 3);
+    }
+
+    QByteArray jsonString(const QString& text) noexcept
+    {
+        QByteArray json = "\"";
+        for (auto const character : text.toUtf8())
+        {
+            if ((character == '"') || (character == '\\'))
+            {
+                json += '\\';
+            }
+            json += (static_cast<unsigned char>(character) < 0x20) ? ' ' : character;
+        }
+        return json + '"';
+    }
+};
+
+void Trace::setEnabled(bool enabled) noexcept
+{
+    if (g_enabled.exchange(enabled) != enabled)
+    {
+        qInfo() << "Pipeline tracing" << (enabled ? "on" : "off");
+    }
+}
+
+qint64 Trace::now() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_epoch).count();
+}
+
+void Trace::record(const char* name, qint64 start, qint64 end) noexcept
+{
+    auto& buffer = threadBuffer();
+    std::lock_guard lock(buffer.mutex);
+    buffer.spans[buffer.next % TRACE_BUFFER_SPANS] = TraceSpan{name, start, end - start};
+    buffer.next++;
+}
+
+void Trace::clear() noexcept
+{
+    std::lock_guard lock(g_buffersMutex);
+    for (auto const& buffer : g_buffers)
+    {
+        std::lock_guard bufferLock(buffer->mutex);
+        buffer->next = 0;
+    }
+}
+
+int Trace::spanCount() noexcept
+{
+    std::lock_guard lock(g_buffersMutex);
+    quint64 spans = 0;
+    for (auto const& buffer : g_buffers)
+    {
+        std::lock_guard bufferLock(buffer->mutex);
+        spans += std::min<quint64>(buffer->next, TRACE_BUFFER_SPANS);
+    }
+    return static_cast<int>(spans);
+}
+
+bool Trace::exportChromeTrace(const QString& file) noexcept
+{
+    QSaveFile output(file);
+    if (!output.open(QIODevice::WriteOnly))
+    {
+        qCritical() << "Failed to export trace:" << file << output.errorString();
+        return false;
+    }
+
+    QByteArray json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    auto const pid = QByteArray::number(QCoreApplication::applicationPid());
+    bool first = true;
+    int spans = 0;
+    auto const separator = [&json, &first]()
+    {
+        json += first ? "" : ",\n";
+        first = false;
+    };
+
+    std::lock_guard lock(g_buffersMutex);
+    for (auto const& buffer : g_buffers)
+    {
+        auto const tid = QByteArray::number(buffer->threadId);
+        separator();
+        json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":" + tid +
+                ",\"args\":{\"name\":" + jsonString(buffer->threadName) + "}}";
+
+        // Oldest first once the ring has wrapped around
+        std::lock_guard bufferLock(buffer->mutex);
+        auto const count = std::min<quint64>(buffer->next, TRACE_BUFFER_SPANS);
+        for (auto span = buffer->next - count; span < buffer->next; span++)
+        {
+            auto const& traceSpan = buffer->spans[span % TRACE_BUFFER_SPANS];
+            separator();
+            json += "{\"name\":\"" + QByteArray(traceSpan.name) + "\",\"cat\":\"lint\",\"ph\":\"X\",\"ts\":" +
+                    microseconds(traceSpan.start) + ",\"dur\":" + microseconds(traceSpan.duration) +
+                    ",\"pid\":" + pid + ",\"tid\":" + tid + "}";
+            spans++;
+        }
+
+        // Keep the memory in check on large runs
+        if (json.size() > (1 << 24))
+        {
+            output.write(json);
+            json.clear();
+        }
+    }
+    json += "\n]}\n";
+    output.write(json);
+
+    if (!output.commit())
+    {
+        qCritical() << "Failed to export trace:" << file << output.errorString();
+        return false;
+    }
+    qInfo() << "Exported" << spans << "trace spans to" << file;
+    return true;
+}
+
+};
@@ -0,0 +1,82 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+namespace Lint
+{
+
+// Spans kept per thread, the oldest are overwritten once a thread records more
+constexpr int TRACE_BUFFER_SPANS = 1 << 16;
+
+// Span tracing of the lint pipeline
+// Each thread records into its own ring buffer so recording never waits on another thread
+// The buffers are exported in the Chrome trace event format which chrome://tracing and
+// https://ui.perfetto.dev open directly
+namespace Trace
+{
+    extern std::atomic<bool> g_enabled;
+
+    inline bool isEnabled() noexcept
+    {
+        return g_enabled.load(std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool enabled) noexcept;
+    // Nanoseconds since the process started tracing
+    qint64 now() noexcept;
+    // Span of the calling thread, name must outlive the trace (a string literal)
+    void record(const char* name, qint64 start, qint64 end) noexcept;
+    // Forget every recorded span
+    void clear() noexcept;
+    // Number of spans held in all the buffers
+    int spanCount() noexcept;
+    // Write every recorded span as Chrome trace event JSON
+    bool exportChromeTrace(const QString& file) noexcept;
+};
+
+// Records a span from construction to destruction when tracing is on
+// Costs a single relaxed load when it's off
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* name) noexcept :
+        m_name(name),
+        m_start(Trace::isEnabled() ? Trace::now() : -1)
+    {
+    }
+
+    ~TraceScope()
+    {
+        if (m_start >= 0)
+        {
+            Trace::record(m_name, m_start, Trace::now());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name;
+    qint64 m_start;
+};
+
+};
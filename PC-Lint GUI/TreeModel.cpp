@@ -0,0 +1,1105 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "TreeModel.h"
+#include <QtConcurrent>
+#include <memory>
+#include <tuple>
+#include <algorithm>
+
+namespace Lint
+{
+
+// The internal id of an index identifies its parent
+// 0            : top-level node
+// (node+1) << 1: message group under a top-level node
+// (group+1) << 1 | 1: supplemental message under a message group
+namespace
+{
+    constexpr quintptr ID_NODE = 0;
+    constexpr quintptr ID_SUPPLEMENTAL = 1;
+
+    inline quintptr encodeNode(int node) noexcept
+    {
+        return (static_cast<quintptr>(node) + 1) << 1;
+    }
+
+    inline quintptr encodeGroup(int group) noexcept
+    {
+        return ((static_cast<quintptr>(group) + 1) << 1) | ID_SUPPLEMENTAL;
+    }
+
+    inline int decode(quintptr id) noexcept
+    {
+        return static_cast<int>(id >> 1) - 1;
+    }
+};
+
+TreeModel::TreeModel(QObject* parent) :
+    QAbstractItemModel(parent),
+    m_lastGroup(-1),
+    m_grouping(GROUP_BY_FILE),
+    m_sortColumn(-1),
+    m_sortOrder(Qt::AscendingOrder),
+    m_sortGeneration(0),
+    m_iconError(":/images/error.png"),
+    m_iconWarning(":/images/warning.png"),
+    m_iconInformation(":/images/info.png")
+{
+    for (auto& pivot : m_pivots)
+    {
+        pivot.sortColumn = -1;
+        pivot.sortOrder = Qt::AscendingOrder;
+    }
+
+    QObject::connect(&m_sortWatcher, &QFutureWatcher<SortResult>::finished, this, [this]()
+    {
+        applySort(m_sortWatcher.result());
+    });
+}
+
+QModelIndex TreeModel::index(int row, int column, const QModelIndex& parent) const noexcept
+{
+    if (row < 0 || column < 0 || column >= columnCount())
+    {
+        return QModelIndex();
+    }
+
+    auto const& pivot = activePivot();
+    if (!parent.isValid())
+    {
+        if (row >= static_cast<int>(pivot.nodeOrder.size()))
+        {
+            return QModelIndex();
+        }
+        return createIndex(row, column, ID_NODE);
+    }
+
+    auto const id = parent.internalId();
+    if (id == ID_NODE)
+    {
+        auto const node = pivot.nodeOrder[parent.row()];
+        if (row >= static_cast<int>(pivot.nodes[node].groups.size()))
+        {
+            return QModelIndex();
+        }
+        return createIndex(row, column, encodeNode(node));
+    }
+    else if (!(id & ID_SUPPLEMENTAL))
+    {
+        auto const group = pivot.nodes[decode(id)].groups[parent.row()];
+        if (row >= static_cast<int>(m_groups[group].supplementals.size()))
+        {
+            return QModelIndex();
+        }
+        return createIndex(row, column, encodeGroup(group));
+    }
+
+    // Supplemental messages have no children
+    return QModelIndex();
+}
+
+QModelIndex TreeModel::parent(const QModelIndex& child) const noexcept
+{
+    if (!child.isValid())
+    {
+        return QModelIndex();
+    }
+
+    auto const id = child.internalId();
+    if (id == ID_NODE)
+    {
+        return QModelIndex();
+    }
+    else if (!(id & ID_SUPPLEMENTAL))
+    {
+        return nodeIndex(decode(id));
+    }
+    return groupIndex(decode(id));
+}
+
+int TreeModel::rowCount(const QModelIndex& parent) const noexcept
+{
+    auto const& pivot = activePivot();
+    if (!parent.isValid())
+    {
+        return static_cast<int>(pivot.nodeOrder.size());
+    }
+
+    // Only the first column has children
+    if (parent.column() != 0)
+    {
+        return 0;
+    }
+
+    auto const id = parent.internalId();
+    if (id == ID_NODE)
+    {
+        return static_cast<int>(pivot.nodes[pivot.nodeOrder[parent.row()]].groups.size());
+    }
+    else if (!(id & ID_SUPPLEMENTAL))
+    {
+        auto const group = pivot.nodes[decode(id)].groups[parent.row()];
+        return static_cast<int>(m_groups[group].supplementals.size());
+    }
+    return 0;
+}
+
+int TreeModel::columnCount(const QModelIndex&) const noexcept
+{
+    return LINT_TABLE_LINE_COLUMN + 1;
+}
+
+QVariant TreeModel::data(const QModelIndex& index, int role) const noexcept
+{
+    if (!index.isValid())
+    {
+        return QVariant();
+    }
+
+    // Top-level node
+    if (index.internalId() == ID_NODE)
+    {
+        auto const& pivot = activePivot();
+        auto const& node = pivot.nodes[pivot.nodeOrder[index.row()]];
+        switch (role)
+        {
+        case Qt::DisplayRole:
+            if (index.column() == LINT_TABLE_FILE_COLUMN)
+            {
+                return nodeName(m_grouping, node);
+            }
+            else if (index.column() == LINT_TABLE_DESCRIPTION_COLUMN)
+            {
+                return QString("%1 messages (%2 errors, %3 warnings, %4 information)").arg(
+                            QString::number(node.groups.size()),
+                            QString::number(node.errors),
+                            QString::number(node.warnings),
+                            QString::number(node.informations));
+            }
+            break;
+        case LINT_ROLE_SORT_KEY:
+            if (index.column() == LINT_TABLE_FILE_COLUMN)
+            {
+                return (m_grouping == GROUP_BY_NUMBER || m_grouping == GROUP_BY_TYPE) ?
+                            QVariant(node.key) : QVariant(nodeName(m_grouping, node));
+            }
+            break;
+        case LINT_ROLE_FILE_PATH:
+            // Only file nodes can be opened in the editor
+            return (m_grouping == GROUP_BY_FILE) ? m_files[node.key] : QString();
+        case LINT_ROLE_MESSAGE_TYPE:
+            return static_cast<int>(MESSAGE_UNKNOWN);
+        default:
+            break;
+        }
+        return QVariant();
+    }
+
+    auto const& message = m_messages[messageForIndex(index)];
+    switch (role)
+    {
+    case Qt::DisplayRole:
+        switch (index.column())
+        {
+        case LINT_TABLE_FILE_COLUMN:
+            return m_fileNames[message.file];
+        case LINT_TABLE_NUMBER_COLUMN:
+            return QString::number(message.number);
+        case LINT_TABLE_DESCRIPTION_COLUMN:
+            return message.description;
+        case LINT_TABLE_LINE_COLUMN:
+            return QString::number(message.line);
+        default:
+            break;
+        }
+        break;
+    case Qt::DecorationRole:
+        if (index.column() == LINT_TABLE_FILE_COLUMN)
+        {
+            return messageIcon(message.type);
+        }
+        break;
+    case LINT_ROLE_FILE_PATH:
+        return m_files[message.file];
+    case LINT_ROLE_MESSAGE_TYPE:
+        return static_cast<int>(message.type);
+    case LINT_ROLE_SORT_KEY:
+        switch (index.column())
+        {
+        case LINT_TABLE_FILE_COLUMN:
+            return m_fileNames[message.file];
+        case LINT_TABLE_NUMBER_COLUMN:
+            return message.number;
+        case LINT_TABLE_DESCRIPTION_COLUMN:
+            return message.description;
+        case LINT_TABLE_LINE_COLUMN:
+            return message.line;
+        default:
+            break;
+        }
+        break;
+    default:
+        break;
+    }
+    return QVariant();
+}
+
+QVariant TreeModel::headerData(int section, Qt::Orientation orientation, int role) const noexcept
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+    {
+        return QVariant();
+    }
+
+    switch (section)
+    {
+    case LINT_TABLE_FILE_COLUMN:
+        return QStringLiteral("File");
+    case LINT_TABLE_NUMBER_COLUMN:
+        return QStringLiteral("Number");
+    case LINT_TABLE_DESCRIPTION_COLUMN:
+        return QStringLiteral("Description");
+    case LINT_TABLE_LINE_COLUMN:
+        return QStringLiteral("Line");
+    default:
+        return QVariant();
+    }
+}
+
+void TreeModel::addParent(const LintMessage& message) noexcept
+{
+    auto const file = fileId(message.file);
+
+    auto const messageIndex = static_cast<int>(m_messages.size());
+    m_messages.emplace_back(TreeMessage{file, message.line, message.number, messageType(message.type), message.description});
+
+    // Lint mostly reports a file top to bottom so this is nearly always an append
+    auto& fileMessages = m_fileMessages[file];
+    auto const position = std::upper_bound(fileMessages.begin(), fileMessages.end(), message.line, [this](int line, int other)
+    {
+        return line < m_messages[other].line;
+    });
+    fileMessages.insert(position, messageIndex);
+
+    auto const group = static_cast<int>(m_groups.size());
+    m_groups.emplace_back(TreeGroup{messageIndex, {}});
+    m_lastGroup = group;
+
+    // Update every aggregate table, only the active one notifies the view
+    for (int grouping = 0; grouping < GROUP_BY_COUNT; grouping++)
+    {
+        addToPivot(static_cast<Grouping>(grouping), group);
+    }
+}
+
+void TreeModel::addToPivot(Grouping grouping, int group) noexcept
+{
+    auto& pivot = m_pivots[grouping];
+    auto const active = (grouping == m_grouping);
+    auto const& message = m_messages[m_groups[group].message];
+    auto const key = pivotKey(grouping, message);
+
+    auto node = pivot.keyNode.value(key, -1);
+    if (node == -1)
+    {
+        // New node goes at the end
+        auto const row = static_cast<int>(pivot.nodeOrder.size());
+        if (active)
+        {
+            beginInsertRows(QModelIndex(), row, row);
+        }
+
+        node = static_cast<int>(pivot.nodes.size());
+        pivot.nodes.emplace_back(TreeNode{key, {}, 0, 0, 0});
+        pivot.keyNode.insert(key, node);
+        pivot.nodeOrder.emplace_back(node);
+        pivot.nodeRow.emplace_back(row);
+
+        if (active)
+        {
+            endInsertRows();
+        }
+    }
+
+    auto const row = static_cast<int>(pivot.nodes[node].groups.size());
+    if (active)
+    {
+        beginInsertRows(nodeIndex(node), row, row);
+    }
+
+    auto& treeNode = pivot.nodes[node];
+    treeNode.groups.emplace_back(group);
+    pivot.groupNode.emplace_back(node);
+    pivot.groupRow.emplace_back(row);
+
+    switch (message.type)
+    {
+    case MESSAGE_ERROR:
+        treeNode.errors++;
+        break;
+    case MESSAGE_WARNING:
+        treeNode.warnings++;
+        break;
+    case MESSAGE_INFORMATION:
+        treeNode.informations++;
+        break;
+    default:
+        break;
+    }
+
+    if (active)
+    {
+        endInsertRows();
+
+        // Live counts
+        auto const countIndex = nodeIndex(node).siblingAtColumn(LINT_TABLE_DESCRIPTION_COLUMN);
+        emit dataChanged(countIndex, countIndex, {Qt::DisplayRole});
+    }
+}
+
+void TreeModel::addChild(const LintMessage& message) noexcept
+{
+    // Supplemental messages always follow their top-level message
+    Q_ASSERT(m_lastGroup >= 0);
+
+    auto const file = fileId(message.file);
+    auto& group = m_groups[m_lastGroup];
+    auto const row = static_cast<int>(group.supplementals.size());
+
+    beginInsertRows(groupIndex(m_lastGroup), row, row);
+
+    auto const messageIndex = static_cast<int>(m_messages.size());
+    m_messages.emplace_back(TreeMessage{file, message.line, message.number, messageType(message.type), message.description});
+    group.supplementals.emplace_back(messageIndex);
+
+    endInsertRows();
+}
+
+LintMessages TreeModel::removeFiles(const std::vector<int>& files) noexcept
+{
+    std::vector<bool> removeFile(m_files.size(), false);
+    for (auto const file : files)
+    {
+        Q_ASSERT(file >= 0 && file < static_cast<int>(m_files.size()));
+        removeFile[file] = true;
+    }
+
+    auto const lintMessage = [this](int message)
+    {
+        auto const& treeMessage = m_messages[message];
+        return LintMessage{m_files[treeMessage.file], treeMessage.line, messageTypeName(treeMessage.type),
+                           treeMessage.number, treeMessage.description};
+    };
+
+    // A group goes with the file of its top-level message
+    LintMessages messages;
+    std::vector<bool> removed(m_groups.size(), false);
+    for (int group = 0; group < static_cast<int>(m_groups.size()); group++)
+    {
+        auto const& treeGroup = m_groups[group];
+        if (treeGroup.message < 0 || !removeFile[m_messages[treeGroup.message].file])
+        {
+            continue;
+        }
+
+        removed[group] = true;
+        messages.push_back(lintMessage(treeGroup.message));
+        for (auto const supplemental : treeGroup.supplementals)
+        {
+            messages.push_back(lintMessage(supplemental));
+        }
+    }
+
+    if (messages.empty())
+    {
+        return messages;
+    }
+
+    // Update every aggregate table, only the active one notifies the view
+    for (int grouping = 0; grouping < GROUP_BY_COUNT; grouping++)
+    {
+        removeFromPivot(static_cast<Grouping>(grouping), removed);
+    }
+
+    // The rows are gone so the messages can be packed
+    compactMessages(removed);
+
+    if (m_lastGroup >= 0 && removed[m_lastGroup])
+    {
+        m_lastGroup = -1;
+    }
+
+    // Any sort still running has the removed groups in it
+    m_sortGeneration++;
+
+    return messages;
+}
+
+void TreeModel::removeFromPivot(Grouping grouping, const std::vector<bool>& removed) noexcept
+{
+    auto& pivot = m_pivots[grouping];
+    auto const active = (grouping == m_grouping);
+
+    std::vector<int> nodes;
+    for (int group = 0; group < static_cast<int>(removed.size()); group++)
+    {
+        if (removed[group])
+        {
+            nodes.emplace_back(pivot.groupNode[group]);
+        }
+    }
+    std::sort(nodes.begin(), nodes.end());
+    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+    std::vector<int> emptied;
+    for (auto const node : nodes)
+    {
+        auto& treeNode = pivot.nodes[node];
+        auto& groups = treeNode.groups;
+
+        // A node that loses everything is removed as a whole below
+        if (std::all_of(groups.cbegin(), groups.cend(), [&removed](int group) { return removed[group]; }))
+        {
+            emptied.emplace_back(node);
+            continue;
+        }
+
+        // Remove runs of rows from the bottom up so the rows above keep their numbers
+        auto last = static_cast<int>(groups.size()) - 1;
+        while (last >= 0)
+        {
+            if (!removed[groups[last]])
+            {
+                last--;
+                continue;
+            }
+
+            auto first = last;
+            while (first > 0 && removed[groups[first - 1]])
+            {
+                first--;
+            }
+
+            if (active)
+            {
+                beginRemoveRows(nodeIndex(node), first, last);
+            }
+
+            for (auto row = first; row <= last; row++)
+            {
+                switch (m_messages[m_groups[groups[row]].message].type)
+                {
+                case MESSAGE_ERROR:
+                    treeNode.errors--;
+                    break;
+                case MESSAGE_WARNING:
+                    treeNode.warnings--;
+                    break;
+                case MESSAGE_INFORMATION:
+                    treeNode.informations--;
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            groups.erase(groups.begin() + first, groups.begin() + last + 1);
+            for (auto row = first; row < static_cast<int>(groups.size()); row++)
+            {
+                pivot.groupRow[groups[row]] = row;
+            }
+
+            if (active)
+            {
+                endRemoveRows();
+            }
+            last = first - 1;
+        }
+
+        if (active)
+        {
+            // Live counts
+            auto const countIndex = nodeIndex(node).siblingAtColumn(LINT_TABLE_DESCRIPTION_COLUMN);
+            emit dataChanged(countIndex, countIndex, {Qt::DisplayRole});
+        }
+    }
+
+    // Bottom row first so the rows above keep their numbers
+    std::sort(emptied.begin(), emptied.end(), [&pivot](int node1, int node2)
+    {
+        return pivot.nodeRow[node1] > pivot.nodeRow[node2];
+    });
+
+    for (auto const node : emptied)
+    {
+        auto const row = pivot.nodeRow[node];
+        if (active)
+        {
+            beginRemoveRows(QModelIndex(), row, row);
+        }
+
+        // The node id stays allocated so the internal ids of other nodes don't change
+        auto& treeNode = pivot.nodes[node];
+        pivot.keyNode.remove(treeNode.key);
+        treeNode = TreeNode{treeNode.key, {}, 0, 0, 0};
+        pivot.nodeOrder.erase(pivot.nodeOrder.begin() + row);
+        pivot.nodeRow[node] = -1;
+        for (auto next = row; next < static_cast<int>(pivot.nodeOrder.size()); next++)
+        {
+            pivot.nodeRow[pivot.nodeOrder[next]] = next;
+        }
+
+        if (active)
+        {
+            endRemoveRows();
+        }
+    }
+}
+
+void TreeModel::compactMessages(const std::vector<bool>& removed) noexcept
+{
+    // Old message -> new message, -1 if removed
+    std::vector<int> remap(m_messages.size(), 0);
+    for (int group = 0; group < static_cast<int>(removed.size()); group++)
+    {
+        if (!removed[group])
+        {
+            continue;
+        }
+
+        // The group id stays allocated so the internal ids of other groups don't change
+        auto& treeGroup = m_groups[group];
+        remap[treeGroup.message] = -1;
+        for (auto const supplemental : treeGroup.supplementals)
+        {
+            remap[supplemental] = -1;
+        }
+        treeGroup = TreeGroup{-1, {}};
+    }
+
+    // Keep lint order, supplementals still follow their top-level message
+    int next = 0;
+    for (int message = 0; message < static_cast<int>(m_messages.size()); message++)
+    {
+        if (remap[message] < 0)
+        {
+            continue;
+        }
+        remap[message] = next;
+        if (next != message)
+        {
+            m_messages[next] = std::move(m_messages[message]);
+        }
+        next++;
+    }
+    m_messages.erase(m_messages.begin() + next, m_messages.end());
+
+    for (auto& treeGroup : m_groups)
+    {
+        if (treeGroup.message < 0)
+        {
+            continue;
+        }
+        treeGroup.message = remap[treeGroup.message];
+        for (auto& supplemental : treeGroup.supplementals)
+        {
+            supplemental = remap[supplemental];
+        }
+    }
+
+    for (auto& fileMessages : m_fileMessages)
+    {
+        fileMessages.erase(std::remove_if(fileMessages.begin(), fileMessages.end(), [&remap](int message)
+        {
+            return remap[message] < 0;
+        }), fileMessages.end());
+
+        for (auto& message : fileMessages)
+        {
+            message = remap[message];
+        }
+    }
+}
+
+void TreeModel::clear() noexcept
+{
+    beginResetModel();
+
+    m_files.clear();
+    m_fileNames.clear();
+    m_fileDirectories.clear();
+    m_fileMessages.clear();
+    m_fileIds.clear();
+    m_directories.clear();
+    m_directoryIds.clear();
+    m_messages.clear();
+    m_groups.clear();
+    m_lastGroup = -1;
+
+    for (auto& pivot : m_pivots)
+    {
+        pivot = Pivot();
+        pivot.sortColumn = -1;
+        pivot.sortOrder = Qt::AscendingOrder;
+    }
+
+    // Any sort still running is now stale
+    m_sortGeneration++;
+
+    endResetModel();
+}
+
+void TreeModel::setGrouping(Grouping grouping) noexcept
+{
+    Q_ASSERT(grouping >= 0 && grouping < GROUP_BY_COUNT);
+    if (grouping == m_grouping)
+    {
+        return;
+    }
+
+    // The aggregate tables are already built so this is just a swap
+    beginResetModel();
+    m_grouping = grouping;
+    m_sortGeneration++;
+    endResetModel();
+
+    // Keep the order the user asked for
+    auto const& pivot = activePivot();
+    if (m_sortColumn >= 0 && (pivot.sortColumn != m_sortColumn || pivot.sortOrder != m_sortOrder))
+    {
+        sort(m_sortColumn, m_sortOrder);
+    }
+}
+
+Grouping TreeModel::grouping() const noexcept
+{
+    return m_grouping;
+}
+
+int TreeModel::messageCount() const noexcept
+{
+    return static_cast<int>(m_messages.size());
+}
+
+const TreeMessage& TreeModel::message(int message) const noexcept
+{
+    Q_ASSERT(message >= 0 && message < static_cast<int>(m_messages.size()));
+    return m_messages[message];
+}
+
+const QString& TreeModel::filePath(int file) const noexcept
+{
+    Q_ASSERT(file >= 0 && file < static_cast<int>(m_files.size()));
+    return m_files[file];
+}
+
+int TreeModel::fileCount() const noexcept
+{
+    return static_cast<int>(m_files.size());
+}
+
+int TreeModel::findFile(const QString& file) const noexcept
+{
+    return m_fileIds.value(file, -1);
+}
+
+TreeModel::LineMessages TreeModel::lineMessages(int file, int firstLine, int lastLine) const noexcept
+{
+    Q_ASSERT(file >= 0 && file < static_cast<int>(m_fileMessages.size()));
+    auto const& fileMessages = m_fileMessages[file];
+
+    auto const first = std::lower_bound(fileMessages.cbegin(), fileMessages.cend(), firstLine, [this](int message, int line)
+    {
+        return m_messages[message].line < line;
+    });
+    auto const last = std::upper_bound(first, fileMessages.cend(), lastLine, [this](int line, int message)
+    {
+        return line < m_messages[message].line;
+    });
+    return {first, last};
+}
+
+int TreeModel::fileId(const QString& file) noexcept
+{
+    auto const it = m_fileIds.constFind(file);
+    if (it != m_fileIds.cend())
+    {
+        return it.value();
+    }
+
+    auto const id = static_cast<int>(m_files.size());
+    m_files.emplace_back(file);
+    m_fileNames.emplace_back(QFileInfo(file).fileName());
+    m_fileDirectories.emplace_back(directoryId(file));
+    m_fileMessages.emplace_back();
+    m_fileIds.insert(file, id);
+    return id;
+}
+
+int TreeModel::directoryId(const QString& file) noexcept
+{
+    auto const directory = QDir::toNativeSeparators(QFileInfo(file).path());
+    auto const it = m_directoryIds.constFind(directory);
+    if (it != m_directoryIds.cend())
+    {
+        return it.value();
+    }
+
+    auto const id = static_cast<int>(m_directories.size());
+    m_directories.emplace_back(directory);
+    m_directoryIds.insert(directory, id);
+    return id;
+}
+
+int TreeModel::pivotKey(Grouping grouping, const TreeMessage& message) const noexcept
+{
+    switch (grouping)
+    {
+    case GROUP_BY_NUMBER:
+        return message.number;
+    case GROUP_BY_DIRECTORY:
+        return m_fileDirectories[message.file];
+    case GROUP_BY_TYPE:
+        return static_cast<int>(message.type);
+    case GROUP_BY_FILE:
+    default:
+        return message.file;
+    }
+}
+
+QString TreeModel::nodeName(Grouping grouping, const TreeNode& node) const noexcept
+{
+    switch (grouping)
+    {
+    case GROUP_BY_NUMBER:
+        return QString::number(node.key);
+    case GROUP_BY_DIRECTORY:
+        return m_directories[node.key];
+    case GROUP_BY_TYPE:
+        switch (static_cast<Message>(node.key))
+        {
+        case MESSAGE_ERROR:
+            return QStringLiteral("Error");
+        case MESSAGE_WARNING:
+            return QStringLiteral("Warning");
+        case MESSAGE_INFORMATION:
+            return QStringLiteral("Information");
+        case MESSAGE_SUPPLEMENTAL:
+            return QStringLiteral("Supplemental");
+        case MESSAGE_NOTE:
+            return QStringLiteral("Note");
+        default:
+            return QStringLiteral("Unknown");
+        }
+    case GROUP_BY_FILE:
+    default:
+        return m_fileNames[node.key];
+    }
+}
+
+TreeModel::Pivot& TreeModel::activePivot() noexcept
+{
+    return m_pivots[m_grouping];
+}
+
+const TreeModel::Pivot& TreeModel::activePivot() const noexcept
+{
+    return m_pivots[m_grouping];
+}
+
+int TreeModel::messageForIndex(const QModelIndex& index) const noexcept
+{
+    auto const id = index.internalId();
+    Q_ASSERT(id != ID_NODE);
+
+    if (!(id & ID_SUPPLEMENTAL))
+    {
+        auto const group = activePivot().nodes[decode(id)].groups[index.row()];
+        return m_groups[group].message;
+    }
+    return m_groups[decode(id)].supplementals[index.row()];
+}
+
+QModelIndex TreeModel::nodeIndex(int node) const noexcept
+{
+    return createIndex(activePivot().nodeRow[node], 0, ID_NODE);
+}
+
+QModelIndex TreeModel::groupIndex(int group) const noexcept
+{
+    auto const& pivot = activePivot();
+    return createIndex(pivot.groupRow[group], 0, encodeNode(pivot.groupNode[group]));
+}
+
+const QIcon& TreeModel::messageIcon(Message type) const noexcept
+{
+    switch (type)
+    {
+    case MESSAGE_ERROR:
+        return m_iconError;
+    case MESSAGE_WARNING:
+        return m_iconWarning;
+    default:
+        return m_iconInformation;
+    }
+}
+
+// Sorting orders the message groups within each top-level node by a typed key
+// Supplemental messages stay in lint order as they only make sense after their parent
+void TreeModel::sort(int column, Qt::SortOrder order)
+{
+    m_sortColumn = column;
+    m_sortOrder = order;
+
+    auto const& pivot = activePivot();
+    auto request = std::make_shared<SortRequest>();
+    request->generation = ++m_sortGeneration;
+    request->groupCount = static_cast<int>(m_groups.size());
+    request->nodeCount = static_cast<int>(pivot.nodes.size());
+    request->column = column;
+    request->order = order;
+    request->nodeOrder = pivot.nodeOrder;
+    request->textNodes = (m_grouping == GROUP_BY_FILE || m_grouping == GROUP_BY_DIRECTORY);
+    request->keys.reserve(m_groups.size());
+
+    for (int group = 0; group < request->groupCount; group++)
+    {
+        // Removed groups have no row
+        if (m_groups[group].message < 0)
+        {
+            continue;
+        }
+
+        auto const& message = m_messages[m_groups[group].message];
+        SortKey key{pivot.groupNode[group], group, 0, 0, QString()};
+        switch (column)
+        {
+        case LINT_TABLE_NUMBER_COLUMN:
+            key.primary = message.number;
+            key.secondary = message.line;
+            break;
+        case LINT_TABLE_DESCRIPTION_COLUMN:
+            key.text = message.description;
+            break;
+        case LINT_TABLE_FILE_COLUMN:
+            key.text = m_fileNames[message.file];
+            key.primary = message.line;
+            key.secondary = message.number;
+            break;
+        case LINT_TABLE_LINE_COLUMN:
+        default:
+            key.primary = message.line;
+            key.secondary = message.number;
+            break;
+        }
+        request->keys.emplace_back(std::move(key));
+    }
+
+    // Top-level nodes are only reordered when sorting by the first column
+    if (column == LINT_TABLE_FILE_COLUMN)
+    {
+        request->nodeKeys.reserve(pivot.nodes.size());
+        for (int node = 0; node < request->nodeCount; node++)
+        {
+            if (pivot.nodeRow[node] < 0)
+            {
+                continue;
+            }
+
+            auto const& treeNode = pivot.nodes[node];
+            request->nodeKeys.emplace_back(SortKey{node, -1, treeNode.key, 0,
+                                           request->textNodes ? nodeName(m_grouping, treeNode) : QString()});
+        }
+    }
+
+    // Large sorts run on a worker and the result is swapped in when ready
+    if (request->groupCount > SORT_BACKGROUND_THRESHOLD)
+    {
+        m_sortWatcher.setFuture(QtConcurrent::run([request]()
+        {
+            return sortGroups(*request);
+        }));
+    }
+    else
+    {
+        applySort(sortGroups(*request));
+    }
+}
+
+TreeModel::SortResult TreeModel::sortGroups(SortRequest& request) noexcept
+{
+    SortResult result;
+    result.generation = request.generation;
+    result.column = request.column;
+    result.order = request.order;
+    result.groupCount = request.groupCount;
+    result.nodeCount = request.nodeCount;
+
+    auto const ascending = (request.order == Qt::AscendingOrder);
+    auto const byText = [ascending](const SortKey& key1, const SortKey& key2)
+    {
+        auto compare = QString::compare(key1.text, key2.text, Qt::CaseInsensitive);
+        if (compare == 0)
+        {
+            compare = (key1.primary < key2.primary) ? -1 : (key1.primary > key2.primary);
+        }
+        return ascending ? (compare < 0) : (compare > 0);
+    };
+    auto const byValue = [ascending](const SortKey& key1, const SortKey& key2)
+    {
+        auto const first = std::tie(key1.primary, key1.secondary);
+        auto const second = std::tie(key2.primary, key2.secondary);
+        return ascending ? (first < second) : (second < first);
+    };
+
+    auto& keys = request.keys;
+    if (request.column == LINT_TABLE_DESCRIPTION_COLUMN || request.column == LINT_TABLE_FILE_COLUMN)
+    {
+        std::stable_sort(keys.begin(), keys.end(), byText);
+    }
+    else
+    {
+        std::stable_sort(keys.begin(), keys.end(), byValue);
+    }
+
+    // Distribute the sorted groups back to their nodes
+    result.groups.resize(request.nodeCount);
+    for (auto const& key : keys)
+    {
+        result.groups[key.node].emplace_back(key.group);
+    }
+
+    result.nodeOrder = std::move(request.nodeOrder);
+    if (request.column == LINT_TABLE_FILE_COLUMN)
+    {
+        auto& nodeKeys = request.nodeKeys;
+        if (request.textNodes)
+        {
+            std::stable_sort(nodeKeys.begin(), nodeKeys.end(), byText);
+        }
+        else
+        {
+            std::stable_sort(nodeKeys.begin(), nodeKeys.end(), byValue);
+        }
+
+        result.nodeOrder.clear();
+        for (auto const& key : nodeKeys)
+        {
+            result.nodeOrder.emplace_back(key.node);
+        }
+    }
+
+    return result;
+}
+
+void TreeModel::applySort(const SortResult& result) noexcept
+{
+    // Results were cleared, regrouped or another sort was requested since
+    if (result.generation != m_sortGeneration)
+    {
+        return;
+    }
+
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+    auto& pivot = activePivot();
+    pivot.sortColumn = result.column;
+    pivot.sortOrder = result.order;
+
+    // Remember which node or group every persistent index points at
+    auto const persistent = persistentIndexList();
+    std::vector<int> targets;
+    targets.reserve(persistent.size());
+    for (auto const& index : persistent)
+    {
+        auto const id = index.internalId();
+        if (id == ID_NODE)
+        {
+            targets.emplace_back(pivot.nodeOrder[index.row()]);
+        }
+        else if (!(id & ID_SUPPLEMENTAL))
+        {
+            targets.emplace_back(pivot.nodes[decode(id)].groups[index.row()]);
+        }
+        else
+        {
+            targets.emplace_back(-1);
+        }
+    }
+
+    // Swap in the new order
+    // Groups and nodes added while the sort was running stay at the end
+    for (int node = 0; node < static_cast<int>(pivot.nodes.size()); node++)
+    {
+        std::vector<int> groups;
+        if (node < static_cast<int>(result.groups.size()))
+        {
+            groups = result.groups[node];
+        }
+        for (auto const group : pivot.nodes[node].groups)
+        {
+            if (group >= result.groupCount)
+            {
+                groups.emplace_back(group);
+            }
+        }
+        pivot.nodes[node].groups.swap(groups);
+
+        auto const& ordered = pivot.nodes[node].groups;
+        for (int row = 0; row < static_cast<int>(ordered.size()); row++)
+        {
+            pivot.groupRow[ordered[row]] = row;
+        }
+    }
+
+    auto nodeOrder = result.nodeOrder;
+    for (auto node = result.nodeCount; node < static_cast<int>(pivot.nodes.size()); node++)
+    {
+        nodeOrder.emplace_back(node);
+    }
+    pivot.nodeOrder.swap(nodeOrder);
+    for (int row = 0; row < static_cast<int>(pivot.nodeOrder.size()); row++)
+    {
+        pivot.nodeRow[pivot.nodeOrder[row]] = row;
+    }
+
+    // Move the persistent indexes to their new rows
+    QModelIndexList updated;
+    updated.reserve(persistent.size());
+    for (int i = 0; i < persistent.size(); i++)
+    {
+        auto const& index = persistent[i];
+        auto const id = index.internalId();
+        if (id == ID_NODE)
+        {
+            updated.append(createIndex(pivot.nodeRow[targets[i]], index.column(), ID_NODE));
+        }
+        else if (!(id & ID_SUPPLEMENTAL))
+        {
+            updated.append(createIndex(pivot.groupRow[targets[i]], index.column(), id));
+        }
+        else
+        {
+            updated.append(index);
+        }
+    }
+    changePersistentIndexList(persistent, updated);
+
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+};
@@ -0,0 +1,218 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QAbstractItemModel>
+#include <QFutureWatcher>
+#include <QString>
+#include <QHash>
+#include <QIcon>
+#include <vector>
+#include <array>
+#include "PCLintPlus.h"
+
+namespace Lint
+{
+
+// Item data roles provided by the tree model
+// Full path of the file the row belongs to
+constexpr int LINT_ROLE_FILE_PATH = Qt::UserRole;
+// Message type of the row as a Lint::Message
+constexpr int LINT_ROLE_MESSAGE_TYPE = Qt::UserRole + 1;
+// Typed value of the column used for sorting
+constexpr int LINT_ROLE_SORT_KEY = Qt::UserRole + 2;
+
+// Sorts with more message groups than this are done on a background thread
+constexpr int SORT_BACKGROUND_THRESHOLD = 20000;
+
+// What the top level of the tree is grouped by
+enum Grouping
+{
+    GROUP_BY_FILE,
+    GROUP_BY_NUMBER,
+    GROUP_BY_DIRECTORY,
+    GROUP_BY_TYPE,
+    GROUP_BY_COUNT
+};
+
+// Lint message as stored by the tree model
+struct TreeMessage
+{
+    int file;            // Index into the file table
+    int line;            // Source code line number
+    int number;          // Message number
+    Message type;        // Message type
+    QString description; // Message description
+};
+
+// Three level tree of lint results
+// Group (file, number, directory or type) -> message (error/warning/info) -> supplemental messages
+// Messages are kept as typed values so sorting never touches strings for numeric columns
+// Every grouping is kept up to date as messages arrive so switching between them is instant
+class TreeModel : public QAbstractItemModel
+{
+    Q_OBJECT
+public:
+    TreeModel(QObject* parent = nullptr);
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const noexcept override;
+    QModelIndex parent(const QModelIndex& child) const noexcept override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const noexcept override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const noexcept override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const noexcept override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const noexcept override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    // Add a top-level message under its file node
+    void addParent(const LintMessage& message) noexcept;
+    // Add a supplemental message under the last added top-level message
+    void addChild(const LintMessage& message) noexcept;
+    // Remove the top-level messages of the files and their supplementals, returns what was removed
+    // Only the affected rows are removed so expansion and selection elsewhere are kept
+    LintMessages removeFiles(const std::vector<int>& files) noexcept;
+    // Remove all results
+    void clear() noexcept;
+    // Change what the top level of the tree is grouped by
+    void setGrouping(Grouping grouping) noexcept;
+    Grouping grouping() const noexcept;
+
+    // Read-only access to the stored results
+    int messageCount() const noexcept;
+    const TreeMessage& message(int message) const noexcept;
+    const QString& filePath(int file) const noexcept;
+    int fileCount() const noexcept;
+    // File table index of a full path, -1 if it has no messages
+    int findFile(const QString& file) const noexcept;
+
+    // Top-level messages of a file on lines [firstLine, lastLine] in line order
+    using LineMessages = std::pair<std::vector<int>::const_iterator, std::vector<int>::const_iterator>;
+    LineMessages lineMessages(int file, int firstLine, int lastLine) const noexcept;
+
+private:
+    // Top-level message and its supplementals
+    struct TreeGroup
+    {
+        int message;                    // Top-level message, -1 once removed
+        std::vector<int> supplementals; // Supplemental messages in lint order
+    };
+
+    // Top-level node holding all the groups with the same key
+    struct TreeNode
+    {
+        int key;                 // File, directory, message number or type
+        std::vector<int> groups; // Groups in display order
+        int errors;              // Aggregated message counts
+        int warnings;
+        int informations;
+    };
+
+    // Aggregate table for one grouping
+    struct Pivot
+    {
+        std::vector<TreeNode> nodes;
+        QHash<int, int> keyNode;      // Key -> node
+        std::vector<int> nodeOrder;   // Row -> node
+        std::vector<int> nodeRow;     // Node -> row, -1 once removed
+        std::vector<int> groupNode;   // Group -> node
+        std::vector<int> groupRow;    // Group -> row within its node
+        int sortColumn;               // Order last applied to this pivot
+        Qt::SortOrder sortOrder;
+    };
+
+    // Display order computed by a sort
+    struct SortResult
+    {
+        int generation;                       // Sort request this result belongs to
+        int column;
+        Qt::SortOrder order;
+        int groupCount;                       // Number of groups when the sort was requested
+        int nodeCount;                        // Number of nodes when the sort was requested
+        std::vector<int> nodeOrder;           // Row -> node
+        std::vector<std::vector<int>> groups; // Node -> groups in display order
+    };
+
+    // Key of a single group for sorting
+    struct SortKey
+    {
+        int node;
+        int group;
+        int primary;
+        int secondary;
+        QString text;
+    };
+
+    // Snapshot of everything a sort needs so it can run away from the GUI thread
+    struct SortRequest
+    {
+        int generation;
+        int groupCount;
+        int nodeCount;
+        int column;
+        Qt::SortOrder order;
+        std::vector<SortKey> keys;
+        std::vector<int> nodeOrder;
+        std::vector<SortKey> nodeKeys;
+        bool textNodes;
+    };
+
+    int fileId(const QString& file) noexcept;
+    int directoryId(const QString& file) noexcept;
+    int pivotKey(Grouping grouping, const TreeMessage& message) const noexcept;
+    QString nodeName(Grouping grouping, const TreeNode& node) const noexcept;
+    void addToPivot(Grouping grouping, int group) noexcept;
+    void removeFromPivot(Grouping grouping, const std::vector<bool>& removed) noexcept;
+    void compactMessages(const std::vector<bool>& removed) noexcept;
+    Pivot& activePivot() noexcept;
+    const Pivot& activePivot() const noexcept;
+    int messageForIndex(const QModelIndex& index) const noexcept;
+    QModelIndex nodeIndex(int node) const noexcept;
+    QModelIndex groupIndex(int group) const noexcept;
+    const QIcon& messageIcon(Message type) const noexcept;
+
+    static SortResult sortGroups(SortRequest& request) noexcept;
+    void applySort(const SortResult& result) noexcept;
+
+    // File table (full path, file name and directory)
+    std::vector<QString> m_files;
+    std::vector<QString> m_fileNames;
+    std::vector<int> m_fileDirectories;
+    // File -> top-level messages sorted by line
+    std::vector<std::vector<int>> m_fileMessages;
+    QHash<QString, int> m_fileIds;
+
+    // Directory table
+    std::vector<QString> m_directories;
+    QHash<QString, int> m_directoryIds;
+
+    std::vector<TreeMessage> m_messages;
+    std::vector<TreeGroup> m_groups;
+    int m_lastGroup;
+
+    std::array<Pivot, GROUP_BY_COUNT> m_pivots;
+    Grouping m_grouping;
+
+    int m_sortColumn;
+    Qt::SortOrder m_sortOrder;
+    int m_sortGeneration;
+    QFutureWatcher<SortResult> m_sortWatcher;
+
+    QIcon m_iconError;
+    QIcon m_iconWarning;
+    QIcon m_iconInformation;
+};
+
+};
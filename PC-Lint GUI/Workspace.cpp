@@ -0,0 +1,340 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Workspace.h"
+#include "Snapshot.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QThread>
+#include <QDebug>
+#include <algorithm>
+
+namespace Lint
+{
+
+namespace
+{
+    const QString WORKSPACE_PROJECTS = "projects";
+    const QString WORKSPACE_NAME = "name";
+    const QString WORKSPACE_LINT_EXECUTABLE = "lintExecutable";
+    const QString WORKSPACE_LINT_FILE = "lintFile";
+};
+
+bool readWorkspace(const QString& file, WorkspaceProjects& projects, QString& error) noexcept
+{
+    QFile input(file);
+    if (!input.open(QIODevice::ReadOnly))
+    {
+        error = input.errorString();
+        return false;
+    }
+
+    QJsonParseError parseError;
+    auto const document = QJsonDocument::fromJson(input.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError)
+    {
+        error = parseError.errorString();
+        return false;
+    }
+
+    auto const directory = QFileInfo(file).absoluteDir();
+    projects.clear();
+    for (auto const value : document.object().value(WORKSPACE_PROJECTS).toArray())
+    {
+        auto const object = value.toObject();
+        WorkspaceProject project{object.value(WORKSPACE_NAME).toString(),
+                                 object.value(WORKSPACE_LINT_EXECUTABLE).toString(),
+                                 object.value(WORKSPACE_LINT_FILE).toString()};
+        if (project.lintFile.isEmpty())
+        {
+            error = "Project without a lint file: " + project.name;
+            return false;
+        }
+
+        project.lintFile = QDir::cleanPath(directory.absoluteFilePath(project.lintFile));
+        if (project.name.isEmpty())
+        {
+            project.name = QFileInfo(project.lintFile).completeBaseName();
+        }
+        projects.push_back(project);
+    }
+
+    if (projects.empty())
+    {
+        error = "The workspace has no projects";
+        return false;
+    }
+    return true;
+}
+
+bool writeWorkspace(const QString& file, const WorkspaceProjects& projects, QString& error) noexcept
+{
+    // Lint files next to the workspace are stored relative so the workspace can be checked in
+    auto const directory = QFileInfo(file).absoluteDir();
+    QJsonArray array;
+    for (auto const& project : projects)
+    {
+        QJsonObject object;
+        object.insert(WORKSPACE_NAME, project.name);
+        if (!project.lintExecutable.isEmpty())
+        {
+            object.insert(WORKSPACE_LINT_EXECUTABLE, project.lintExecutable);
+        }
+        auto const relative = directory.relativeFilePath(project.lintFile);
+        object.insert(WORKSPACE_LINT_FILE, relative.startsWith("..") ? project.lintFile : relative);
+        array.append(object);
+    }
+
+    QSaveFile output(file);
+    if (!output.open(QIODevice::WriteOnly) ||
+        (output.write(QJsonDocument(QJsonObject{{WORKSPACE_PROJECTS, array}}).toJson()) < 0) ||
+        !output.commit())
+    {
+        error = output.errorString();
+        return false;
+    }
+    return true;
+}
+
+int workspaceThreadShare(int freeThreads, int pendingProjects) noexcept
+{
+    Q_ASSERT(pendingProjects > 0);
+    return std::max(1, freeThreads / pendingProjects);
+}
+
+int adaptConcurrency(int processes, int maximum, const SystemLoad& load) noexcept
+{
+    if ((load.swappedPages > 0) || (load.memoryAvailable < ADAPTIVE_MEMORY_LOW))
+    {
+        return std::max(1, processes - 1);
+    }
+
+    if ((load.cpuBusy < ADAPTIVE_CPU_BUSY) && (load.ioWait < ADAPTIVE_IO_WAIT) && (load.memoryAvailable > ADAPTIVE_MEMORY_SPARE))
+    {
+        return std::min(std::max(1, maximum), processes + 1);
+    }
+    return processes;
+}
+
+int adaptiveLintThreads(int hardwareThreads, const SystemLoad& load) noexcept
+{
+    auto const idle = static_cast<int>(hardwareThreads * (1.0 - load.cpuBusy - load.ioWait) + 0.5);
+    return std::clamp(idle, 1, std::max(1, hardwareThreads));
+}
+
+LintScheduler::LintScheduler(std::shared_ptr<StringPool> strings, QObject* parent) :
+    QObject(parent),
+    m_strings(strings),
+    m_nextProject(0),
+    m_freeThreads(0),
+    m_running(0),
+    m_completed(0),
+    m_adaptive(false),
+    m_processes(1),
+    m_load{0.0, 0.0, 1.0, 0}
+{
+    m_adaptTimer.setInterval(ADAPTIVE_INTERVAL_MS);
+    QObject::connect(&m_adaptTimer, &QTimer::timeout, this, &LintScheduler::adapt);
+}
+
+LintScheduler::~LintScheduler()
+{
+    abort();
+}
+
+void LintScheduler::start(const WorkspaceProjects& projects, const QString& lintExecutable, int threads,
+                          std::shared_ptr<const Baseline> baseline) noexcept
+{
+    // Aborting waits for the lint to stop so the old runs can go
+    abort();
+
+    // The previous results are replaced, only strings of this run are worth sharing
+    m_runs.clear();
+    m_strings->clear();
+    for (auto const& project : projects)
+    {
+        m_runs.push_back(ProjectRun{project, nullptr, {}, Status::STATUS_UNKNOWN, QString(), 0});
+    }
+    m_baseline = baseline;
+    m_lintExecutable = lintExecutable;
+    m_nextProject = 0;
+    m_freeThreads = std::max(1, threads);
+    m_running = 0;
+    m_completed = 0;
+
+    if (m_adaptive)
+    {
+        // One process to start with, more are added while the machine has room for them
+        m_processes = 1;
+        m_load = m_loadMonitor.sample();
+        m_adaptTimer.start();
+        qInfo() << "Linting" << m_runs.size() << "projects adapting to the system load";
+    }
+    else
+    {
+        qInfo() << "Linting" << m_runs.size() << "projects with" << m_freeThreads << "threads";
+    }
+    startPending();
+}
+
+void LintScheduler::setAdaptive(bool adaptive) noexcept
+{
+    m_adaptive = adaptive;
+}
+
+void LintScheduler::abort() noexcept
+{
+    for (auto& run : m_runs)
+    {
+        if (run.lint)
+        {
+            QObject::disconnect(run.lint.get(), nullptr, this, nullptr);
+            run.lint->slotAbortLint(true);
+        }
+    }
+    m_nextProject = static_cast<int>(m_runs.size());
+    m_running = 0;
+    m_adaptTimer.stop();
+}
+
+bool LintScheduler::isRunning() const noexcept
+{
+    return (m_running > 0) || (m_nextProject < static_cast<int>(m_runs.size()));
+}
+
+int LintScheduler::projectCount() const noexcept
+{
+    return static_cast<int>(m_runs.size());
+}
+
+const WorkspaceProject& LintScheduler::project(int project) const noexcept
+{
+    return m_runs[static_cast<size_t>(project)].project;
+}
+
+const LintMessages& LintScheduler::messages(int project) const noexcept
+{
+    return m_runs[static_cast<size_t>(project)].messages;
+}
+
+Status LintScheduler::status(int project) const noexcept
+{
+    return m_runs[static_cast<size_t>(project)].status;
+}
+
+QString LintScheduler::errorMessage(int project) const noexcept
+{
+    return m_runs[static_cast<size_t>(project)].errorMessage;
+}
+
+int LintScheduler::completedProjects() const noexcept
+{
+    return m_completed;
+}
+
+void LintScheduler::startPending() noexcept
+{
+    // A project always starts when nothing is running so a budget of one still gets through them all
+    // Adaptive mode starts projects up to the allowed processes, each with the CPUs that were idle
+    while ((m_nextProject < static_cast<int>(m_runs.size())) &&
+           (m_adaptive ? (m_running < m_processes) : ((m_freeThreads > 0) || (m_running == 0))))
+    {
+        auto const project = m_nextProject++;
+        auto& run = m_runs[static_cast<size_t>(project)];
+        if (m_adaptive)
+        {
+            run.threads = adaptiveLintThreads(QThread::idealThreadCount(), m_load);
+            // Until the next check the new process counts as keeping its threads busy
+            m_load.cpuBusy = std::min(1.0, m_load.cpuBusy + static_cast<double>(run.threads) / std::max(1, QThread::idealThreadCount()));
+        }
+        else
+        {
+            run.threads = workspaceThreadShare(m_freeThreads, static_cast<int>(m_runs.size()) - project);
+            m_freeThreads -= run.threads;
+        }
+        m_running++;
+
+        auto const lintExecutable = run.project.lintExecutable.isEmpty() ? m_lintExecutable : run.project.lintExecutable;
+        run.lint = std::make_unique<PCLintPlus>(lintExecutable, run.project.lintFile);
+        run.lint->setHardwareThreads(run.threads);
+        run.lint->setBaseline(m_baseline);
+
+        // Messages are pooled as they arrive so only one copy of each string is ever kept
+        auto const addMessage = [this, project](const LintMessage& message)
+        {
+            auto& messages = m_runs[static_cast<size_t>(project)].messages;
+            messages.push_back(message);
+            m_strings->intern(messages.back());
+        };
+        QObject::connect(run.lint.get(), &PCLintPlus::signalAddTreeParent, this, addMessage);
+        QObject::connect(run.lint.get(), &PCLintPlus::signalAddTreeChild, this, addMessage);
+
+        // Queued so it runs after the queued messages from the consumer thread
+        QObject::connect(run.lint.get(), &PCLintPlus::signalLintComplete, this, [this, project](const Status& status, const QString& errorMessage)
+        {
+            projectComplete(project, status, errorMessage);
+        }, Qt::QueuedConnection);
+
+        qInfo() << "Linting project" << run.project.name << "with" << run.threads << "threads";
+        emit signalProjectStarted(project, run.threads);
+        run.lint->lint();
+    }
+}
+
+void LintScheduler::projectComplete(int project, Status status, const QString& errorMessage) noexcept
+{
+    auto& run = m_runs[static_cast<size_t>(project)];
+    run.status = status;
+    run.errorMessage = errorMessage;
+    run.messages.shrink_to_fit();
+    m_freeThreads += run.threads;
+    m_running--;
+    m_completed++;
+
+    qInfo() << "Project" << run.project.name << "finished with" << status << "and" << run.messages.size() << "messages";
+    emit signalProjectComplete(project);
+
+    if (!isRunning())
+    {
+        m_adaptTimer.stop();
+        qInfo() << "Workspace finished," << m_strings->size() << "pooled strings in" << m_strings->bytes() << "bytes";
+        emit signalWorkspaceComplete();
+        return;
+    }
+    startPending();
+}
+
+void LintScheduler::adapt() noexcept
+{
+    m_load = m_loadMonitor.sample();
+    auto const maximum = std::min(QThread::idealThreadCount(), static_cast<int>(m_runs.size()));
+    auto const processes = adaptConcurrency(m_processes, maximum, m_load);
+    if (processes != m_processes)
+    {
+        qInfo() << "Adaptive lint processes" << m_processes << "->" << processes << "CPU" << m_load.cpuBusy
+                << "I/O wait" << m_load.ioWait << "memory available" << m_load.memoryAvailable << "swapped pages" << m_load.swappedPages;
+        m_processes = processes;
+        emit signalConcurrencyChanged(m_processes);
+    }
+    startPending();
+}
+
+};
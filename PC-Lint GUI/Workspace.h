@@ -0,0 +1,130 @@
+// PC-Lint GUI
+// Copyright (C) 2021  Ayymooose
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <memory>
+#include <vector>
+#include "PCLintPlus.h"
+#include "StringPool.h"
+#include "SystemInfo.h"
+
+namespace Lint
+{
+
+class Baseline;
+
+// One lint configuration of a workspace
+struct WorkspaceProject
+{
+    QString name;
+    QString lintExecutable; // Empty to use the one from Preferences
+    QString lintFile;
+};
+
+using WorkspaceProjects = std::vector<WorkspaceProject>;
+
+// Workspace file (JSON), relative lint files are taken from the directory of the workspace
+bool readWorkspace(const QString& file, WorkspaceProjects& projects, QString& error) noexcept;
+bool writeWorkspace(const QString& file, const WorkspaceProjects& projects, QString& error) noexcept;
+
+// Threads a project about to start gets when freeThreads are left for pending projects
+// Every project gets at least one so nothing waits forever on a small budget
+int workspaceThreadShare(int freeThreads, int pendingProjects) noexcept;
+
+// Adaptive mode checks the load this often
+constexpr int ADAPTIVE_INTERVAL_MS = 2000;
+// More lint processes are started while the CPU is less busy than this
+constexpr double ADAPTIVE_CPU_BUSY = 0.80;
+// Time spent waiting on the disk above which more processes only wait too
+constexpr double ADAPTIVE_IO_WAIT = 0.25;
+// Below this much available memory one process fewer runs, below the second no more start
+constexpr double ADAPTIVE_MEMORY_LOW = 0.10;
+constexpr double ADAPTIVE_MEMORY_SPARE = 0.25;
+
+// Lint processes to run at once after seeing load, one step at a time between 1 and maximum
+// Swapping or low memory backs off, idle CPUs with memory to spare add one, otherwise it holds
+int adaptConcurrency(int processes, int maximum, const SystemLoad& load) noexcept;
+// -max_threads for a lint started now, the CPUs that were idle and at least one
+int adaptiveLintThreads(int hardwareThreads, const SystemLoad& load) noexcept;
+
+// Lints the projects of a workspace side by side within one thread budget
+// Projects start while there are threads left and the threads of a finished project go to the next one
+// The results of each project are kept apart but their strings come from one shared pool
+class LintScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    LintScheduler(std::shared_ptr<StringPool> strings, QObject* parent = nullptr);
+    ~LintScheduler();
+
+    // Lint every project using at most threads lint threads between them
+    void start(const WorkspaceProjects& projects, const QString& lintExecutable, int threads,
+               std::shared_ptr<const Baseline> baseline) noexcept;
+    // Ignore the thread budget and follow the system load instead
+    void setAdaptive(bool adaptive) noexcept;
+    void abort() noexcept;
+    bool isRunning() const noexcept;
+
+    int projectCount() const noexcept;
+    const WorkspaceProject& project(int project) const noexcept;
+    const LintMessages& messages(int project) const noexcept;
+    Status status(int project) const noexcept;
+    QString errorMessage(int project) const noexcept;
+    int completedProjects() const noexcept;
+
+signals:
+    void signalProjectStarted(int project, int threads);
+    void signalProjectComplete(int project);
+    void signalWorkspaceComplete();
+    void signalConcurrencyChanged(int processes);
+
+private:
+    struct ProjectRun
+    {
+        WorkspaceProject project;
+        std::unique_ptr<PCLintPlus> lint;
+        LintMessages messages;
+        Status status;
+        QString errorMessage;
+        int threads;
+    };
+
+    void startPending() noexcept;
+    void projectComplete(int project, Status status, const QString& errorMessage) noexcept;
+    void adapt() noexcept;
+
+    std::shared_ptr<StringPool> m_strings;
+    std::shared_ptr<const Baseline> m_baseline;
+    std::vector<ProjectRun> m_runs;
+    QString m_lintExecutable;
+    int m_nextProject;
+    int m_freeThreads;
+    int m_running;
+    int m_completed;
+
+    // Adaptive mode
+    bool m_adaptive;
+    int m_processes;      // Lint processes allowed at once
+    SystemLoad m_load;    // Load seen by the last check
+    LoadMonitor m_loadMonitor;
+    QTimer m_adaptTimer;
+};
+
+};